@@ -0,0 +1,106 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add priority queue benchmark
+* 2026-10-19     zhangran     add queue journal benchmark
+* 2026-10-19     zhangran     add log benchmark
+* 2026-10-19     zhangran     add bus benchmark
+* 2026-10-19     zhangran     add typed queue benchmark
+* 2026-10-19     zhangran     add mailbox benchmark
+* 2026-10-19     zhangran     add buffer pool benchmark
+* 2026-10-19     zhangran     add pipeline benchmark
+*/
+#ifndef __BENCH_H_
+#define __BENCH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "toolkit.h"
+
+/* ÿӳĲֵΪƽֵ̯ʱ */
+#define BENCH_BATCH 8
+
+struct bench_opts
+{
+    uint32_t iterations;    /* ӳٲԵ */
+    uint32_t warmup;        /* Ԥ */
+    uint16_t threads;       /* ̲߳Ե߳ */
+    bool quick;             /* ģʽв */
+    const char *filter;     /* ֻưַĲ */
+    const char *journal_dir; /* ־ûвʹõĿ¼ */
+    uint32_t journal_mb;    /* ־ûвԵĻѹ(λMB) */
+};
+extern struct bench_opts bench_opts;
+
+/* еĶʱʱbench_tick_realΪfalseʱbench_tick_value */
+extern uint32_t bench_tick_value;
+extern bool bench_tick_real;
+uint32_t bench_get_tick(void);
+
+/* ʱ */
+uint64_t bench_now_ns(void);
+uint64_t bench_thread_cpu_ns(void);
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint64_t bench_cycles(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+#else
+static inline uint64_t bench_cycles(void)
+{
+    return bench_now_ns();
+}
+#endif
+double bench_cycles_to_ns(uint64_t cycles);
+
+/* ¼ */
+bool bench_enabled(const char *name);
+bool bench_latency(const char *name, void (*op)(void *ctx), void *ctx);
+bool bench_throughput(const char *name, void (*op)(void *ctx, uint32_t count), void *ctx, uint32_t count);
+bool bench_report_samples(const char *name, double *samples, uint32_t num, uint64_t ops, uint64_t total_ns);
+bool bench_report_value(const char *name, const char *unit, double value);
+
+/* /proc/self/ioеϵͳü֧ʱfalse */
+bool bench_syscalls(uint64_t *count);
+
+/* ģ */
+void bench_queue(void);
+void bench_queue_typed(void);
+void bench_pqueue(void);
+void bench_journal(void);
+void bench_log(void);
+void bench_timer(void);
+void bench_event(void);
+void bench_bus(void);
+void bench_mailbox(void);
+void bench_bufpool(void);
+void bench_loop(void);
+void bench_runtime(void);
+void bench_pipeline(void);
+void bench_coroutine(void);
+void bench_memory(void);
+
+#endif /* __BENCH_H_ */
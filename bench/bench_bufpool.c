@@ -0,0 +1,159 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "bench.h"
+
+#define BENCH_BUFPOOL_MAX_FANOUT 8
+#define BENCH_BUFPOOL_DEPTH 16
+
+struct bench_bufpool_ctx
+{
+    uint32_t size;
+    uint16_t fanout;
+    struct tk_bufpool *pool;
+    struct tk_queue *queues[BENCH_BUFPOOL_MAX_FANOUT];
+    uint8_t *produce;
+    uint8_t *consume;
+    uint32_t sum;
+};
+
+/* ڱػдݺѹNУÿߵԼĻ */
+static void _bench_bufpool_copy(struct bench_bufpool_ctx *c)
+{
+    for (uint32_t i = 0; i < BENCH_BUFPOOL_DEPTH; i++)
+    {
+        c->produce[0] = (uint8_t)i;
+        c->produce[c->size - 1] = (uint8_t)i;
+        for (uint16_t q = 0; q < c->fanout; q++)
+            tk_queue_push(c->queues[q], c->produce);
+    }
+    for (uint16_t q = 0; q < c->fanout; q++)
+    {
+        while (tk_queue_pop(c->queues[q], c->consume))
+            c->sum += c->consume[0] + c->consume[c->size - 1];
+    }
+}
+
+/* ֱд뻺ָֻ룬һͷŻ */
+static void _bench_bufpool_handle(struct bench_bufpool_ctx *c)
+{
+    struct tk_buf *buf;
+    for (uint32_t i = 0; i < BENCH_BUFPOOL_DEPTH; i++)
+    {
+        buf = tk_bufpool_alloc(c->pool);
+        if (buf == NULL)
+            return;
+        ((uint8_t *)buf->data)[0] = (uint8_t)i;
+        ((uint8_t *)buf->data)[c->size - 1] = (uint8_t)i;
+        buf->len = c->size;
+        tk_bufpool_retain(buf, c->fanout - 1);
+        for (uint16_t q = 0; q < c->fanout; q++)
+            tk_queue_push(c->queues[q], &buf);
+    }
+    for (uint16_t q = 0; q < c->fanout; q++)
+    {
+        while (tk_queue_pop(c->queues[q], &buf))
+        {
+            c->sum += ((uint8_t *)buf->data)[0] + ((uint8_t *)buf->data)[buf->len - 1];
+            tk_bufpool_release(buf);
+        }
+    }
+}
+
+/**
+ * @brief 1fanoutͶsizeֽڵݣͶݴ(ÿյֽ֮)ڴռ
+ * 
+ * @param size ݴС(λֽ)
+ * @param fanout ߸
+ * @param handle trueشݾ falseݿ
+ */
+static void _bench_bufpool_deliver(uint32_t size, uint16_t fanout, bool handle)
+{
+    static struct bench_bufpool_ctx ctx;
+    char name[64], prefix[48];
+    uint64_t begin, ns, deadline, rounds = 0;
+    double footprint;
+    snprintf(prefix, sizeof(prefix), "bufpool.%s.%uKB.n%u", handle ? "handle" : "copy",
+             (unsigned)(size / 1024), (unsigned)fanout);
+    if (bench_enabled(prefix) == false)
+        return;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.size = size;
+    ctx.fanout = fanout;
+    ctx.produce = (uint8_t *)malloc(size);
+    ctx.consume = (uint8_t *)malloc(size);
+    if (handle)
+    {
+        ctx.pool = tk_bufpool_create(size, BENCH_BUFPOOL_DEPTH);
+        footprint = sizeof(struct tk_bufpool) + (double)TK_BUFPOOL_POOL_SIZE((uint64_t)size, BENCH_BUFPOOL_DEPTH) +
+                    (double)fanout * (sizeof(struct tk_queue) + BENCH_BUFPOOL_DEPTH * sizeof(struct tk_buf *));
+    }
+    else
+    {
+        footprint = (double)fanout * (sizeof(struct tk_queue) + (double)BENCH_BUFPOOL_DEPTH * size);
+    }
+    for (uint16_t q = 0; q < fanout; q++)
+        ctx.queues[q] = tk_queue_create(handle ? sizeof(struct tk_buf *) : size, BENCH_BUFPOOL_DEPTH, false);
+    if (ctx.produce != NULL && ctx.consume != NULL && (handle == false || ctx.pool != NULL))
+    {
+        memset(ctx.produce, 0x5a, size);
+        begin = bench_now_ns();
+        deadline = begin + (bench_opts.quick ? 20000000ULL : 200000000ULL);
+        do
+        {
+            if (handle)
+                _bench_bufpool_handle(&ctx);
+            else
+                _bench_bufpool_copy(&ctx);
+            rounds++;
+        } while (bench_now_ns() < deadline);
+        ns = bench_now_ns() - begin;
+        bench_report_value(prefix, "MB/s", (double)rounds * BENCH_BUFPOOL_DEPTH * fanout * size * 1e9 / (double)ns / 1048576.0);
+        snprintf(name, sizeof(name), "%s.memory", prefix);
+        bench_report_value(name, "bytes", footprint);
+    }
+    for (uint16_t q = 0; q < fanout; q++)
+        tk_queue_delete(ctx.queues[q]);
+    tk_bufpool_delete(ctx.pool);
+    free(ctx.produce);
+    free(ctx.consume);
+}
+
+void bench_bufpool(void)
+{
+    /* tk_queueԪشСΪuint16_tʽֻܴ63KB */
+    static const uint32_t sizes[] = {8 * 1024, 63 * 1024};
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        for (uint16_t fanout = 1; fanout <= BENCH_BUFPOOL_MAX_FANOUT; fanout *= 2)
+        {
+            _bench_bufpool_deliver(sizes[s], fanout, false);
+            _bench_bufpool_deliver(sizes[s], fanout, true);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "bench.h"
+
+#define BENCH_BUS_MSG_SIZE 64
+#define BENCH_BUS_DEPTH 256
+#define BENCH_BUS_BURST 16
+
+struct bench_bus_msg
+{
+    uint8_t data[BENCH_BUS_MSG_SIZE];
+};
+
+struct bench_bus_ctx
+{
+    uint8_t sub_num;
+    struct tk_bus *bus;
+    struct tk_bus_sub subs[TK_BUS_MAX_SUBSCRIBERS];
+    struct tk_queue *queues[TK_BUS_MAX_SUBSCRIBERS];
+    struct tk_event *events[TK_BUS_MAX_SUBSCRIBERS];
+    struct bench_bus_msg msg;
+    uint32_t recved;
+};
+
+/* ߣburstϢÿյ¼Ϣ */
+static void _bench_bus_fanout(struct bench_bus_ctx *c, uint32_t burst)
+{
+    for (uint32_t i = 0; i < burst; i++)
+    {
+        c->msg.data[0] = (uint8_t)i;
+        tk_bus_publish(c->bus, &c->msg);
+    }
+    for (uint8_t s = 0; s < c->sub_num; s++)
+    {
+        if (tk_event_recv(c->events[s], 1, TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR, &c->recved) == false)
+            continue;
+        while (tk_bus_read(&c->subs[s], &c->msg))
+            ;
+    }
+}
+
+/* ÿһtk_queueÿϢѹNвN¼ */
+static void _bench_bus_queues(struct bench_bus_ctx *c, uint32_t burst)
+{
+    for (uint32_t i = 0; i < burst; i++)
+    {
+        c->msg.data[0] = (uint8_t)i;
+        for (uint8_t s = 0; s < c->sub_num; s++)
+        {
+            tk_queue_push(c->queues[s], &c->msg);
+            tk_event_send(c->events[s], 1);
+        }
+    }
+    for (uint8_t s = 0; s < c->sub_num; s++)
+    {
+        if (tk_event_recv(c->events[s], 1, TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR, &c->recved) == false)
+            continue;
+        while (tk_queue_pop(c->queues[s], &c->msg))
+            ;
+    }
+}
+
+static void _bench_bus_fanout_one(void *ctx)
+{
+    _bench_bus_fanout((struct bench_bus_ctx *)ctx, 1);
+}
+
+static void _bench_bus_fanout_burst(void *ctx)
+{
+    _bench_bus_fanout((struct bench_bus_ctx *)ctx, BENCH_BUS_BURST);
+}
+
+static void _bench_bus_queues_one(void *ctx)
+{
+    _bench_bus_queues((struct bench_bus_ctx *)ctx, 1);
+}
+
+static void _bench_bus_queues_burst(void *ctx)
+{
+    _bench_bus_queues((struct bench_bus_ctx *)ctx, BENCH_BUS_BURST);
+}
+
+void bench_bus(void)
+{
+    static struct bench_bus_ctx ctx;
+    char name[64];
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.bus = tk_bus_create(sizeof(struct bench_bus_msg), BENCH_BUS_DEPTH, false);
+    for (uint8_t s = 0; s < TK_BUS_MAX_SUBSCRIBERS; s++)
+    {
+        ctx.queues[s] = tk_queue_create(sizeof(struct bench_bus_msg), BENCH_BUS_DEPTH, false);
+        ctx.events[s] = tk_event_create();
+    }
+
+    /* ߸1~TK_BUS_MAX_SUBSCRIBERSΪÿη(ÿburst)ж߶ʱ */
+    for (uint32_t n = 1; n <= TK_BUS_MAX_SUBSCRIBERS; n *= 2)
+    {
+        for (; ctx.sub_num < n; ctx.sub_num++)
+            tk_bus_subscribe(ctx.bus, &ctx.subs[ctx.sub_num], ctx.events[ctx.sub_num], 1);
+
+        snprintf(name, sizeof(name), "bus.fanout.s%u", (unsigned)n);
+        bench_latency(name, _bench_bus_fanout_one, &ctx);
+        snprintf(name, sizeof(name), "bus.queues.fanout.s%u", (unsigned)n);
+        bench_latency(name, _bench_bus_queues_one, &ctx);
+        snprintf(name, sizeof(name), "bus.fanout.burst%u.s%u", BENCH_BUS_BURST, (unsigned)n);
+        bench_latency(name, _bench_bus_fanout_burst, &ctx);
+        snprintf(name, sizeof(name), "bus.queues.fanout.burst%u.s%u", BENCH_BUS_BURST, (unsigned)n);
+        bench_latency(name, _bench_bus_queues_burst, &ctx);
+    }
+
+    tk_bus_delete(ctx.bus);
+    for (uint8_t s = 0; s < TK_BUS_MAX_SUBSCRIBERS; s++)
+    {
+        tk_queue_delete(ctx.queues[s]);
+        tk_event_delete(ctx.events[s]);
+    }
+}
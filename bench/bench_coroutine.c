@@ -0,0 +1,154 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add sleeping coroutine scaling
+*/
+
+#include "bench.h"
+
+struct bench_co_ctx
+{
+    struct tk_co *cos;
+    uint32_t num;
+    struct tk_queue *queue;
+};
+
+static TK_CO_FUNC(_bench_co_yield)
+{
+    TK_CO_BEGIN();
+    while (1)
+        TK_CO_YIELD();
+    TK_CO_END();
+}
+
+static TK_CO_FUNC(_bench_co_consumer)
+{
+    static uint32_t value;
+    TK_CO_BEGIN();
+    while (1)
+        TK_AWAIT_QUEUE((struct tk_queue *)co->user_data, &value);
+    TK_CO_END();
+}
+
+static uint32_t bench_co_seed = 1;
+
+static TK_CO_FUNC(_bench_co_sleeper)
+{
+    TK_CO_BEGIN();
+    while (1)
+    {
+        bench_co_seed = bench_co_seed * 1103515245u + 12345u;
+        TK_AWAIT_TIMER((bench_co_seed >> 16) % 1000 + 1);
+    }
+    TK_CO_END();
+}
+
+/* ƽtickѵڵ˯Э̲ʱ˯ */
+static void _bench_co_sleep_wake(void *ctx, uint32_t count)
+{
+    uint32_t woken = 0;
+    (void)ctx;
+    while (woken < count)
+    {
+        bench_tick_value++;
+        woken += tk_co_schedule();
+    }
+}
+
+/**
+ * @brief Э1~1000msʱ˯ߣÿλѲ˯ߵĿ
+ * 
+ * @param num Э̸
+ */
+static void _bench_co_sleep(uint32_t num)
+{
+    char name[64];
+    struct tk_co *cos;
+    snprintf(name, sizeof(name), "coroutine.sleep.n%u", num);
+    if (bench_enabled(name) == false)
+        return;
+    cos = (struct tk_co *)calloc(num, sizeof(struct tk_co));
+    if (cos == NULL)
+        return;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        tk_co_init(&cos[i], _bench_co_sleeper, NULL);
+        tk_co_start(&cos[i]);
+    }
+    tk_co_schedule();
+    bench_throughput(name, _bench_co_sleep_wake, NULL, num);
+    for (uint32_t i = 0; i < num; i++)
+        tk_co_cancel(&cos[i]);
+    free(cos);
+}
+
+/* ÿֵȻָȫóЭ */
+static void _bench_co_schedule(void *ctx, uint32_t count)
+{
+    struct bench_co_ctx *c = (struct bench_co_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += c->num)
+        tk_co_schedule();
+}
+
+/* ѹݻѵȴеЭ̲ */
+static void _bench_co_queue_resume(void *ctx)
+{
+    struct bench_co_ctx *c = (struct bench_co_ctx *)ctx;
+    uint32_t value = 0;
+    tk_queue_push(c->queue, &value);
+    tk_co_schedule();
+}
+
+void bench_coroutine(void)
+{
+    struct bench_co_ctx ctx;
+    ctx.num = 1000;
+    ctx.cos = (struct tk_co *)calloc(ctx.num, sizeof(struct tk_co));
+    if (ctx.cos == NULL)
+        return;
+    for (uint32_t i = 0; i < ctx.num; i++)
+    {
+        tk_co_init(&ctx.cos[i], _bench_co_yield, NULL);
+        tk_co_start(&ctx.cos[i]);
+    }
+    bench_throughput("coroutine.yield_resume.n1000", _bench_co_schedule, &ctx, ctx.num * 16);
+    for (uint32_t i = 0; i < ctx.num; i++)
+        tk_co_cancel(&ctx.cos[i]);
+
+    ctx.queue = tk_queue_create(sizeof(uint32_t), 16, false);
+    if (ctx.queue != NULL)
+    {
+        tk_co_init(&ctx.cos[0], _bench_co_consumer, ctx.queue);
+        tk_co_start(&ctx.cos[0]);
+        tk_co_schedule();
+        bench_latency("coroutine.queue.push_resume", _bench_co_queue_resume, &ctx);
+        tk_co_cancel(&ctx.cos[0]);
+        tk_queue_delete(ctx.queue);
+    }
+    free(ctx.cos);
+    for (uint32_t num = 1000; num <= (bench_opts.quick ? 100000u : 1000000u); num *= 10)
+        _bench_co_sleep(num);
+}
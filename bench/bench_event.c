@@ -0,0 +1,171 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add wait any benchmark
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "bench.h"
+
+#define BENCH_EVENT_WAIT_MAX 256
+
+struct bench_event_ctx
+{
+    struct tk_event *event;
+    uint32_t recved;
+};
+
+/* ͺʽ */
+static void _bench_event_send_recv(void *ctx)
+{
+    struct bench_event_ctx *c = (struct bench_event_ctx *)ctx;
+    tk_event_send(c->event, 1 << 3);
+    tk_event_recv(c->event, 1 << 3, TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR, &c->recved);
+}
+
+/* Ľ */
+static void _bench_event_recv_miss(void *ctx)
+{
+    struct bench_event_ctx *c = (struct bench_event_ctx *)ctx;
+    tk_event_recv(c->event, 1 << 5, TK_EVENT_OPTION_AND, &c->recved);
+}
+
+/* 1߳ͬʱȴnum¼һ߳ÿԼ50usһֻͣһϢ; */
+struct bench_event_wait_ctx
+{
+    struct tk_event *events[BENCH_EVENT_WAIT_MAX];
+    uint32_t event_sets[BENCH_EVENT_WAIT_MAX];
+    uint8_t options[BENCH_EVENT_WAIT_MAX];
+    uint16_t num;
+    bool poll;
+    uint32_t msgs;
+    uint64_t stamp;
+    uint32_t acked;
+    double *samples;
+    uint64_t cpu_ns;
+};
+
+static void *_bench_event_waiter(void *arg)
+{
+    struct bench_event_wait_ctx *c = arg;
+    uint64_t cpu = bench_thread_cpu_ns();
+    uint32_t recved;
+    uint16_t index, i;
+    for (uint32_t n = 0; n < c->msgs; n++)
+    {
+        if (c->poll)
+        {
+            /* գÿμȫ¼ʱóCPU */
+            while (1)
+            {
+                for (i = 0; i < c->num; i++)
+                {
+                    if (tk_event_recv(c->events[i], c->event_sets[i], c->options[i], &recved))
+                        break;
+                }
+                if (i < c->num)
+                    break;
+                sched_yield();
+            }
+        }
+        else
+        {
+            tk_event_wait_any(c->events, c->event_sets, c->options, c->num, -1, &index, &recved);
+        }
+        c->samples[n] = (double)(bench_now_ns() - __atomic_load_n(&c->stamp, __ATOMIC_ACQUIRE));
+        __atomic_store_n(&c->acked, n + 1, __ATOMIC_RELEASE);
+    }
+    c->cpu_ns = bench_thread_cpu_ns() - cpu;
+    return NULL;
+}
+
+/**
+ * @brief ͬʱȴ¼Ļӳٺ͵ȴ߳ÿϢCPUʱ
+ * 
+ * @param num ¼
+ * @param poll trueѯtk_event_recv falsetk_event_wait_any
+ */
+static void _bench_event_wait(uint16_t num, bool poll)
+{
+    static struct bench_event_wait_ctx ctx;
+    char name[64];
+    pthread_t thread;
+    uint32_t seed = 1;
+    uint64_t begin, ns;
+    snprintf(name, sizeof(name), "event.wake.%s.n%u", poll ? "poll" : "wait_any", (unsigned)num);
+    if (bench_enabled(name) == false)
+        return;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.num = num;
+    ctx.poll = poll;
+    ctx.msgs = bench_opts.quick ? 2000 : 20000;
+    ctx.samples = malloc(sizeof(double) * ctx.msgs);
+    for (uint16_t i = 0; i < num; i++)
+    {
+        ctx.events[i] = tk_event_create();
+        ctx.event_sets[i] = 1;
+        ctx.options[i] = TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR;
+    }
+    pthread_create(&thread, NULL, _bench_event_waiter, &ctx);
+    begin = bench_now_ns();
+    for (uint32_t n = 0; n < ctx.msgs; n++)
+    {
+        usleep(50);
+        seed = seed * 1103515245 + 12345;
+        __atomic_store_n(&ctx.stamp, bench_now_ns(), __ATOMIC_RELEASE);
+        tk_event_send(ctx.events[(seed >> 16) % num], 1);
+        while (__atomic_load_n(&ctx.acked, __ATOMIC_ACQUIRE) != n + 1)
+            sched_yield();
+    }
+    ns = bench_now_ns() - begin;
+    pthread_join(thread, NULL);
+    bench_report_samples(name, ctx.samples, ctx.msgs, ctx.msgs, ns);
+    snprintf(name, sizeof(name), "event.wake.%s.n%u.cpu", poll ? "poll" : "wait_any", (unsigned)num);
+    bench_report_value(name, "ns/msg", (double)ctx.cpu_ns / ctx.msgs);
+    for (uint16_t i = 0; i < num; i++)
+        tk_event_delete(ctx.events[i]);
+    free(ctx.samples);
+}
+
+void bench_event(void)
+{
+    struct bench_event_ctx ctx;
+    ctx.event = tk_event_create();
+    if (ctx.event == NULL)
+        return;
+    bench_latency("event.send_recv", _bench_event_send_recv, &ctx);
+    bench_latency("event.recv_miss", _bench_event_recv_miss, &ctx);
+    if (tk_event_get_fd(ctx.event, 1 << 3, TK_EVENT_OPTION_OR) >= 0)
+        bench_latency("event.fd.send_recv", _bench_event_send_recv, &ctx);
+    tk_event_delete(ctx.event);
+    for (uint16_t num = 1; num <= BENCH_EVENT_WAIT_MAX; num *= 4)
+    {
+        _bench_event_wait(num, false);
+        _bench_event_wait(num, true);
+    }
+}
@@ -0,0 +1,150 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "bench.h"
+
+#define BENCH_JOURNAL_RECORD 256
+#define BENCH_JOURNAL_BATCH 1024
+
+/**
+ * @brief ɾĿ¼е־ļ(ڲ)
+ * 
+ */
+static void _bench_journal_remove(void)
+{
+    char cmd[512];
+    snprintf(cmd, sizeof(cmd), "rm -rf '%s'", bench_opts.journal_dir);
+    if (system(cmd) != 0)
+        fprintf(stderr, "failed to remove %s\n", bench_opts.journal_dir);
+}
+
+/**
+ * @brief 򿪲ʹõĳ־û(ڲ)
+ * 
+ * @param queue ж
+ * @param pool л־ģʽ²ʹ
+ * @param sync_batch ύĲ
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _bench_journal_open(struct tk_queue *queue, uint8_t *pool, uint32_t sync_batch)
+{
+    tk_queue_init(queue, pool, BENCH_JOURNAL_RECORD, BENCH_JOURNAL_RECORD, false);
+    if (tk_queue_journal_open(queue, bench_opts.journal_dir, sync_batch) == false)
+    {
+        perror(bench_opts.journal_dir);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ÿѹ붼ύ־ûѹӳ
+ * 
+ */
+static void _bench_journal_durable_push(void)
+{
+    static uint8_t pool[BENCH_JOURNAL_RECORD];
+    uint8_t value[BENCH_JOURNAL_RECORD];
+    struct tk_queue queue;
+    uint32_t count = bench_opts.quick ? 200 : 2000;
+    uint64_t begin;
+    if (bench_enabled("journal.push.sync_b1") == false)
+        return;
+    _bench_journal_remove();
+    if (_bench_journal_open(&queue, pool, 1) == false)
+        return;
+    memset(value, 0x5A, sizeof(value));
+    begin = bench_now_ns();
+    for (uint32_t i = 0; i < count; i++)
+        tk_queue_push(&queue, value);
+    bench_report_value("journal.push.sync_b1", "us", (double)(bench_now_ns() - begin) / count / 1000.0);
+    tk_queue_detach(&queue);
+    _bench_journal_remove();
+}
+
+/**
+ * @brief ύдѹݣдָʱ
+ * ָֻɨβΣʱӦѹ޹
+ * 
+ */
+static void _bench_journal_backlog(void)
+{
+    static uint8_t pool[BENCH_JOURNAL_RECORD];
+    uint8_t value[BENCH_JOURNAL_RECORD];
+    struct tk_queue queue;
+    uint64_t count = (uint64_t)bench_opts.journal_mb * 1024 * 1024 / BENCH_JOURNAL_RECORD;
+    double mb = (double)count * BENCH_JOURNAL_RECORD / (1024.0 * 1024.0);
+    uint64_t begin, ns;
+    if (bench_enabled("journal.backlog") == false)
+        return;
+    _bench_journal_remove();
+    if (_bench_journal_open(&queue, pool, BENCH_JOURNAL_BATCH) == false)
+        return;
+    memset(value, 0x5A, sizeof(value));
+    bench_report_value("journal.backlog.size", "MB", mb);
+
+    begin = bench_now_ns();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        memcpy(value, &i, sizeof(i));
+        if (tk_queue_push(&queue, value) == false)
+        {
+            perror("journal push");
+            break;
+        }
+    }
+    tk_queue_journal_sync(&queue);
+    ns = bench_now_ns() - begin;
+    bench_report_value("journal.backlog.push_b1024", "MB/s", mb * 1e9 / (double)ns);
+    tk_queue_detach(&queue);
+
+    begin = bench_now_ns();
+    if (_bench_journal_open(&queue, pool, BENCH_JOURNAL_BATCH) == false)
+        return;
+    ns = bench_now_ns() - begin;
+    bench_report_value("journal.backlog.recovery", "ms", (double)ns / 1e6);
+    if (tk_queue_journal_len(&queue) != count)
+        fprintf(stderr, "journal.backlog: recovered %llu of %llu records\n",
+                (unsigned long long)tk_queue_journal_len(&queue), (unsigned long long)count);
+
+    begin = bench_now_ns();
+    for (uint64_t i = 0; i < count && tk_queue_pop(&queue, value); i++)
+        ;
+    tk_queue_journal_sync(&queue);
+    ns = bench_now_ns() - begin;
+    bench_report_value("journal.backlog.pop_b1024", "MB/s", mb * 1e9 / (double)ns);
+    tk_queue_detach(&queue);
+    _bench_journal_remove();
+}
+
+void bench_journal(void)
+{
+    _bench_journal_durable_push();
+    _bench_journal_backlog();
+}
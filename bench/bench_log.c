@@ -0,0 +1,121 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     switch the time function while the logger is stopped
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "bench.h"
+
+struct bench_log_ctx
+{
+    FILE *fp;
+    uint32_t seq;
+};
+
+/* 첽־ */
+static void _bench_log_write(void *ctx)
+{
+    struct bench_log_ctx *c = (struct bench_log_ctx *)ctx;
+    TK_LOG("order %u filled qty=%d\n", c->seq++, 100);
+}
+
+/* ַ첽־ַڵʱ */
+static void _bench_log_write_str(void *ctx)
+{
+    struct bench_log_ctx *c = (struct bench_log_ctx *)ctx;
+    TK_LOG("order %u filled qty=%d symbol=%s\n", c->seq++, 100, "ABCD");
+}
+
+/* ־ʱʹrdtscڼ(ڲ) */
+static uint64_t _bench_log_cycles(void)
+{
+    return bench_cycles();
+}
+
+/* ֻʽΪʽĲ */
+static void _bench_log_snprintf(void *ctx)
+{
+    struct bench_log_ctx *c = (struct bench_log_ctx *)ctx;
+    char buf[128];
+    snprintf(buf, sizeof(buf), "order %u filled qty=%d\n", c->seq++, 100);
+    __asm__ __volatile__("" : : "r"(buf) : "memory");
+}
+
+/* TK_DEBUGͬͬʽ */
+static void _bench_log_fprintf(void *ctx)
+{
+    struct bench_log_ctx *c = (struct bench_log_ctx *)ctx;
+    fprintf(c->fp, "order %u filled qty=%d\n", c->seq++, 100);
+}
+
+/**
+ * @brief ͬfprintfĵӳ٣/dev/null
+ * 
+ * @param name 
+ * @param mode 巽ʽ_IONBFͬstderr_IOLBFͬն˵stdout
+ */
+static void _bench_log_stdio(const char *name, int mode)
+{
+    struct bench_log_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    if ((ctx.fp = fopen("/dev/null", "w")) == NULL)
+        return;
+    setvbuf(ctx.fp, NULL, mode, BUFSIZ);
+    bench_latency(name, _bench_log_fprintf, &ctx);
+    fclose(ctx.fp);
+}
+
+void bench_log(void)
+{
+    struct bench_log_ctx ctx;
+    int fd;
+    memset(&ctx, 0, sizeof(ctx));
+
+    /* ģʽÿд붼ִУʱɵļ¼ */
+    if ((fd = open("/dev/null", O_WRONLY | O_CLOEXEC)) >= 0 && tk_log_start(fd, true))
+    {
+        bench_latency("log.tk_log.2args", _bench_log_write, &ctx);
+        bench_latency("log.tk_log.3args_str", _bench_log_write_str, &ctx);
+        /* Ĭʱ亯Ϊclock_gettimeڼĵÿʱ亯ֹֻͣ */
+        tk_log_stop();
+        tk_log_set_time_func(_bench_log_cycles, (uint64_t)(1e9 / bench_cycles_to_ns(1000000) * 1000000));
+        if (tk_log_start(fd, true))
+        {
+            bench_latency("log.tk_log.2args_cycles", _bench_log_write, &ctx);
+            tk_log_stop();
+        }
+        tk_log_set_time_func(NULL, 0);
+        if (bench_enabled("log.tk_log"))
+            bench_report_value("log.tk_log.lost_ratio", "ratio", (double)tk_log_lost() / (ctx.seq ? ctx.seq : 1));
+    }
+    if (fd >= 0)
+        close(fd);
+    bench_latency("log.snprintf", _bench_log_snprintf, &ctx);
+    _bench_log_stdio("log.fprintf.unbuffered", _IONBF);
+    _bench_log_stdio("log.fprintf.line_buffered", _IOLBF);
+}
@@ -0,0 +1,171 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     release the consumer thread timer list
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include "bench.h"
+
+struct bench_loop_ctx
+{
+    struct tk_loop *loop;
+    struct tk_event *event;
+    uint32_t dispatched;
+};
+
+struct bench_loop_shared
+{
+    struct tk_queue *queue;
+    pthread_mutex_t mutex;
+    double *latency;
+    uint32_t received;
+    bool ready;
+};
+
+static void _bench_loop_event_callback(struct tk_loop_watch *watch)
+{
+    ((struct bench_loop_ctx *)watch->user_data)->dispatched++;
+}
+
+/* ¼һ¼ѭ¼eventfdepollַص */
+static void _bench_loop_event_dispatch(void *ctx)
+{
+    struct bench_loop_ctx *c = (struct bench_loop_ctx *)ctx;
+    tk_event_send(c->event, 1);
+    tk_loop_run_once(c->loop, 0);
+}
+
+static void _bench_loop_queue_callback(struct tk_loop_watch *watch)
+{
+    struct bench_loop_shared *shared = (struct bench_loop_shared *)watch->user_data;
+    uint64_t stamp;
+    bool result;
+    while (1)
+    {
+        pthread_mutex_lock(&shared->mutex);
+        result = tk_queue_pop(shared->queue, &stamp);
+        pthread_mutex_unlock(&shared->mutex);
+        if (result == false)
+            break;
+        if (stamp == 0)
+        {
+            tk_loop_stop(watch->loop);
+            break;
+        }
+        shared->latency[shared->received] = (double)(bench_now_ns() - stamp);
+        __atomic_store_n(&shared->received, shared->received + 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void *_bench_loop_consumer(void *param)
+{
+    struct bench_loop_shared *shared = (struct bench_loop_shared *)param;
+    struct tk_loop loop;
+    struct tk_loop_watch watch;
+    tk_timer_func_init(bench_get_tick);
+    if (tk_loop_init(&loop) == false)
+    {
+        tk_timer_func_deinit();
+        return NULL;
+    }
+    watch.user_data = shared;
+    tk_loop_add_queue(&loop, &watch, shared->queue, _bench_loop_queue_callback);
+    __atomic_store_n(&shared->ready, true, __ATOMIC_RELEASE);
+    tk_loop_run(&loop);
+    tk_loop_detach(&loop);
+    tk_timer_func_deinit();
+    return NULL;
+}
+
+/**
+ * @brief ̻߳ӳ٣ѹʱ¼ѭУѺȡ
+ * ÿϢٷһ
+ * 
+ */
+static void _bench_loop_cross_thread(void)
+{
+    const char *name = "loop.queue.cross_thread_wakeup";
+    struct bench_loop_shared shared;
+    pthread_t thread;
+    uint32_t num = bench_opts.quick ? 1000 : 10000;
+    uint64_t stamp;
+    if (bench_enabled(name) == false)
+        return;
+    memset(&shared, 0, sizeof(shared));
+    shared.latency = (double *)malloc(num * sizeof(double));
+    shared.queue = tk_queue_create(sizeof(uint64_t), 16, false);
+    if (shared.latency == NULL || shared.queue == NULL || tk_queue_get_fd(shared.queue) < 0)
+        goto exit;
+    pthread_mutex_init(&shared.mutex, NULL);
+    pthread_create(&thread, NULL, _bench_loop_consumer, &shared);
+    while (__atomic_load_n(&shared.ready, __ATOMIC_ACQUIRE) == false)
+        sched_yield();
+    for (uint32_t i = 0; i < num; i++)
+    {
+        stamp = bench_now_ns();
+        pthread_mutex_lock(&shared.mutex);
+        tk_queue_push(shared.queue, &stamp);
+        pthread_mutex_unlock(&shared.mutex);
+        while (__atomic_load_n(&shared.received, __ATOMIC_ACQUIRE) == i)
+            sched_yield();
+    }
+    stamp = 0;
+    pthread_mutex_lock(&shared.mutex);
+    tk_queue_push(shared.queue, &stamp);
+    pthread_mutex_unlock(&shared.mutex);
+    pthread_join(thread, NULL);
+    pthread_mutex_destroy(&shared.mutex);
+    bench_report_samples(name, shared.latency, num, num, 0);
+exit:
+    if (shared.queue != NULL)
+        tk_queue_delete(shared.queue);
+    free(shared.latency);
+}
+
+void bench_loop(void)
+{
+    struct bench_loop_ctx ctx;
+    struct tk_loop_watch watch;
+    memset(&ctx, 0, sizeof(ctx));
+    memset(&watch, 0, sizeof(watch));
+    ctx.loop = tk_loop_create();
+    ctx.event = tk_event_create();
+    if (ctx.loop != NULL && ctx.event != NULL)
+    {
+        watch.user_data = &ctx;
+        if (tk_loop_add_event(ctx.loop, &watch, ctx.event, 1, TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR,
+                              _bench_loop_event_callback))
+            bench_latency("loop.event.dispatch", _bench_loop_event_dispatch, &ctx);
+    }
+    if (ctx.loop != NULL)
+        tk_loop_delete(ctx.loop);
+    if (ctx.event != NULL)
+        tk_event_delete(ctx.event);
+    tk_timer_release_fd();
+    _bench_loop_cross_thread();
+}
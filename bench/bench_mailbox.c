@@ -0,0 +1,189 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <pthread.h>
+#include "bench.h"
+
+#define BENCH_MAILBOX_MAX_READERS 32
+#define BENCH_MAILBOX_MAX_SIZE 4096
+
+struct bench_mailbox_shared
+{
+    bool locked;
+    uint32_t size;
+    struct tk_mailbox *mailbox;
+    struct tk_queue *queue;
+    pthread_mutex_t mutex;
+    volatile bool stop;
+    uint64_t reads[BENCH_MAILBOX_MAX_READERS];
+};
+
+struct bench_mailbox_reader
+{
+    struct bench_mailbox_shared *shared;
+    uint16_t index;
+};
+
+/* ߣseqlockȡtk_queue_peep(keep_freshԪض) */
+static void *_bench_mailbox_reader(void *param)
+{
+    struct bench_mailbox_reader *reader = (struct bench_mailbox_reader *)param;
+    struct bench_mailbox_shared *shared = reader->shared;
+    uint8_t value[BENCH_MAILBOX_MAX_SIZE];
+    uint64_t reads = 0;
+    while (shared->stop == false)
+    {
+        if (shared->locked)
+        {
+            pthread_mutex_lock(&shared->mutex);
+            tk_queue_peep(shared->queue, value);
+            pthread_mutex_unlock(&shared->mutex);
+        }
+        else
+        {
+            tk_mailbox_read(shared->mailbox, value, NULL);
+        }
+        reads++;
+    }
+    shared->reads[reader->index] = reads;
+    return NULL;
+}
+
+/**
+ * @brief һд߳д룬readers߳ȡдͶȡ
+ * 
+ * @param size ݴС(λֽ)
+ * @param readers ߳
+ * @param locked truekeep_freshԪض falsetk_mailbox
+ */
+static void _bench_mailbox_rw(uint32_t size, uint16_t readers, bool locked)
+{
+    static struct bench_mailbox_shared shared;
+    struct bench_mailbox_reader reader[BENCH_MAILBOX_MAX_READERS];
+    pthread_t threads[BENCH_MAILBOX_MAX_READERS];
+    uint8_t value[BENCH_MAILBOX_MAX_SIZE];
+    char name[64], prefix[48];
+    uint64_t begin, ns, deadline, writes = 0, reads = 0;
+    snprintf(prefix, sizeof(prefix), "mailbox.%s.%uB.r%u", locked ? "locked_queue" : "seqlock",
+             (unsigned)size, (unsigned)readers);
+    snprintf(name, sizeof(name), "%s.write", prefix);
+    if (bench_enabled(name) == false)
+        return;
+    memset(&shared, 0, sizeof(shared));
+    memset(value, 0x5a, sizeof(value));
+    shared.locked = locked;
+    shared.size = size;
+    shared.mailbox = tk_mailbox_create(size);
+    shared.queue = tk_queue_create(size, 1, true);
+    pthread_mutex_init(&shared.mutex, NULL);
+    tk_mailbox_write(shared.mailbox, value);
+    tk_queue_push(shared.queue, value);
+    for (uint16_t i = 0; i < readers; i++)
+    {
+        reader[i].shared = &shared;
+        reader[i].index = i;
+        pthread_create(&threads[i], NULL, _bench_mailbox_reader, &reader[i]);
+    }
+    begin = bench_now_ns();
+    deadline = begin + (bench_opts.quick ? 20000000ULL : 100000000ULL);
+    do
+    {
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            value[0] = (uint8_t)writes++;
+            if (locked)
+            {
+                pthread_mutex_lock(&shared.mutex);
+                tk_queue_push(shared.queue, value);
+                pthread_mutex_unlock(&shared.mutex);
+            }
+            else
+            {
+                tk_mailbox_write(shared.mailbox, value);
+            }
+        }
+    } while (bench_now_ns() < deadline);
+    shared.stop = true;
+    for (uint16_t i = 0; i < readers; i++)
+    {
+        pthread_join(threads[i], NULL);
+        reads += shared.reads[i];
+    }
+    ns = bench_now_ns() - begin;
+    bench_report_value(name, "ops/s", (double)writes * 1e9 / (double)ns);
+    snprintf(name, sizeof(name), "%s.read", prefix);
+    bench_report_value(name, "ops/s", (double)reads * 1e9 / (double)ns);
+    pthread_mutex_destroy(&shared.mutex);
+    tk_mailbox_delete(shared.mailbox);
+    tk_queue_delete(shared.queue);
+}
+
+struct bench_mailbox_ctx
+{
+    struct tk_mailbox *mailbox;
+    uint32_t version;
+    uint8_t value[BENCH_MAILBOX_MAX_SIZE];
+};
+
+static void _bench_mailbox_read(void *ctx)
+{
+    struct bench_mailbox_ctx *c = (struct bench_mailbox_ctx *)ctx;
+    tk_mailbox_read(c->mailbox, c->value, NULL);
+}
+
+/* 汾δ仯ʱ */
+static void _bench_mailbox_read_unchanged(void *ctx)
+{
+    struct bench_mailbox_ctx *c = (struct bench_mailbox_ctx *)ctx;
+    tk_mailbox_read(c->mailbox, c->value, &c->version);
+}
+
+void bench_mailbox(void)
+{
+    static const uint32_t sizes[] = {64, BENCH_MAILBOX_MAX_SIZE};
+    static struct bench_mailbox_ctx ctx;
+    char name[64];
+
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        ctx.mailbox = tk_mailbox_create(sizes[s]);
+        tk_mailbox_write(ctx.mailbox, ctx.value);
+        tk_mailbox_read(ctx.mailbox, ctx.value, &ctx.version);
+        snprintf(name, sizeof(name), "mailbox.read.%uB", (unsigned)sizes[s]);
+        bench_latency(name, _bench_mailbox_read, &ctx);
+        snprintf(name, sizeof(name), "mailbox.read_unchanged.%uB", (unsigned)sizes[s]);
+        bench_latency(name, _bench_mailbox_read_unchanged, &ctx);
+        tk_mailbox_delete(ctx.mailbox);
+
+        for (uint16_t readers = 1; readers <= BENCH_MAILBOX_MAX_READERS; readers *= 2)
+        {
+            _bench_mailbox_rw(sizes[s], readers, false);
+            _bench_mailbox_rw(sizes[s], readers, true);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add priority queue size
+* 2026-10-19     zhangran     add bus size
+* 2026-10-19     zhangran     add mailbox size
+* 2026-10-19     zhangran     add buffer pool size
+*/
+
+#include "bench.h"
+
+/**
+ * @brief ڴռãͳݳشС
+ * 
+ */
+void bench_memory(void)
+{
+    if (bench_enabled("memory") == false)
+        return;
+    bench_report_value("memory.queue", "bytes", sizeof(struct tk_queue));
+    bench_report_value("memory.queue.pool_1024x4B", "bytes", sizeof(struct tk_queue) + 1024 * sizeof(uint32_t));
+    bench_report_value("memory.pqueue.pool_1024x4B", "bytes", sizeof(struct tk_pqueue) + TK_PQUEUE_POOL_SIZE(sizeof(uint32_t), 1024));
+    bench_report_value("memory.mlqueue", "bytes", sizeof(struct tk_mlqueue));
+    bench_report_value("memory.timer", "bytes", sizeof(struct tk_timer));
+    bench_report_value("memory.event", "bytes", sizeof(struct tk_event));
+    bench_report_value("memory.bus", "bytes", sizeof(struct tk_bus));
+    bench_report_value("memory.bus_sub", "bytes", sizeof(struct tk_bus_sub));
+    bench_report_value("memory.mailbox", "bytes", sizeof(struct tk_mailbox));
+    bench_report_value("memory.bufpool", "bytes", sizeof(struct tk_bufpool));
+    bench_report_value("memory.bufpool_buf", "bytes", sizeof(struct tk_buf));
+    bench_report_value("memory.loop", "bytes", sizeof(struct tk_loop));
+    bench_report_value("memory.loop_watch", "bytes", sizeof(struct tk_loop_watch));
+    bench_report_value("memory.coroutine", "bytes", sizeof(struct tk_co));
+}
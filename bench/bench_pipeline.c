@@ -0,0 +1,309 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     calibrated emit work, unpinned stages, alternating repetitions
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "bench.h"
+
+#define BENCH_PIPELINE_STAGES 4
+#define BENCH_PIPELINE_DEPTH 1024
+
+/* ->ȫ->ۺ->ÿ׶ζ64ֽڼ¼ */
+struct bench_pipeline_record
+{
+    uint64_t id;
+    uint64_t v[7];
+};
+
+/* ׶ÿԪصĿѭ_bench_pipeline_calibrateCPUʱ궨CPUƵ޹ */
+static uint32_t bench_pipeline_emit_spin = 0;
+static uint64_t bench_pipeline_sum = 0;
+
+/**
+ * @brief 궨ÿus CPUʱӦĿѭ߳CPUʱƣռӰ
+ * 
+ * @return double ÿusĿѭ
+ */
+static double _bench_pipeline_calibrate(void)
+{
+    const uint32_t spin = 100000;
+    uint64_t best = UINT64_MAX;
+    for (uint32_t round = 0; round < 5; round++)
+    {
+        uint64_t begin = bench_thread_cpu_ns();
+        for (volatile uint32_t i = 0; i < spin; i++)
+            ;
+        uint64_t ns = bench_thread_cpu_ns() - begin;
+        if (ns < best)
+            best = ns;
+    }
+    return (double)spin * 1000.0 / (double)(best ? best : 1);
+}
+
+static void _bench_pipeline_work(uint32_t stage, struct bench_pipeline_record *r)
+{
+    switch (stage)
+    {
+    case 0:
+        r->v[0] = r->id * 0x9e3779b97f4a7c15ULL;
+        break;
+    case 1:
+        r->v[1] = (r->v[0] ^ (r->v[0] >> 29)) * 0xbf58476d1ce4e5b9ULL;
+        break;
+    case 2:
+        r->v[2] = r->v[0] + r->v[1];
+        break;
+    default:
+        /* ׶Σģα */
+        for (volatile uint32_t i = 0; i < bench_pipeline_emit_spin; i++)
+            ;
+        bench_pipeline_sum += r->v[2];
+        break;
+    }
+}
+
+static uint32_t _bench_pipeline_stage(void *user_data, const void *in, void *out, uint32_t num)
+{
+    uint32_t stage = (uint32_t)(uintptr_t)user_data;
+    const struct bench_pipeline_record *src = in;
+    struct bench_pipeline_record *dst = out;
+    struct bench_pipeline_record r;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        r = src[i];
+        _bench_pipeline_work(stage, &r);
+        if (dst != NULL)
+            dst[i] = r;
+    }
+    return (dst != NULL) ? num : 0;
+}
+
+/* գÿ׶һ̣߳׶֮Ϊtk_queueݣпջʱóCPU */
+struct bench_pipeline_locked_link
+{
+    pthread_mutex_t lock;
+    struct tk_queue *queue;
+};
+
+struct bench_pipeline_locked_stage
+{
+    uint32_t stage;
+    uint32_t num;
+    struct bench_pipeline_locked_link *in;
+    struct bench_pipeline_locked_link *out;
+};
+
+static void _bench_pipeline_locked_push(struct bench_pipeline_locked_link *link, struct bench_pipeline_record *r)
+{
+    bool result;
+    do
+    {
+        pthread_mutex_lock(&link->lock);
+        result = tk_queue_push(link->queue, r);
+        pthread_mutex_unlock(&link->lock);
+        if (result == false)
+            sched_yield();
+    } while (result == false);
+}
+
+static void *_bench_pipeline_locked_thread(void *arg)
+{
+    struct bench_pipeline_locked_stage *stage = arg;
+    struct bench_pipeline_record r;
+    uint32_t done = 0;
+    bool result;
+    while (done < stage->num)
+    {
+        pthread_mutex_lock(&stage->in->lock);
+        result = tk_queue_pop(stage->in->queue, &r);
+        pthread_mutex_unlock(&stage->in->lock);
+        if (result == false)
+        {
+            sched_yield();
+            continue;
+        }
+        _bench_pipeline_work(stage->stage, &r);
+        if (stage->out != NULL)
+            _bench_pipeline_locked_push(stage->out, &r);
+        done++;
+    }
+    return NULL;
+}
+
+static uint64_t _bench_pipeline_process_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void _bench_pipeline_locked_run(uint32_t num)
+{
+    struct bench_pipeline_locked_link links[BENCH_PIPELINE_STAGES];
+    struct bench_pipeline_locked_stage stages[BENCH_PIPELINE_STAGES];
+    pthread_t threads[BENCH_PIPELINE_STAGES];
+    struct bench_pipeline_record r;
+    for (uint32_t i = 0; i < BENCH_PIPELINE_STAGES; i++)
+    {
+        pthread_mutex_init(&links[i].lock, NULL);
+        links[i].queue = tk_queue_create(sizeof(struct bench_pipeline_record), BENCH_PIPELINE_DEPTH, false);
+        stages[i].stage = i;
+        stages[i].num = num;
+        stages[i].in = &links[i];
+        stages[i].out = (i + 1 < BENCH_PIPELINE_STAGES) ? &links[i + 1] : NULL;
+    }
+    for (uint32_t i = 0; i < BENCH_PIPELINE_STAGES; i++)
+        pthread_create(&threads[i], NULL, _bench_pipeline_locked_thread, &stages[i]);
+    memset(&r, 0, sizeof(r));
+    for (uint32_t i = 0; i < num; i++)
+    {
+        r.id = i;
+        _bench_pipeline_locked_push(&links[0], &r);
+    }
+    for (uint32_t i = 0; i < BENCH_PIPELINE_STAGES; i++)
+        pthread_join(threads[i], NULL);
+    for (uint32_t i = 0; i < BENCH_PIPELINE_STAGES; i++)
+    {
+        tk_queue_delete(links[i].queue);
+        pthread_mutex_destroy(&links[i].lock);
+    }
+}
+
+static void _bench_pipeline_run(uint32_t num, const char *prefix, bool report)
+{
+    struct tk_pipeline *pipeline = tk_pipeline_create(sizeof(struct bench_pipeline_record));
+    struct bench_pipeline_record batch[TK_PIPELINE_BATCH_SIZE];
+    struct tk_pipeline_stats stats;
+    char name[96];
+    if (pipeline == NULL)
+        return;
+    for (uint32_t i = 0; i < BENCH_PIPELINE_STAGES; i++)
+    {
+        /* ˣһɵCPU */
+        tk_pipeline_add_stage(pipeline, _bench_pipeline_stage, (void *)(uintptr_t)i,
+                              (i + 1 < BENCH_PIPELINE_STAGES) ? sizeof(struct bench_pipeline_record) : 0,
+                              -1);
+    }
+    tk_pipeline_start(pipeline);
+    memset(batch, 0, sizeof(batch));
+    for (uint32_t i = 0; i < num; i += TK_PIPELINE_BATCH_SIZE)
+    {
+        uint32_t len = (num - i < TK_PIPELINE_BATCH_SIZE) ? num - i : TK_PIPELINE_BATCH_SIZE;
+        for (uint32_t j = 0; j < len; j++)
+            batch[j].id = i + j;
+        tk_pipeline_push_multi(pipeline, batch, len);
+    }
+    tk_pipeline_stop(pipeline);
+    for (uint32_t i = 0; report && i < BENCH_PIPELINE_STAGES; i++)
+    {
+        if (tk_pipeline_get_stats(pipeline, i, &stats) == false || stats.batches == 0)
+            continue;
+        snprintf(name, sizeof(name), "%s.stage%u.occupancy", prefix, (unsigned)i);
+        bench_report_value(name, "elems", (double)stats.occupancy / (double)stats.batches);
+        snprintf(name, sizeof(name), "%s.stage%u.parks", prefix, (unsigned)i);
+        bench_report_value(name, "parks", (double)(stats.starved + stats.blocked));
+        /* ׶κڵǽʱ䣬߳ռʱ */
+        snprintf(name, sizeof(name), "%s.stage%u.busy", prefix, (unsigned)i);
+        bench_report_value(name, "ns/elem", (double)stats.busy_ns / (double)stats.in_num);
+    }
+    tk_pipeline_delete(pipeline);
+}
+
+static int _bench_pipeline_cmp(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 4׶εˮߣtk_pipelinetk_queueɴΣºÿԪ
+ * ĵCPUʱ(ȫ֮߳)λƵƯƻֻӰһ
+ * 
+ * @param emit_ns ׶ÿԪضĵCPUʱ(λns)0Ϊ׶ٶ
+ * @param num ÿеԪظ
+ */
+static void _bench_pipeline_4stage(uint32_t emit_ns, uint32_t num)
+{
+    const uint32_t reps = bench_opts.quick ? 1 : 5;
+    double throughput[2][5], cpu_ns[2][5];
+    char prefix[2][64], name[sizeof(prefix) + 32];
+    bool enabled[2];
+    for (uint32_t k = 0; k < 2; k++)
+    {
+        snprintf(prefix[k], sizeof(prefix[k]), "pipeline.%s.4stage%s", k ? "tk_pipeline" : "locked_queue",
+                 emit_ns ? ".slow_emit" : "");
+        enabled[k] = bench_enabled(prefix[k]);
+    }
+    if (enabled[0] == false && enabled[1] == false)
+        return;
+    bench_pipeline_emit_spin = (uint32_t)(_bench_pipeline_calibrate() * emit_ns / 1000.0);
+    for (uint32_t r = 0; r < reps; r++)
+    {
+        for (uint32_t n = 0; n < 2; n++)
+        {
+            /* ÿֽȺ˳ */
+            uint32_t k = (r & 1) ? 1 - n : n;
+            uint64_t begin, ns, cpu;
+            if (enabled[k] == false)
+                continue;
+            bench_pipeline_sum = 0;
+            begin = bench_now_ns();
+            cpu = _bench_pipeline_process_cpu_ns();
+            if (k)
+                _bench_pipeline_run(num, prefix[k], r + 1 == reps);
+            else
+                _bench_pipeline_locked_run(num);
+            cpu = _bench_pipeline_process_cpu_ns() - cpu;
+            ns = bench_now_ns() - begin;
+            throughput[k][r] = (double)num * 1e9 / (double)ns;
+            cpu_ns[k][r] = (double)cpu / (double)num;
+        }
+    }
+    for (uint32_t k = 0; k < 2; k++)
+    {
+        if (enabled[k] == false)
+            continue;
+        qsort(throughput[k], reps, sizeof(double), _bench_pipeline_cmp);
+        qsort(cpu_ns[k], reps, sizeof(double), _bench_pipeline_cmp);
+        snprintf(name, sizeof(name), "%s.throughput", prefix[k]);
+        bench_report_value(name, "elems/s", throughput[k][reps / 2]);
+        snprintf(name, sizeof(name), "%s.cpu", prefix[k]);
+        bench_report_value(name, "ns/elem", cpu_ns[k][reps / 2]);
+    }
+}
+
+void bench_pipeline(void)
+{
+    uint32_t num = bench_opts.quick ? 200000 : 2000000;
+    _bench_pipeline_4stage(0, num);
+    /* ׶ÿԪ1us CPUʱ䣬ν׶δ󲿷ʱȴ */
+    _bench_pipeline_4stage(1000, num / 10);
+}
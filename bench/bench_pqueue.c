@@ -0,0 +1,122 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "bench.h"
+
+#define BENCH_PQUEUE_DEPTH 1024
+#define BENCH_PQUEUE_BANDS 8
+#define BENCH_PQUEUE_PRIOS 4096
+
+struct bench_pqueue_ctx
+{
+    struct tk_pqueue *heap;
+    struct tk_mlqueue *mlqueue;
+    struct tk_queue *fifo;
+    struct tk_queue *bands[BENCH_PQUEUE_BANDS];
+    uint16_t prios[BENCH_PQUEUE_PRIOS];
+    uint32_t index;
+    uint32_t value;
+};
+
+/* ȡһȼ */
+static uint16_t _bench_pqueue_prio(struct bench_pqueue_ctx *c)
+{
+    return c->prios[c->index++ & (BENCH_PQUEUE_PRIOS - 1)];
+}
+
+/* ѣȼѹ1ȼߵ1 */
+static void _bench_pqueue_heap(void *ctx)
+{
+    struct bench_pqueue_ctx *c = (struct bench_pqueue_ctx *)ctx;
+    tk_pqueue_push(c->heap, &c->value, _bench_pqueue_prio(c));
+    tk_pqueue_pop(c->heap, &c->value);
+}
+
+/* ༶Уȼѹ1λͼȼ1 */
+static void _bench_pqueue_mlqueue(void *ctx)
+{
+    struct bench_pqueue_ctx *c = (struct bench_pqueue_ctx *)ctx;
+    tk_mlqueue_push(c->mlqueue, &c->value, (uint8_t)_bench_pqueue_prio(c));
+    tk_mlqueue_pop(c->mlqueue, &c->value);
+}
+
+/* ȽȳУȼΪ׼ */
+static void _bench_pqueue_fifo(void *ctx)
+{
+    struct bench_pqueue_ctx *c = (struct bench_pqueue_ctx *)ctx;
+    _bench_pqueue_prio(c);
+    tk_queue_push(c->fifo, &c->value);
+    tk_queue_pop(c->fifo, &c->value);
+}
+
+/* ÿȼһtk_queueʱβҵһǿն */
+static void _bench_pqueue_bands(void *ctx)
+{
+    struct bench_pqueue_ctx *c = (struct bench_pqueue_ctx *)ctx;
+    tk_queue_push(c->bands[_bench_pqueue_prio(c)], &c->value);
+    for (uint8_t i = 0; i < BENCH_PQUEUE_BANDS; i++)
+    {
+        if (tk_queue_pop(c->bands[i], &c->value))
+            break;
+    }
+}
+
+void bench_pqueue(void)
+{
+    static struct bench_pqueue_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    srand(1);
+    for (uint32_t i = 0; i < BENCH_PQUEUE_PRIOS; i++)
+        ctx.prios[i] = (uint16_t)(rand() % BENCH_PQUEUE_BANDS);
+
+    /* жԤBENCH_PQUEUE_DEPTHݣ̬µѹ+ */
+    ctx.heap = tk_pqueue_create(sizeof(uint32_t), BENCH_PQUEUE_DEPTH * 2);
+    ctx.mlqueue = tk_mlqueue_create(sizeof(uint32_t), BENCH_PQUEUE_DEPTH, BENCH_PQUEUE_BANDS);
+    ctx.fifo = tk_queue_create(sizeof(uint32_t), BENCH_PQUEUE_DEPTH * 2, false);
+    for (uint8_t i = 0; i < BENCH_PQUEUE_BANDS; i++)
+        ctx.bands[i] = tk_queue_create(sizeof(uint32_t), BENCH_PQUEUE_DEPTH, false);
+    for (uint32_t i = 0; i < BENCH_PQUEUE_DEPTH; i++)
+    {
+        uint16_t prio = _bench_pqueue_prio(&ctx);
+        tk_pqueue_push(ctx.heap, &i, prio);
+        tk_mlqueue_push(ctx.mlqueue, &i, (uint8_t)prio);
+        tk_queue_push(ctx.fifo, &i);
+        tk_queue_push(ctx.bands[prio], &i);
+    }
+
+    bench_latency("pqueue.heap.push_pop.b8", _bench_pqueue_heap, &ctx);
+    bench_latency("pqueue.mlqueue.push_pop.b8", _bench_pqueue_mlqueue, &ctx);
+    bench_latency("pqueue.fifo.push_pop", _bench_pqueue_fifo, &ctx);
+    bench_latency("pqueue.queues.push_pop.b8", _bench_pqueue_bands, &ctx);
+
+    tk_pqueue_delete(ctx.heap);
+    tk_mlqueue_delete(ctx.mlqueue);
+    tk_queue_delete(ctx.fifo);
+    for (uint8_t i = 0; i < BENCH_PQUEUE_BANDS; i++)
+        tk_queue_delete(ctx.bands[i]);
+}
@@ -0,0 +1,453 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add ttl drain bench
+* 2026-10-19     zhangran     add adaptive batch wakeup bench
+* 2026-10-19     zhangran     release the producer thread timer list
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <time.h>
+#include "bench.h"
+
+struct bench_queue_ctx
+{
+    struct tk_queue *queue;
+    uint8_t value[64];
+};
+
+struct bench_queue_shared
+{
+    struct tk_queue *queue;
+    pthread_mutex_t mutex;
+    uint32_t per_producer;
+};
+
+/* ѹȡ */
+static void _bench_queue_push_pop(void *ctx)
+{
+    struct bench_queue_ctx *c = (struct bench_queue_ctx *)ctx;
+    tk_queue_push(c->queue, c->value);
+    tk_queue_pop(c->queue, c->value);
+}
+
+/* ʱɵ */
+static void _bench_queue_push_fresh(void *ctx)
+{
+    struct bench_queue_ctx *c = (struct bench_queue_ctx *)ctx;
+    tk_queue_push(c->queue, c->value);
+}
+
+/* ȫȡ */
+static void _bench_queue_fill_drain(void *ctx, uint32_t count)
+{
+    struct bench_queue_ctx *c = (struct bench_queue_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i++)
+        tk_queue_push(c->queue, c->value);
+    for (uint32_t i = 0; i < count; i++)
+        tk_queue_pop(c->queue, c->value);
+}
+
+/* ÿѹ벢ȡ32 */
+static void _bench_queue_multi(void *ctx, uint32_t count)
+{
+    struct bench_queue_ctx *c = (struct bench_queue_ctx *)ctx;
+    uint32_t buf[32];
+    memset(buf, 0, sizeof(buf));
+    for (uint32_t i = 0; i < count; i += 32)
+    {
+        tk_queue_push_multi(c->queue, buf, 32);
+        tk_queue_pop_multi(c->queue, buf, 32);
+    }
+}
+
+static void *_bench_queue_producer(void *param)
+{
+    struct bench_queue_shared *shared = (struct bench_queue_shared *)param;
+    uint32_t value = 0;
+    uint32_t sent = 0;
+    while (sent < shared->per_producer)
+    {
+        pthread_mutex_lock(&shared->mutex);
+        bool result = tk_queue_push(shared->queue, &value);
+        pthread_mutex_unlock(&shared->mutex);
+        if (result)
+            sent++;
+        else
+            sched_yield();
+    }
+    return NULL;
+}
+
+/**
+ * @brief ߵ߾ͬһĶУ
+ * 
+ * @param producers ߳
+ * @param per_producer ÿѹݸ
+ */
+static void _bench_queue_contention(uint16_t producers, uint32_t per_producer)
+{
+    char name[64];
+    struct bench_queue_shared shared;
+    pthread_t *threads;
+    uint64_t total = (uint64_t)producers * per_producer;
+    uint64_t received = 0;
+    uint32_t value;
+    snprintf(name, sizeof(name), "queue.contention.p%u", producers);
+    if (bench_enabled(name) == false)
+        return;
+    threads = (pthread_t *)malloc(producers * sizeof(pthread_t));
+    if (threads == NULL)
+        return;
+    shared.queue = tk_queue_create(sizeof(uint32_t), 1024, false);
+    shared.per_producer = per_producer;
+    pthread_mutex_init(&shared.mutex, NULL);
+    uint64_t begin = bench_now_ns();
+    for (uint16_t i = 0; i < producers; i++)
+        pthread_create(&threads[i], NULL, _bench_queue_producer, &shared);
+    while (received < total)
+    {
+        pthread_mutex_lock(&shared.mutex);
+        bool result = tk_queue_pop(shared.queue, &value);
+        pthread_mutex_unlock(&shared.mutex);
+        if (result)
+            received++;
+        else
+            sched_yield();
+    }
+    uint64_t ns = bench_now_ns() - begin;
+    for (uint16_t i = 0; i < producers; i++)
+        pthread_join(threads[i], NULL);
+    bench_report_value(name, "ops/s", (double)total * 1e9 / (double)ns);
+    pthread_mutex_destroy(&shared.mutex);
+    tk_queue_delete(shared.queue);
+    free(threads);
+}
+
+/**
+ * @brief ͳeventfdŽÿϢϵͳôͻѹburstݺȫȡ
+ * 
+ * @param burst ÿͻݸ
+ */
+static void _bench_queue_fd_syscalls(uint16_t burst)
+{
+    char name[64];
+    struct tk_queue *queue;
+    uint64_t before, after;
+    uint32_t value = 0;
+    uint32_t rounds = bench_opts.quick ? 1000 : 10000;
+    snprintf(name, sizeof(name), "queue.fd.syscalls_per_msg.b%u", burst);
+    if (bench_enabled(name) == false)
+        return;
+    queue = tk_queue_create(sizeof(uint32_t), burst, false);
+    if (queue == NULL || tk_queue_get_fd(queue) < 0 || bench_syscalls(&before) == false)
+    {
+        tk_queue_delete(queue);
+        return;
+    }
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        for (uint16_t j = 0; j < burst; j++)
+            tk_queue_push(queue, &value);
+        while (tk_queue_pop(queue, &value))
+            ;
+    }
+    bench_syscalls(&after);
+    bench_report_value(name, "syscalls", (double)(after - before) / ((double)rounds * burst));
+    tk_queue_delete(queue);
+}
+
+#ifdef TK_QUEUE_USING_TTL
+struct bench_queue_msg
+{
+    uint32_t tick;
+    uint8_t data[60];
+};
+
+/**
+ * @brief ſһstale_pct%ݵĻѹУԱȡʱtk_queue_pop_fresh
+ * 
+ * @param stale_pct ռٷֱ
+ */
+static void _bench_queue_ttl_drain(uint16_t stale_pct)
+{
+    const uint16_t max = 4096;
+    const uint32_t ttl = 100;
+    const uint16_t stale = (uint32_t)max * stale_pct / 100;
+    uint32_t rounds = bench_opts.quick ? 50 : 500;
+    char name_scan[64], name_fresh[64];
+    struct bench_queue_msg msg;
+    struct tk_queue *queue;
+    uint64_t scan_ns = 0, fresh_ns = 0;
+    uint32_t fresh_got = 0;
+    snprintf(name_scan, sizeof(name_scan), "queue.ttl.drain.scan.stale%u", stale_pct);
+    snprintf(name_fresh, sizeof(name_fresh), "queue.ttl.drain.fresh.stale%u", stale_pct);
+    if (bench_enabled(name_scan) == false && bench_enabled(name_fresh) == false)
+        return;
+    queue = tk_queue_create(sizeof(msg), max, false);
+    if (queue == NULL)
+        return;
+    /* ַʽʱֻſշʽͬ */
+    if (tk_queue_set_ttl(queue, ttl, NULL) == false)
+    {
+        tk_queue_delete(queue);
+        return;
+    }
+    memset(&msg, 0, sizeof(msg));
+    for (uint32_t r = 0; r < rounds * 2; r++)
+    {
+        bool use_fresh = (r & 1) != 0;
+        uint64_t begin;
+        /* ǰstalettl֮ǰѹ룬ſʱѹ */
+        for (uint16_t i = 0; i < max; i++)
+        {
+            if (i == stale)
+                bench_tick_value += ttl;
+            msg.tick = bench_tick_value;
+            tk_queue_push(queue, &msg);
+        }
+        begin = bench_now_ns();
+        if (use_fresh)
+        {
+            while (tk_queue_pop_fresh(queue, &msg))
+                fresh_got++;
+            fresh_ns += bench_now_ns() - begin;
+        }
+        else
+        {
+            while (tk_queue_pop(queue, &msg))
+            {
+                if ((uint32_t)(bench_tick_value - msg.tick) >= ttl)
+                    continue;
+                fresh_got++;
+            }
+            scan_ns += bench_now_ns() - begin;
+        }
+        bench_tick_value += 1;
+    }
+    if (bench_enabled(name_scan))
+        bench_report_value(name_scan, "ns/elem", (double)scan_ns / ((double)rounds * max));
+    if (bench_enabled(name_fresh))
+        bench_report_value(name_fresh, "ns/elem", (double)fresh_ns / ((double)rounds * max));
+    if (fresh_got != (uint32_t)rounds * 2 * (max - stale))
+        fprintf(stderr, "%s: unexpected fresh count %u\n", name_fresh, fresh_got);
+    tk_queue_delete(queue);
+}
+#endif /* TK_QUEUE_USING_TTL */
+
+#if defined(TK_QUEUE_USING_BATCH) && defined(TK_TIMER_USING_TLS)
+enum
+{
+    BENCH_QUEUE_WAKE_PUSH = 0, /* ǿռ֪ͨ */
+    BENCH_QUEUE_WAKE_POLL,     /* ÿtickѯ */
+    BENCH_QUEUE_WAKE_BATCH,    /* Ӧ֪ͨ */
+};
+
+struct bench_queue_wake
+{
+    struct tk_queue *queue;
+    pthread_mutex_t mutex;
+    uint8_t mode;
+    uint32_t rate;  /* ÿѹ0Ϊ */
+    uint32_t total;
+    volatile bool done;
+};
+
+static void *_bench_queue_wake_producer(void *param)
+{
+    struct bench_queue_wake *wake = (struct bench_queue_wake *)param;
+    uint64_t begin, stamp;
+    uint32_t sent = 0;
+    /* ʱ̶߳ʱ߳ */
+    tk_timer_func_init(tk_timer_fd_get_tick);
+    pthread_mutex_lock(&wake->mutex);
+    if (wake->mode == BENCH_QUEUE_WAKE_BATCH)
+        tk_queue_set_batch(wake->queue, NULL, 256, 1);
+    pthread_mutex_unlock(&wake->mutex);
+    begin = bench_now_ns();
+    while (sent < wake->total)
+    {
+        bool result;
+        stamp = bench_now_ns();
+        if (wake->rate != 0 && stamp < begin + (uint64_t)sent * 1000000000ULL / wake->rate)
+        {
+            pthread_mutex_lock(&wake->mutex);
+            tk_timer_loop_handler();
+            pthread_mutex_unlock(&wake->mutex);
+            continue;
+        }
+        pthread_mutex_lock(&wake->mutex);
+        result = tk_queue_push(wake->queue, &stamp);
+        tk_timer_loop_handler();
+        pthread_mutex_unlock(&wake->mutex);
+        if (result)
+            sent++;
+    }
+    /* ȡڱ̹߳ر֪ͨͷŶʱ */
+    while (wake->done == false)
+    {
+        pthread_mutex_lock(&wake->mutex);
+        tk_timer_loop_handler();
+        pthread_mutex_unlock(&wake->mutex);
+        sched_yield();
+    }
+    pthread_mutex_lock(&wake->mutex);
+    tk_queue_set_batch(wake->queue, NULL, 0, 0);
+    pthread_mutex_unlock(&wake->mutex);
+    tk_timer_func_deinit();
+    return NULL;
+}
+
+/**
+ * @brief ̰߳ѹʱݣeventfdϻÿtickѯ
+ * ѹ뵽ȡӳٷֲ¼ÿݵĻѴ
+ * 
+ * @param mode ֪ͨʽ
+ * @param rate ÿѹ0Ϊ
+ */
+static void _bench_queue_wake(uint8_t mode, uint32_t rate)
+{
+    static const char *mode_name[] = {"push", "poll", "batch"};
+    const struct timespec tick = {0, 1000000000L / TK_TIMER_TICK_PER_SECOND};
+    char name[64], load[16];
+    struct bench_queue_wake wake;
+    pthread_t thread;
+    double *samples;
+    uint64_t values[64];
+    uint64_t begin, ns;
+    uint32_t received = 0, wakes = 0;
+    int fd;
+    if (rate != 0)
+        snprintf(load, sizeof(load), "r%uk", rate / 1000);
+    else
+        snprintf(load, sizeof(load), "max");
+    snprintf(name, sizeof(name), "queue.wake.%s.%s", mode_name[mode], load);
+    if (bench_enabled(name) == false)
+        return;
+    memset(&wake, 0, sizeof(wake));
+    wake.mode = mode;
+    wake.rate = rate;
+    /* ʱԼ0.2(ģʽ0.05) */
+    wake.total = rate != 0 ? rate / (bench_opts.quick ? 20 : 5) : (bench_opts.quick ? 200000 : 1000000);
+    samples = (double *)malloc(wake.total * sizeof(double));
+    wake.queue = tk_queue_create(sizeof(uint64_t), 1024, false);
+    fd = wake.queue != NULL ? tk_queue_get_fd(wake.queue) : -1;
+    if (samples == NULL || fd < 0)
+    {
+        free(samples);
+        tk_queue_delete(wake.queue);
+        return;
+    }
+    pthread_mutex_init(&wake.mutex, NULL);
+    begin = bench_now_ns();
+    pthread_create(&thread, NULL, _bench_queue_wake_producer, &wake);
+    while (received < wake.total)
+    {
+        uint16_t num;
+        if (mode == BENCH_QUEUE_WAKE_POLL)
+        {
+            nanosleep(&tick, NULL);
+        }
+        else
+        {
+            struct pollfd pfd = {fd, POLLIN, 0};
+            if (poll(&pfd, 1, 100) <= 0)
+                continue;
+        }
+        wakes++;
+        do
+        {
+            uint64_t now;
+            pthread_mutex_lock(&wake.mutex);
+            num = tk_queue_pop_multi(wake.queue, values, sizeof(values) / sizeof(values[0]));
+            pthread_mutex_unlock(&wake.mutex);
+            now = bench_now_ns();
+            for (uint16_t i = 0; i < num && received < wake.total; i++)
+                samples[received++] = (double)(now - values[i]);
+        } while (num != 0);
+    }
+    ns = bench_now_ns() - begin;
+    wake.done = true;
+    pthread_join(thread, NULL);
+    bench_report_samples(name, samples, received, received, ns);
+    snprintf(name, sizeof(name), "queue.wake.%s.%s.wakes_per_msg", mode_name[mode], load);
+    bench_report_value(name, "wakes", (double)wakes / received);
+    pthread_mutex_destroy(&wake.mutex);
+    tk_queue_delete(wake.queue);
+    free(samples);
+}
+#endif /* defined(TK_QUEUE_USING_BATCH) && defined(TK_TIMER_USING_TLS) */
+
+void bench_queue(void)
+{
+    struct bench_queue_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    ctx.queue = tk_queue_create(sizeof(uint32_t), 1024, false);
+    bench_latency("queue.push_pop.4B", _bench_queue_push_pop, &ctx);
+    bench_throughput("queue.fill_drain.4B", _bench_queue_fill_drain, &ctx, 1024);
+    bench_throughput("queue.multi32.4B", _bench_queue_multi, &ctx, 1024);
+    tk_queue_delete(ctx.queue);
+
+    ctx.queue = tk_queue_create(sizeof(ctx.value), 1024, false);
+    bench_latency("queue.push_pop.64B", _bench_queue_push_pop, &ctx);
+    bench_throughput("queue.fill_drain.64B", _bench_queue_fill_drain, &ctx, 1024);
+    tk_queue_delete(ctx.queue);
+
+    ctx.queue = tk_queue_create(sizeof(uint32_t), 1024, true);
+    for (uint32_t i = 0; i < 1024; i++)
+        tk_queue_push(ctx.queue, ctx.value);
+    bench_latency("queue.keep_fresh.push_full", _bench_queue_push_fresh, &ctx);
+    tk_queue_delete(ctx.queue);
+
+    ctx.queue = tk_queue_create(sizeof(uint32_t), 1024, false);
+    if (tk_queue_get_fd(ctx.queue) >= 0)
+        bench_latency("queue.fd.push_pop.4B", _bench_queue_push_pop, &ctx);
+    tk_queue_delete(ctx.queue);
+    _bench_queue_fd_syscalls(1);
+    _bench_queue_fd_syscalls(32);
+
+    for (uint16_t producers = 1; producers <= bench_opts.threads; producers *= 2)
+        _bench_queue_contention(producers, bench_opts.quick ? 20000 : 200000);
+
+#ifdef TK_QUEUE_USING_TTL
+    _bench_queue_ttl_drain(50);
+    _bench_queue_ttl_drain(90);
+    _bench_queue_ttl_drain(99);
+#endif /* TK_QUEUE_USING_TTL */
+
+#if defined(TK_QUEUE_USING_BATCH) && defined(TK_TIMER_USING_TLS)
+    static const uint32_t rates[] = {10000, 100000, 1000000, 0};
+    for (uint32_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        _bench_queue_wake(BENCH_QUEUE_WAKE_PUSH, rates[i]);
+        _bench_queue_wake(BENCH_QUEUE_WAKE_POLL, rates[i]);
+        _bench_queue_wake(BENCH_QUEUE_WAKE_BATCH, rates[i]);
+    }
+#endif /* defined(TK_QUEUE_USING_BATCH) && defined(TK_TIMER_USING_TLS) */
+}
@@ -0,0 +1,157 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "bench.h"
+#include "tk_queue_typed.h"
+
+#define BENCH_QTYPED_DEPTH 1024
+
+struct bench_qtyped_rec16
+{
+    uint32_t id;
+    uint32_t qty;
+    uint64_t price;
+};
+
+struct bench_qtyped_rec256
+{
+    uint8_t data[256];
+};
+
+TK_QUEUE_DEFINE(bench_q4, uint32_t, BENCH_QTYPED_DEPTH)
+TK_QUEUE_DEFINE(bench_q16, struct bench_qtyped_rec16, BENCH_QTYPED_DEPTH)
+TK_QUEUE_DEFINE(bench_q256, struct bench_qtyped_rec256, BENCH_QTYPED_DEPTH)
+
+struct bench_qtyped_ctx
+{
+    struct tk_queue *queue;
+    struct bench_q4 q4;
+    struct bench_q16 q16;
+    struct bench_q256 q256;
+    uint32_t v4[32];
+    struct bench_qtyped_rec16 v16[32];
+    struct bench_qtyped_rec256 v256[32];
+};
+
+/* ͨöУѹȡԪشСctx->queue */
+static void _bench_qtyped_push_pop(void *ctx)
+{
+    struct bench_qtyped_ctx *c = (struct bench_qtyped_ctx *)ctx;
+    tk_queue_push(c->queue, c->v256);
+    tk_queue_pop(c->queue, c->v256);
+}
+
+/* ͨöУȫȡ */
+static void _bench_qtyped_fill_drain(void *ctx, uint32_t count)
+{
+    struct bench_qtyped_ctx *c = (struct bench_qtyped_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i++)
+        tk_queue_push(c->queue, c->v256);
+    for (uint32_t i = 0; i < count; i++)
+        tk_queue_pop(c->queue, c->v256);
+}
+
+/* ͨöУÿѹ벢ȡ32 */
+static void _bench_qtyped_multi(void *ctx, uint32_t count)
+{
+    struct bench_qtyped_ctx *c = (struct bench_qtyped_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += 32)
+    {
+        tk_queue_push_multi(c->queue, c->v256, 32);
+        tk_queue_pop_multi(c->queue, c->v256, 32);
+    }
+}
+
+/* ΪTK_QUEUE_DEFINEɵĶq(ctxԱfieldv)ֲͬ */
+#define BENCH_QTYPED_OPS(q, field, v)                                 \
+    static void _bench_##q##_push_pop(void *ctx)                      \
+    {                                                                 \
+        struct bench_qtyped_ctx *c = (struct bench_qtyped_ctx *)ctx;  \
+        q##_push(&c->field, &c->v[0]);                                \
+        q##_pop(&c->field, &c->v[0]);                                 \
+    }                                                                 \
+    static void _bench_##q##_fill_drain(void *ctx, uint32_t count)    \
+    {                                                                 \
+        struct bench_qtyped_ctx *c = (struct bench_qtyped_ctx *)ctx;  \
+        for (uint32_t i = 0; i < count; i++)                          \
+            q##_push(&c->field, &c->v[0]);                            \
+        for (uint32_t i = 0; i < count; i++)                          \
+            q##_pop(&c->field, &c->v[0]);                             \
+    }                                                                 \
+    static void _bench_##q##_multi(void *ctx, uint32_t count)         \
+    {                                                                 \
+        struct bench_qtyped_ctx *c = (struct bench_qtyped_ctx *)ctx;  \
+        for (uint32_t i = 0; i < count; i += 32)                      \
+        {                                                             \
+            q##_push_multi(&c->field, c->v, 32);                      \
+            q##_pop_multi(&c->field, c->v, 32);                       \
+        }                                                             \
+    }
+
+BENCH_QTYPED_OPS(bench_q4, q4, v4)
+BENCH_QTYPED_OPS(bench_q16, q16, v16)
+BENCH_QTYPED_OPS(bench_q256, q256, v256)
+
+/* ͬһԪشСͨtk_queueɴĶԱ */
+static void _bench_qtyped_compare(struct bench_qtyped_ctx *c, const char *size, uint16_t queue_size,
+                                  void (*push_pop)(void *ctx),
+                                  void (*fill_drain)(void *ctx, uint32_t count),
+                                  void (*multi)(void *ctx, uint32_t count))
+{
+    char name[64];
+    c->queue = tk_queue_create(queue_size, BENCH_QTYPED_DEPTH, false);
+    snprintf(name, sizeof(name), "queue.generic.push_pop.%s", size);
+    bench_latency(name, _bench_qtyped_push_pop, c);
+    snprintf(name, sizeof(name), "queue.typed.push_pop.%s", size);
+    bench_latency(name, push_pop, c);
+    snprintf(name, sizeof(name), "queue.generic.fill_drain.%s", size);
+    bench_throughput(name, _bench_qtyped_fill_drain, c, BENCH_QTYPED_DEPTH);
+    snprintf(name, sizeof(name), "queue.typed.fill_drain.%s", size);
+    bench_throughput(name, fill_drain, c, BENCH_QTYPED_DEPTH);
+    snprintf(name, sizeof(name), "queue.generic.multi32.%s", size);
+    bench_throughput(name, _bench_qtyped_multi, c, BENCH_QTYPED_DEPTH);
+    snprintf(name, sizeof(name), "queue.typed.multi32.%s", size);
+    bench_throughput(name, multi, c, BENCH_QTYPED_DEPTH);
+    tk_queue_delete(c->queue);
+}
+
+void bench_queue_typed(void)
+{
+    static struct bench_qtyped_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    bench_q4_init(&ctx.q4, false);
+    bench_q16_init(&ctx.q16, false);
+    bench_q256_init(&ctx.q256, false);
+
+    _bench_qtyped_compare(&ctx, "4B", sizeof(uint32_t),
+                          _bench_bench_q4_push_pop, _bench_bench_q4_fill_drain, _bench_bench_q4_multi);
+    _bench_qtyped_compare(&ctx, "16B", sizeof(struct bench_qtyped_rec16),
+                          _bench_bench_q16_push_pop, _bench_bench_q16_fill_drain, _bench_bench_q16_multi);
+    _bench_qtyped_compare(&ctx, "256B", sizeof(struct bench_qtyped_rec256),
+                          _bench_bench_q256_push_pop, _bench_bench_q256_fill_drain, _bench_bench_q256_multi);
+}
@@ -0,0 +1,127 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <sched.h>
+#include <unistd.h>
+#include "bench.h"
+
+static uint32_t bench_runtime_remaining = 0;
+
+/* ÿȼ1 */
+static void _bench_runtime_fork(void *arg)
+{
+    uintptr_t depth = (uintptr_t)arg;
+    if (depth > 0)
+    {
+        tk_spawn(_bench_runtime_fork, (void *)(depth - 1));
+        tk_spawn(_bench_runtime_fork, (void *)(depth - 1));
+    }
+    __atomic_fetch_sub(&bench_runtime_remaining, 1, __ATOMIC_RELEASE);
+}
+
+static void _bench_runtime_leaf(void *arg)
+{
+    (void)arg;
+    __atomic_fetch_sub(&bench_runtime_remaining, 1, __ATOMIC_RELEASE);
+}
+
+static void _bench_runtime_join(void)
+{
+    while (__atomic_load_n(&bench_runtime_remaining, __ATOMIC_ACQUIRE) != 0)
+        usleep(50);
+}
+
+/**
+ * @brief fork-join£߳໥ȡ
+ * 
+ * @param workers ̸߳
+ * @param depth ȣΪ2^(depth+1)-1
+ */
+static void _bench_runtime_fork_join(uint16_t workers, uint8_t depth)
+{
+    char name[64];
+    struct tk_runtime *runtime;
+    uint32_t total = (1u << (depth + 1)) - 1;
+    snprintf(name, sizeof(name), "runtime.fork_join.w%u", workers);
+    if (bench_enabled(name) == false)
+        return;
+    runtime = tk_runtime_create(workers, NULL);
+    if (runtime == NULL)
+        return;
+    /* Ԥȣȫ߳ */
+    bench_runtime_remaining = total;
+    tk_runtime_submit(runtime, 0, _bench_runtime_fork, (void *)(uintptr_t)depth);
+    _bench_runtime_join();
+    bench_runtime_remaining = total;
+    uint64_t begin = bench_now_ns();
+    tk_runtime_submit(runtime, 0, _bench_runtime_fork, (void *)(uintptr_t)depth);
+    _bench_runtime_join();
+    uint64_t ns = bench_now_ns() - begin;
+    bench_report_value(name, "tasks/s", (double)total * 1e9 / (double)ns);
+    tk_runtime_delete(runtime);
+}
+
+/**
+ * @brief ⲿ߳߳ύ£Ϣݿ
+ * 
+ * @param workers ̸߳
+ * @param num ύ
+ */
+static void _bench_runtime_submit(uint16_t workers, uint32_t num)
+{
+    char name[64];
+    struct tk_runtime *runtime;
+    snprintf(name, sizeof(name), "runtime.submit.w%u", workers);
+    if (bench_enabled(name) == false)
+        return;
+    runtime = tk_runtime_create(workers, NULL);
+    if (runtime == NULL)
+        return;
+    bench_runtime_remaining = num;
+    uint64_t begin = bench_now_ns();
+    for (uint32_t i = 0; i < num; i++)
+    {
+        while (tk_runtime_submit(runtime, i % workers, _bench_runtime_leaf, NULL) == false)
+            sched_yield();
+    }
+    _bench_runtime_join();
+    uint64_t ns = bench_now_ns() - begin;
+    bench_report_value(name, "tasks/s", (double)num * 1e9 / (double)ns);
+    tk_runtime_delete(runtime);
+}
+
+void bench_runtime(void)
+{
+    uint8_t depth = bench_opts.quick ? 14 : 18;
+    uint32_t num = bench_opts.quick ? 100000 : 1000000;
+    for (uint16_t workers = 1; workers <= bench_opts.threads; workers *= 2)
+    {
+        _bench_runtime_fork_join(workers, depth);
+        _bench_runtime_submit(workers, num);
+    }
+}
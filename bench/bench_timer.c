@@ -0,0 +1,875 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add timer table scan comparison
+* 2026-10-19     zhangran     compare scalar/sse2/avx2 table scans
+* 2026-10-19     zhangran     add virtual clock simulation benchmark
+* 2026-10-19     zhangran     compare per-timer and batch expiry callbacks
+* 2026-10-19     zhangran     add mass disconnect benchmark for timer groups
+* 2026-10-19     zhangran     add churn and cross-thread delete benchmarks
+* 2026-10-19     zhangran     measure trace overhead in process
+*/
+
+#include <pthread.h>
+#include <unistd.h>
+#include "bench.h"
+
+struct bench_timer_ctx
+{
+    struct tk_timer *timers;
+    uint32_t num;
+    uint64_t fired;
+};
+
+struct bench_timer_accuracy
+{
+    uint32_t deadline;
+    uint32_t fired;
+    double *lateness;
+};
+
+static struct bench_timer_ctx *bench_timer_curr = NULL;
+static struct bench_timer_accuracy bench_timer_accuracy;
+
+static void _bench_timer_callback(struct tk_timer *timer)
+{
+    (void)timer;
+    bench_timer_curr->fired++;
+}
+
+/* ֹͣ */
+static void _bench_timer_start_stop(void *ctx)
+{
+    struct bench_timer_ctx *c = (struct bench_timer_ctx *)ctx;
+    tk_timer_start(&c->timers[0], TIMER_MODE_SINGLE, 1000);
+    tk_timer_stop(&c->timers[0]);
+}
+
+/* ûжʱʱֻб */
+static void _bench_timer_idle_handler(void *ctx)
+{
+    (void)ctx;
+    tk_timer_loop_handler();
+}
+
+/* ÿƽ1tickжʱʱ */
+static void _bench_timer_fire_all(void *ctx, uint32_t count)
+{
+    struct bench_timer_ctx *c = (struct bench_timer_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += c->num)
+    {
+        bench_tick_value++;
+        tk_timer_loop_handler();
+    }
+}
+
+/**
+ * @brief numʱͳƳʼ
+ * 
+ * @param ctx 
+ * @param num ʱ
+ * @return true ɹ
+ * @return false ڴ治
+ */
+static bool _bench_timer_setup(struct bench_timer_ctx *ctx, uint32_t num)
+{
+    char name[64];
+    ctx->timers = (struct tk_timer *)calloc(num, sizeof(struct tk_timer));
+    if (ctx->timers == NULL)
+        return false;
+    ctx->num = num;
+    ctx->fired = 0;
+    bench_timer_curr = ctx;
+    uint64_t begin = bench_now_ns();
+    for (uint32_t i = 0; i < num; i++)
+        tk_timer_init(&ctx->timers[i], _bench_timer_callback);
+    uint64_t ns = bench_now_ns() - begin;
+    snprintf(name, sizeof(name), "timer.init.n%u", num);
+    if (bench_enabled(name))
+        bench_report_value(name, "ns/timer", (double)ns / num);
+    return true;
+}
+
+static void _bench_timer_teardown(struct bench_timer_ctx *ctx)
+{
+    for (uint32_t i = 0; i < ctx->num; i++)
+        tk_timer_detach(&ctx->timers[i]);
+    free(ctx->timers);
+    ctx->timers = NULL;
+    ctx->num = 0;
+    bench_timer_curr = NULL;
+}
+
+/**
+ * @brief ʱtk_timer_loop_handlerӰ
+ * 
+ * @param num ʱ
+ */
+static void _bench_timer_scaling(uint32_t num)
+{
+    char name[64];
+    struct bench_timer_ctx ctx;
+    if (_bench_timer_setup(&ctx, num) == false)
+        return;
+    for (uint32_t i = 0; i < num; i++)
+        tk_timer_start(&ctx.timers[i], TIMER_MODE_LOOP, 1000000 + i);
+    snprintf(name, sizeof(name), "timer.loop_handler.idle.n%u", num);
+    bench_latency(name, _bench_timer_idle_handler, &ctx);
+    for (uint32_t i = 0; i < num; i++)
+        tk_timer_start(&ctx.timers[i], TIMER_MODE_LOOP, 1);
+    snprintf(name, sizeof(name), "timer.loop_handler.fire_all.n%u", num);
+    bench_throughput(name, _bench_timer_fire_all, &ctx, num < 1024 ? 1024 : num);
+    _bench_timer_teardown(&ctx);
+}
+
+/* ÿƽ1tickÿ32ʱ1ʱ */
+static void _bench_timer_scan_list(void *ctx, uint32_t count)
+{
+    struct bench_timer_ctx *c = (struct bench_timer_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += c->num)
+    {
+        bench_tick_value++;
+        tk_timer_loop_handler();
+    }
+}
+
+static void _bench_timer_table_callback(struct tk_timer_table *table, uint32_t id, void *user_data)
+{
+    (void)table;
+    (void)id;
+    (*(uint64_t *)user_data)++;
+}
+
+struct bench_timer_table_ctx
+{
+    struct tk_timer_table *table;
+    uint32_t num;
+    uint64_t fired;
+};
+
+static void _bench_timer_scan_table(void *ctx, uint32_t count)
+{
+    struct bench_timer_table_ctx *c = (struct bench_timer_table_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += c->num)
+    {
+        bench_tick_value++;
+        tk_timer_table_handler(c->table);
+    }
+}
+
+/* ûжʱʱÿֻ糬ʱʱ */
+static void _bench_timer_idle_table(void *ctx, uint32_t count)
+{
+    struct bench_timer_table_ctx *c = (struct bench_timer_table_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += c->num)
+        tk_timer_table_handler(c->table);
+}
+
+static void _bench_timer_table_fire_all(void *ctx, uint32_t count)
+{
+    struct bench_timer_table_ctx *c = (struct bench_timer_table_ctx *)ctx;
+    for (uint32_t i = 0; i < count; i += c->num)
+    {
+        bench_tick_value++;
+        tk_timer_table_handler(c->table);
+    }
+}
+
+/**
+ * @brief ʱʱ붨ʱı(λns/ʱ)
+ * ֱڴ˳ʹ˳룬ģⳤкɢڶеĶʱ
+ * ÿ32ʱ1ÿtickʱʹʱÿһ鶼Ҫɨ
+ * 
+ * @param num ʱ
+ */
+static void _bench_timer_table_scan(uint32_t num)
+{
+    char name[64];
+    struct bench_timer_ctx ctx;
+    struct bench_timer_table_ctx table_ctx;
+    uint32_t *order;
+
+    ctx.timers = (struct tk_timer *)calloc(num, sizeof(struct tk_timer));
+    order = (uint32_t *)malloc(num * sizeof(uint32_t));
+    if (ctx.timers == NULL || order == NULL)
+    {
+        free(ctx.timers);
+        free(order);
+        return;
+    }
+    ctx.num = num;
+    ctx.fired = 0;
+    bench_timer_curr = &ctx;
+    for (uint32_t i = 0; i < num; i++)
+        order[i] = i;
+    for (uint8_t shuffled = 0; shuffled < 2; shuffled++)
+    {
+        if (shuffled)
+        {
+            srand(1);
+            for (uint32_t i = num - 1; i > 0; i--)
+            {
+                uint32_t j = (uint32_t)(((uint64_t)rand() * RAND_MAX + rand()) % (i + 1));
+                uint32_t t = order[i];
+                order[i] = order[j];
+                order[j] = t;
+            }
+        }
+        for (uint32_t i = 0; i < num; i++)
+        {
+            tk_timer_init(&ctx.timers[order[i]], _bench_timer_callback);
+            tk_timer_start(&ctx.timers[order[i]], TIMER_MODE_LOOP, order[i] % 32 == 0 ? 1 : 1000000 + order[i]);
+        }
+        snprintf(name, sizeof(name), shuffled ? "timer.scan.list_shuffled.n%u" : "timer.scan.list.n%u", num);
+        bench_throughput(name, _bench_timer_scan_list, &ctx, num);
+        for (uint32_t i = 0; i < num; i++)
+            tk_timer_detach(&ctx.timers[i]);
+    }
+    free(order);
+    free(ctx.timers);
+    bench_timer_curr = NULL;
+
+    table_ctx.table = tk_timer_table_create(num);
+    if (table_ctx.table == NULL)
+        return;
+    table_ctx.num = num;
+    table_ctx.fired = 0;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        uint32_t id = tk_timer_table_add(table_ctx.table, _bench_timer_table_callback, &table_ctx.fired);
+        tk_timer_table_start(table_ctx.table, id, TIMER_MODE_LOOP, 1000000 + i);
+    }
+    snprintf(name, sizeof(name), "timer.scan.table.idle.n%u", num);
+    bench_throughput(name, _bench_timer_idle_table, &table_ctx, num);
+    for (uint32_t i = 0; i < num; i += 32)
+        tk_timer_table_start(table_ctx.table, i, TIMER_MODE_LOOP, 1);
+    for (uint8_t isa = TK_TIMER_SCAN_SCALAR; isa <= TK_TIMER_SCAN_AVX2; isa++)
+    {
+        static const char *isa_names[] = {"scalar", "sse2", "avx2"};
+        if (tk_timer_table_set_scan((tk_timer_scan_isa)isa) == false)
+            continue;
+        snprintf(name, sizeof(name), "timer.scan.table.%s.n%u", isa_names[isa], num);
+        bench_throughput(name, _bench_timer_scan_table, &table_ctx, num);
+    }
+    /* ָcpuidѡĬʵ */
+    if (tk_timer_table_set_scan(TK_TIMER_SCAN_AVX2) == false && tk_timer_table_set_scan(TK_TIMER_SCAN_SSE2) == false)
+        tk_timer_table_set_scan(TK_TIMER_SCAN_SCALAR);
+    for (uint32_t i = 0; i < num; i++)
+        tk_timer_table_start(table_ctx.table, i, TIMER_MODE_LOOP, 1);
+    snprintf(name, sizeof(name), "timer.table.fire_all.n%u", num);
+    bench_throughput(name, _bench_timer_table_fire_all, &table_ctx, num);
+    tk_timer_table_delete(table_ctx.table);
+}
+
+#define BENCH_TIMER_SIM_DAY ((uint64_t)86400 * TK_TIMER_TICK_PER_SECOND)
+
+/* Ϊ1Сʱ24Сʱʹͬ */
+static uint32_t _bench_timer_sim_period(uint32_t *seed)
+{
+    *seed = *seed * 1103515245u + 12345u;
+    return (3600 + (*seed >> 8) % (86400 - 3600)) * TK_TIMER_TICK_PER_SECOND;
+}
+
+/**
+ * @brief ʱtickstickٶ
+ * 
+ * @param name ǰ׺NULLΪ
+ * @param ticks tick
+ * @param result 
+ */
+static void _bench_timer_sim_run(const char *name, uint64_t ticks, struct tk_timer_sim_result *result)
+{
+    char full[64];
+    uint64_t begin = bench_now_ns();
+    tk_timer_sim_run(ticks);
+    uint64_t ns = bench_now_ns() - begin;
+    tk_timer_sim_get_result(result);
+    if (name == NULL)
+        return;
+    snprintf(full, sizeof(full), "%s.ticks_per_s", name);
+    bench_report_value(full, "ticks/s", (double)ticks * 1e9 / (double)ns);
+    snprintf(full, sizeof(full), "%s.wall", name);
+    bench_report_value(full, "ms", (double)ns / 1e6);
+    snprintf(full, sizeof(full), "%s.per_expiry", name);
+    bench_report_value(full, "ns", result->expired != 0 ? (double)ns / (double)result->expired : 0);
+    snprintf(full, sizeof(full), "%s.late", name);
+    bench_report_value(full, "expiries", (double)result->late);
+}
+
+/**
+ * @brief ʱ1죬ʼtickλǰ
+ * 
+ * @param num ʱ
+ * @param ticks tick
+ * @param result 
+ * @return true 
+ * @return false ѹ˻ڴ治
+ */
+static bool _bench_timer_sim_table(uint32_t num, uint64_t ticks, struct tk_timer_sim_result *result)
+{
+    char name[64];
+    struct tk_timer_table *table;
+    uint64_t fired = 0;
+    uint32_t seed = 1;
+    snprintf(name, sizeof(name), "timer.sim.table.n%u.d%u", num, (uint32_t)(ticks / BENCH_TIMER_SIM_DAY));
+    if (bench_enabled(name) == false || (table = tk_timer_table_create(num)) == NULL)
+        return false;
+    tk_timer_sim_begin(UINT32_MAX - (uint32_t)(BENCH_TIMER_SIM_DAY / 2));
+    tk_timer_sim_add_table(table);
+    for (uint32_t i = 0; i < num; i++)
+    {
+        uint32_t id = tk_timer_table_add(table, _bench_timer_table_callback, &fired);
+        tk_timer_table_start(table, id, TIMER_MODE_LOOP, _bench_timer_sim_period(&seed));
+    }
+    _bench_timer_sim_run(name, ticks, result);
+    tk_timer_sim_end();
+    tk_timer_table_delete(table);
+    return true;
+}
+
+/**
+ * @brief ʱ1죬ͬһαȽϳʱժҪ
+ * 
+ * @param num ʱ
+ */
+static void _bench_timer_sim_list(uint32_t num)
+{
+    char name[64];
+    struct bench_timer_ctx ctx;
+    struct tk_timer_sim_result result[2];
+    snprintf(name, sizeof(name), "timer.sim.list.n%u.d1", num);
+    if (bench_enabled(name) == false)
+        return;
+    for (uint8_t run = 0; run < 2; run++)
+    {
+        uint32_t seed = 1;
+        if (_bench_timer_setup(&ctx, num) == false)
+            return;
+        tk_timer_sim_begin(UINT32_MAX - (uint32_t)(BENCH_TIMER_SIM_DAY / 2));
+        for (uint32_t i = 0; i < num; i++)
+            tk_timer_start(&ctx.timers[i], TIMER_MODE_LOOP, _bench_timer_sim_period(&seed));
+        _bench_timer_sim_run(run == 0 ? name : NULL, BENCH_TIMER_SIM_DAY, &result[run]);
+        tk_timer_sim_end();
+        _bench_timer_teardown(&ctx);
+    }
+    bench_report_value("timer.sim.deterministic", "bool",
+                       result[0].digest == result[1].digest && result[0].expired == result[1].expired);
+}
+
+/**
+ * @brief ʱӲԣʱ1죬Լʱ泬2^32tick֤tick
+ */
+static void _bench_timer_sim(void)
+{
+    struct tk_timer_sim_result result;
+    _bench_timer_sim_table(bench_opts.quick ? 100000 : 1000000, BENCH_TIMER_SIM_DAY, &result);
+    _bench_timer_sim_list(bench_opts.quick ? 1000 : 10000);
+    /* 50쳬2^32tick(1000HzʱԼ49.7)tickһ */
+    if (_bench_timer_sim_table(1000, BENCH_TIMER_SIM_DAY * 50, &result))
+        bench_report_value("timer.sim.wrap.time", "ticks", (double)result.time);
+}
+
+/* صļÿθ¶Ҫ */
+static pthread_mutex_t bench_timer_batch_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void _bench_timer_locked_callback(struct tk_timer *timer)
+{
+    pthread_mutex_lock(&bench_timer_batch_lock);
+    (*(uint64_t *)timer->user_data)++;
+    pthread_mutex_unlock(&bench_timer_batch_lock);
+}
+
+static void _bench_timer_batch_callback(struct tk_timer **timers, uint32_t num)
+{
+    pthread_mutex_lock(&bench_timer_batch_lock);
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (i + 4 < num)
+            __builtin_prefetch(timers[i + 4]->user_data, 1);
+        (*(uint64_t *)timers[i]->user_data)++;
+    }
+    pthread_mutex_unlock(&bench_timer_batch_lock);
+}
+
+/* ʱصɾµĶʱʱֲ */
+struct bench_timer_churn
+{
+    uint32_t seed;
+    uint64_t fired;
+    struct tk_timer_group *group; /* жʱԽɾ */
+    struct tk_timer **dead;       /* صֹֻͣɾ */
+    uint32_t dead_num;
+};
+
+static struct bench_timer_churn bench_timer_churn;
+
+static void _bench_timer_churn_spawn(void (*callback)(struct tk_timer *timer))
+{
+    struct tk_timer *timer = tk_timer_create(callback);
+    bench_timer_churn.seed = bench_timer_churn.seed * 1103515245u + 12345u;
+    tk_timer_group_add(bench_timer_churn.group, timer);
+    tk_timer_start(timer, TIMER_MODE_SINGLE, 1 + (bench_timer_churn.seed >> 16) % 8);
+}
+
+static void _bench_timer_churn_inline(struct tk_timer *timer)
+{
+    bench_timer_churn.fired++;
+    tk_timer_delete(timer);
+    _bench_timer_churn_spawn(_bench_timer_churn_inline);
+}
+
+static void _bench_timer_churn_deferred(struct tk_timer *timer)
+{
+    bench_timer_churn.fired++;
+    tk_timer_stop(timer);
+    bench_timer_churn.dead[bench_timer_churn.dead_num++] = timer;
+    _bench_timer_churn_spawn(_bench_timer_churn_deferred);
+}
+
+/* ƽtickֱʱcountΣÿִɾصм¼Ķʱ */
+static void _bench_timer_churn_run(void *ctx, uint32_t count)
+{
+    (void)ctx;
+    uint64_t target = bench_timer_churn.fired + count;
+    while (bench_timer_churn.fired < target)
+    {
+        bench_tick_value++;
+        tk_timer_loop_handler();
+        for (uint32_t i = 0; i < bench_timer_churn.dead_num; i++)
+            tk_timer_delete(bench_timer_churn.dead[i]);
+        bench_timer_churn.dead_num = 0;
+    }
+}
+
+/* ɾʱ鲢ִдֱڶʱȫͷ */
+static void _bench_timer_group_drain(struct tk_timer_group *group)
+{
+    uint32_t next_tick;
+    tk_timer_group_delete(group);
+    while (tk_timer_get_next_tick(&next_tick) && next_tick - bench_tick_value <= 1)
+    {
+        bench_tick_value++;
+        tk_timer_loop_handler();
+    }
+}
+
+/**
+ * @brief numʱʱÿγʱɾµĶʱԱȻصֱɾ(inline)
+ * صֹֻͣɾ(deferred)ÿγʱ
+ * 
+ * @param num ʱ
+ */
+static void _bench_timer_churn(uint32_t num)
+{
+    char name[64];
+    void (*callbacks[2])(struct tk_timer *timer) = {_bench_timer_churn_inline, _bench_timer_churn_deferred};
+    const char *names[2] = {"inline", "deferred"};
+    if ((bench_timer_churn.dead = (struct tk_timer **)calloc(num, sizeof(struct tk_timer *))) == NULL)
+        return;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        snprintf(name, sizeof(name), "timer.churn.%s.n%u", names[i], num);
+        if (bench_enabled(name) == false || (bench_timer_churn.group = tk_timer_group_create()) == NULL)
+            continue;
+        bench_timer_churn.seed = 1;
+        for (uint32_t j = 0; j < num; j++)
+            _bench_timer_churn_spawn(callbacks[i]);
+        bench_throughput(name, _bench_timer_churn_run, NULL, num * 4);
+        _bench_timer_group_drain(bench_timer_churn.group);
+    }
+    free(bench_timer_churn.dead);
+    bench_timer_churn.dead = NULL;
+}
+
+struct bench_timer_remote
+{
+    struct tk_timer **timers;
+    uint32_t num;
+    uint64_t ns;
+};
+
+static void *_bench_timer_remote_entry(void *arg)
+{
+    struct bench_timer_remote *remote = (struct bench_timer_remote *)arg;
+    uint64_t begin = bench_now_ns();
+    for (uint32_t i = 0; i < remote->num; i++)
+        tk_timer_delete(remote->timers[i]);
+    remote->ns = bench_now_ns() - begin;
+    return NULL;
+}
+
+/**
+ * @brief ߳ɾnumеĶʱÿɾԼ߳һִͷŵÿʱ
+ * 
+ * @param num ʱ
+ */
+static void _bench_timer_remote_delete(uint32_t num)
+{
+    char name[64];
+    pthread_t thread;
+    struct bench_timer_remote remote = {NULL, num, 0};
+    struct bench_timer_ctx ctx = {NULL, 0, 0};
+    snprintf(name, sizeof(name), "timer.delete.remote.n%u", num);
+    if (bench_enabled(name) == false)
+        return;
+    if ((remote.timers = (struct tk_timer **)calloc(num, sizeof(struct tk_timer *))) == NULL)
+        return;
+    bench_timer_curr = &ctx;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        remote.timers[i] = tk_timer_create(_bench_timer_callback);
+        tk_timer_start(remote.timers[i], TIMER_MODE_LOOP, 1000 + i % 1000);
+    }
+    if (pthread_create(&thread, NULL, _bench_timer_remote_entry, &remote) == 0)
+    {
+        pthread_join(thread, NULL);
+        bench_report_value(name, "ns/timer", (double)remote.ns / num);
+        uint64_t begin = bench_now_ns();
+        tk_timer_loop_handler();
+        uint64_t ns = bench_now_ns() - begin;
+        snprintf(name, sizeof(name), "timer.delete.remote.n%u.reclaim", num);
+        bench_report_value(name, "ns/timer", (double)ns / num);
+    }
+    bench_timer_curr = NULL;
+    free(remote.timers);
+}
+
+/**
+ * @brief ͬһִnumʱͬʱʱԱصصÿγʱ
+ * ص·ɢڶеļصÿֻһβԤȡuser_data
+ * 
+ * @param num ͬʱʱĶʱ
+ */
+static void _bench_timer_batch(uint32_t num)
+{
+    char name[64];
+    struct bench_timer_ctx ctx;
+    uint64_t **counters;
+    if (_bench_timer_setup(&ctx, num) == false)
+        return;
+    if ((counters = (uint64_t **)calloc(num, sizeof(uint64_t *))) == NULL)
+    {
+        _bench_timer_teardown(&ctx);
+        return;
+    }
+    for (uint32_t i = 0; i < num; i++)
+    {
+        counters[i] = (uint64_t *)calloc(1, 64);
+        ctx.timers[i].user_data = counters[i];
+        ctx.timers[i].timeout_callback = _bench_timer_locked_callback;
+        tk_timer_start(&ctx.timers[i], TIMER_MODE_LOOP, 1);
+    }
+    snprintf(name, sizeof(name), "timer.expire.callback.n%u", num);
+    bench_throughput(name, _bench_timer_fire_all, &ctx, num < 1024 ? 1024 : num);
+    for (uint32_t i = 0; i < num; i++)
+        tk_timer_set_batch_callback(&ctx.timers[i], _bench_timer_batch_callback);
+    snprintf(name, sizeof(name), "timer.expire.batch.n%u", num);
+    bench_throughput(name, _bench_timer_fire_all, &ctx, num < 1024 ? 1024 : num);
+    _bench_timer_teardown(&ctx);
+    for (uint32_t i = 0; i < num; i++)
+        free(counters[i]);
+    free(counters);
+}
+
+#define BENCH_TIMER_SESSION_TIMERS 8
+
+/**
+ * @brief sessionsỰÿỰBENCH_TIMER_SESSION_TIMERSеĶʱ(ڲ)
+ * 
+ * @param timers ʱ飬sessions*BENCH_TIMER_SESSION_TIMERS
+ * @param groups ʱ飬NULLΪʹöʱ
+ * @param sessions Ự
+ */
+static void _bench_timer_session_create(struct tk_timer **timers, struct tk_timer_group **groups, uint32_t sessions)
+{
+    for (uint32_t i = 0; i < sessions; i++)
+    {
+        if (groups != NULL)
+            groups[i] = tk_timer_group_create();
+        for (uint32_t j = 0; j < BENCH_TIMER_SESSION_TIMERS; j++)
+        {
+            struct tk_timer *timer = tk_timer_create(_bench_timer_callback);
+            timers[i * BENCH_TIMER_SESSION_TIMERS + j] = timer;
+            if (groups != NULL)
+                tk_timer_group_add(groups[i], timer);
+            tk_timer_start(timer, TIMER_MODE_LOOP, 60000 + (i + j * 7919) % 60000);
+        }
+    }
+}
+
+/**
+ * @brief лỰͬʱϿԱɾʱɾʱĿ
+ * ɾʱϿȫͷţʱɾΪO(1)
+ * ͷŷ̯֮tk_timer_loop_handlerУÿTK_TIMER_RECLAIM_BATCH
+ * 
+ * @param sessions Ự
+ */
+static void _bench_timer_disconnect(uint32_t sessions)
+{
+    char name[64];
+    struct bench_timer_ctx ctx = {NULL, 0, 0};
+    uint32_t num = sessions * BENCH_TIMER_SESSION_TIMERS;
+    struct tk_timer **timers = (struct tk_timer **)calloc(num, sizeof(struct tk_timer *));
+    struct tk_timer_group **groups = (struct tk_timer_group **)calloc(sessions, sizeof(struct tk_timer_group *));
+    uint32_t next_tick;
+
+    bench_timer_curr = &ctx;
+    snprintf(name, sizeof(name), "timer.disconnect.each.s%u", sessions);
+    if (timers != NULL && bench_enabled(name))
+    {
+        _bench_timer_session_create(timers, NULL, sessions);
+        uint64_t begin = bench_now_ns();
+        for (uint32_t i = 0; i < num; i++)
+            tk_timer_delete(timers[i]);
+        uint64_t ns = bench_now_ns() - begin;
+        bench_report_value(name, "ns/session", (double)ns / sessions);
+        snprintf(name, sizeof(name), "timer.disconnect.each.s%u.stall", sessions);
+        bench_report_value(name, "ms", (double)ns / 1e6);
+    }
+    snprintf(name, sizeof(name), "timer.disconnect.group.s%u", sessions);
+    if (timers != NULL && groups != NULL && bench_enabled(name))
+    {
+        _bench_timer_session_create(timers, groups, sessions);
+        uint64_t begin = bench_now_ns();
+        for (uint32_t i = 0; i < sessions; i++)
+            tk_timer_group_delete(groups[i]);
+        uint64_t ns = bench_now_ns() - begin;
+        bench_report_value(name, "ns/session", (double)ns / sessions);
+        snprintf(name, sizeof(name), "timer.disconnect.group.s%u.stall", sessions);
+        bench_report_value(name, "ms", (double)ns / 1e6);
+
+        /* ÿtickһֱ֣ȫͷ */
+        uint64_t total = 0;
+        uint64_t pass_max = 0;
+        uint32_t passes = 0;
+        while (tk_timer_get_next_tick(&next_tick) && next_tick - bench_tick_value <= 1)
+        {
+            bench_tick_value++;
+            begin = bench_now_ns();
+            tk_timer_loop_handler();
+            ns = bench_now_ns() - begin;
+            total += ns;
+            pass_max = ns > pass_max ? ns : pass_max;
+            passes++;
+        }
+        snprintf(name, sizeof(name), "timer.disconnect.group.s%u.pass_max", sessions);
+        bench_report_value(name, "ms", (double)pass_max / 1e6);
+        snprintf(name, sizeof(name), "timer.disconnect.group.s%u.reclaim", sessions);
+        bench_report_value(name, "ms", (double)total / 1e6);
+        snprintf(name, sizeof(name), "timer.disconnect.group.s%u.passes", sessions);
+        bench_report_value(name, "passes", passes);
+    }
+    bench_timer_curr = NULL;
+    free(groups);
+    free(timers);
+}
+
+static void _bench_timer_accuracy_callback(struct tk_timer *timer)
+{
+    uint64_t now = bench_now_ns();
+    uint32_t diff = (uint32_t)(now / 1000000ULL) - bench_timer_accuracy.deadline;
+    (void)timer;
+    bench_timer_accuracy.lateness[bench_timer_accuracy.fired++] =
+        (double)diff * 1e6 + (double)(now % 1000000ULL);
+}
+
+/**
+ * @brief 1msڶʱĴCPUռãԱtimerfd1msѯ
+ * 
+ * @param use_fd trueʹtk_timer_fd_wait; falseʹusleep(1000)ѯtk_timer_loop_handler
+ */
+static void _bench_timer_accuracy(bool use_fd)
+{
+    char name[64];
+    struct tk_timer timer;
+    uint32_t num = bench_opts.quick ? 50 : 500;
+    uint32_t wakeups = 0;
+    const char *mode = use_fd ? "timerfd" : "poll1ms";
+    snprintf(name, sizeof(name), "timer.%s.lateness", mode);
+    if (bench_enabled(name) == false)
+        return;
+    bench_timer_accuracy.lateness = (double *)malloc(num * sizeof(double));
+    if (bench_timer_accuracy.lateness == NULL)
+        return;
+    bench_timer_accuracy.fired = 0;
+    bench_tick_real = true;
+    tk_timer_init(&timer, _bench_timer_accuracy_callback);
+    tk_timer_start(&timer, TIMER_MODE_LOOP, 1);
+    uint64_t cpu_begin = bench_thread_cpu_ns();
+    uint64_t begin = bench_now_ns();
+    while (bench_timer_accuracy.fired < num)
+    {
+        bench_timer_accuracy.deadline = timer.timer_tick_timeout;
+        if (use_fd)
+        {
+            if (tk_timer_fd_wait(-1) == false)
+                break;
+        }
+        else
+        {
+            usleep(1000);
+            tk_timer_loop_handler();
+        }
+        wakeups++;
+    }
+    uint64_t ns = bench_now_ns() - begin;
+    uint64_t cpu = bench_thread_cpu_ns() - cpu_begin;
+    tk_timer_detach(&timer);
+    if (use_fd)
+        tk_timer_release_fd();
+    bench_tick_real = false;
+    bench_report_samples(name, bench_timer_accuracy.lateness, bench_timer_accuracy.fired,
+                         bench_timer_accuracy.fired, 0);
+    snprintf(name, sizeof(name), "timer.%s.cpu", mode);
+    bench_report_value(name, "us/s", (double)cpu * 1e6 / (double)ns);
+    snprintf(name, sizeof(name), "timer.%s.wakeups_per_fire", mode);
+    bench_report_value(name, "wakeups", (double)wakeups / bench_timer_accuracy.fired);
+    free(bench_timer_accuracy.lateness);
+}
+
+static uint32_t bench_timer_sparse_fired;
+
+static void _bench_timer_sparse_callback(struct tk_timer *timer)
+{
+    (void)timer;
+    bench_timer_sparse_fired++;
+}
+
+/**
+ * @brief ϡ趨ʱ(һ100msڶʱ)½̿ʱCPUռãԱtimerfd1msѯ
+ * 
+ * @param use_fd trueʹtk_timer_fd_wait; falseʹusleep(1000)ѯtk_timer_loop_handler
+ */
+static void _bench_timer_sparse(bool use_fd)
+{
+    char name[64];
+    struct tk_timer timer;
+    uint32_t num = bench_opts.quick ? 5 : 20;
+    uint32_t wakeups = 0;
+    const char *mode = use_fd ? "timerfd" : "poll1ms";
+    snprintf(name, sizeof(name), "timer.sparse.%s.cpu", mode);
+    if (bench_enabled(name) == false)
+        return;
+    bench_timer_sparse_fired = 0;
+    bench_tick_real = true;
+    tk_timer_init(&timer, _bench_timer_sparse_callback);
+    tk_timer_start(&timer, TIMER_MODE_LOOP, 100);
+    uint64_t cpu_begin = bench_thread_cpu_ns();
+    uint64_t begin = bench_now_ns();
+    while (bench_timer_sparse_fired < num)
+    {
+        if (use_fd)
+        {
+            if (tk_timer_fd_wait(-1) == false)
+                break;
+        }
+        else
+        {
+            usleep(1000);
+            tk_timer_loop_handler();
+        }
+        wakeups++;
+    }
+    uint64_t ns = bench_now_ns() - begin;
+    uint64_t cpu = bench_thread_cpu_ns() - cpu_begin;
+    tk_timer_detach(&timer);
+    if (use_fd)
+        tk_timer_release_fd();
+    bench_tick_real = false;
+    bench_report_value(name, "us/s", (double)cpu * 1e6 / (double)ns);
+    snprintf(name, sizeof(name), "timer.sparse.%s.wakeups_per_fire", mode);
+    bench_report_value(name, "wakeups", (double)wakeups / (bench_timer_sparse_fired ? bench_timer_sparse_fired : 1));
+}
+
+#ifdef TK_TIMER_USING_TRACE
+/**
+ * @brief ͬһڽ򿪡ر׷٣Ƚnumʱͬʱʱÿγʱ
+ * ֮Ĳ쳣CPUƵƯûȡеСֵ׷ӵİٷֱ
+ * 
+ * @param num ͬʱʱĶʱ
+ */
+static void _bench_timer_trace_overhead(uint32_t num)
+{
+    const uint32_t rounds = bench_opts.quick ? 5 : 15;
+    const uint32_t count = 1u << 18;
+    double best[2] = {1e9, 1e9};
+    char name[64];
+    struct bench_timer_ctx ctx;
+    snprintf(name, sizeof(name), "timer.trace.overhead.n%u", num);
+    if (bench_enabled(name) == false || _bench_timer_setup(&ctx, num) == false)
+        return;
+    for (uint32_t i = 0; i < num; i++)
+        tk_timer_start(&ctx.timers[i], TIMER_MODE_LOOP, 1);
+    _bench_timer_fire_all(&ctx, count);
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        for (uint32_t k = 0; k < 2; k++)
+        {
+            tk_timer_trace_enable(k == 1);
+            uint64_t begin = bench_now_ns();
+            _bench_timer_fire_all(&ctx, count);
+            double ns = (double)(bench_now_ns() - begin) / count;
+            if (ns < best[k])
+                best[k] = ns;
+        }
+    }
+    tk_timer_trace_enable(true);
+    bench_report_value(name, "%", (best[1] - best[0]) * 100.0 / best[0]);
+    _bench_timer_teardown(&ctx);
+}
+#endif /* TK_TIMER_USING_TRACE */
+
+void bench_timer(void)
+{
+    struct bench_timer_ctx ctx;
+    uint32_t max = bench_opts.quick ? 4096 : 16384;
+
+    if (_bench_timer_setup(&ctx, 1))
+    {
+        bench_latency("timer.start_stop", _bench_timer_start_stop, &ctx);
+        _bench_timer_teardown(&ctx);
+    }
+    for (uint32_t num = 16; num <= max; num *= 4)
+        _bench_timer_scaling(num);
+    _bench_timer_batch(1);
+    _bench_timer_batch(100);
+    _bench_timer_batch(10000);
+    _bench_timer_disconnect(bench_opts.quick ? 10000 : 100000);
+    _bench_timer_churn(10000);
+    _bench_timer_remote_delete(bench_opts.quick ? 10000 : 100000);
+    for (uint32_t num = 10000; num <= (bench_opts.quick ? 100000u : 1000000u); num *= 10)
+        _bench_timer_table_scan(num);
+    _bench_timer_sim();
+    _bench_timer_accuracy(true);
+    _bench_timer_accuracy(false);
+    _bench_timer_sparse(true);
+    _bench_timer_sparse(false);
+#ifdef TK_TIMER_USING_TRACE
+    _bench_timer_trace_overhead(1);
+    _bench_timer_trace_overhead(16);
+    _bench_timer_trace_overhead(1024);
+#endif /* TK_TIMER_USING_TRACE */
+}
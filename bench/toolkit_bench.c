@@ -0,0 +1,600 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add timer trace variant
+* 2026-10-19     zhangran     add priority queue benchmark
+* 2026-10-19     zhangran     add queue journal benchmark
+* 2026-10-19     zhangran     add log benchmark
+* 2026-10-19     zhangran     add bus benchmark
+* 2026-10-19     zhangran     add typed queue benchmark
+* 2026-10-19     zhangran     add mailbox benchmark
+* 2026-10-19     zhangran     add buffer pool benchmark
+* 2026-10-19     zhangran     add pipeline benchmark
+*/
+
+/**
+ * ˵
+ *      toolkitܲڣJSON׼(--jsonָļ)Ϣ׼
+ *      ӳٲԤٲÿΪBENCH_BATCHβƽֵѿ۳ʱĿ
+ *      ÷toolkit_bench [--quick] [--filter ] [--iterations N] [--threads N] [--json ļ]
+ *                    [--journal-dir Ŀ¼] [--journal-mb N]
+ *      toolkit_bench_traceɶʹ --trace ļʱ׷ټ¼
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bench.h"
+
+struct bench_result
+{
+    char name[64];
+    char unit[16];
+    bool has_percentile;
+    uint64_t ops;
+    double value;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+    double max;
+};
+
+struct bench_opts bench_opts = {
+    .iterations = 100000,
+    .warmup = 10000,
+    .threads = 0,
+    .quick = false,
+    .filter = NULL,
+    .journal_dir = "/tmp/toolkit_bench_journal",
+    .journal_mb = 0,
+};
+
+uint32_t bench_tick_value = 0;
+bool bench_tick_real = false;
+
+static struct bench_result *bench_results = NULL;
+static uint32_t bench_result_num = 0;
+static uint32_t bench_result_max = 0;
+static double bench_cycles_per_ns = 1.0;
+static double bench_overhead_cycles = 0;
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} bench_groups[] = {
+    {"queue", bench_queue},
+    {"queue_typed", bench_queue_typed},
+    {"pqueue", bench_pqueue},
+    {"journal", bench_journal},
+    {"log", bench_log},
+    {"timer", bench_timer},
+    {"event", bench_event},
+    {"bus", bench_bus},
+    {"mailbox", bench_mailbox},
+    {"bufpool", bench_bufpool},
+    {"loop", bench_loop},
+    {"runtime", bench_runtime},
+    {"pipeline", bench_pipeline},
+    {"coroutine", bench_coroutine},
+    {"memory", bench_memory},
+};
+
+/**
+ * @brief ʱʱԿлΪֶƽʱʵĺʱ
+ * 
+ * @return uint32_t ǰʱ
+ */
+uint32_t bench_get_tick(void)
+{
+    if (bench_tick_real)
+        return tk_timer_fd_get_tick();
+    return bench_tick_value;
+}
+
+/**
+ * @brief ȡʱ
+ * 
+ * @return uint64_t 
+ */
+uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief ȡǰ߳ĵCPUʱ
+ * 
+ * @return uint64_t 
+ */
+uint64_t bench_thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief ʱλתΪ
+ * 
+ * @param cycles bench_cyclesĲֵ
+ * @return double 
+ */
+double bench_cycles_to_ns(uint64_t cycles)
+{
+    return (double)cycles / bench_cycles_per_ns;
+}
+
+/**
+ * @brief У׼bench_cyclesı(ڲ)
+ * 
+ */
+static void _bench_calibrate(void)
+{
+    uint64_t ns_begin = bench_now_ns();
+    uint64_t cycles_begin = bench_cycles();
+    while (bench_now_ns() - ns_begin < 50000000ULL)
+        ;
+    uint64_t ns_end = bench_now_ns();
+    uint64_t cycles_end = bench_cycles();
+    bench_cycles_per_ns = (double)(cycles_end - cycles_begin) / (double)(ns_end - ns_begin);
+    if (bench_cycles_per_ns <= 0)
+        bench_cycles_per_ns = 1.0;
+}
+
+#ifdef TK_TIMER_USING_TRACE
+/**
+ * @brief ʱ׷ʱ䣬bench_cycles1/1632λԼʮһ(ڲ)
+ * 
+ * @return uint32_t ׷ʱ
+ */
+static uint32_t _bench_trace_time(void)
+{
+    return (uint32_t)(bench_cycles() >> 4);
+}
+#endif /* TK_TIMER_USING_TRACE */
+
+/**
+ * @brief жϲǷҪ
+ * 
+ * @param name 
+ * @return true 
+ * @return false --filter
+ */
+bool bench_enabled(const char *name)
+{
+    if (bench_opts.filter == NULL)
+        return true;
+    return strstr(name, bench_opts.filter) != NULL;
+}
+
+/**
+ * @brief һ¼(ڲ)
+ * 
+ * @param name 
+ * @param unit λ
+ * @return struct bench_result* ¼NULLΪʧ
+ */
+static struct bench_result *_bench_result_new(const char *name, const char *unit)
+{
+    struct bench_result *result;
+    if (bench_result_num == bench_result_max)
+    {
+        uint32_t max = bench_result_max ? bench_result_max * 2 : 64;
+        result = (struct bench_result *)realloc(bench_results, max * sizeof(struct bench_result));
+        if (result == NULL)
+            return NULL;
+        bench_results = result;
+        bench_result_max = max;
+    }
+    result = &bench_results[bench_result_num++];
+    memset(result, 0, sizeof(struct bench_result));
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->unit, sizeof(result->unit), "%s", unit);
+    return result;
+}
+
+/**
+ * @brief ȽϺ(ڲ)
+ * 
+ */
+static int _bench_double_cmp(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief ȡٷλ(ڲ)
+ * 
+ */
+static double _bench_percentile(double *samples, uint32_t num, double percent)
+{
+    uint32_t index = (uint32_t)(percent / 100.0 * (double)(num - 1) + 0.5);
+    return samples[index < num ? index : num - 1];
+}
+
+/**
+ * @brief ¼һӳᱻ
+ * 
+ * @param name 
+ * @param samples ()
+ * @param num 
+ * @param ops ǵĲ
+ * @param total_ns ǵܺʱڼÿΪ0ʱֵ
+ * @return true ¼ɹ
+ * @return false ¼ʧ
+ */
+bool bench_report_samples(const char *name, double *samples, uint32_t num, uint64_t ops, uint64_t total_ns)
+{
+    struct bench_result *result;
+    double sum = 0;
+    if (samples == NULL || num == 0)
+        return false;
+    result = _bench_result_new(name, "ns");
+    if (result == NULL)
+        return false;
+    for (uint32_t i = 0; i < num; i++)
+        sum += samples[i];
+    qsort(samples, num, sizeof(double), _bench_double_cmp);
+    result->has_percentile = true;
+    result->ops = ops;
+    result->mean = sum / num;
+    result->p50 = _bench_percentile(samples, num, 50.0);
+    result->p90 = _bench_percentile(samples, num, 90.0);
+    result->p99 = _bench_percentile(samples, num, 99.0);
+    result->p999 = _bench_percentile(samples, num, 99.9);
+    result->max = samples[num - 1];
+    if (total_ns != 0)
+        result->value = (double)ops * 1e9 / (double)total_ns;
+    else if (result->mean > 0)
+        result->value = 1e9 / result->mean;
+    fprintf(stderr, "%-40s mean %10.1f  p50 %10.1f  p99 %10.1f  p999 %10.1f  max %12.1f ns  %14.0f ops/s\n",
+            result->name, result->mean, result->p50, result->p99, result->p999, result->max, result->value);
+    return true;
+}
+
+/**
+ * @brief ¼һָ
+ * 
+ * @param name 
+ * @param unit λ
+ * @param value ֵ
+ * @return true ¼ɹ
+ * @return false ¼ʧ
+ */
+bool bench_report_value(const char *name, const char *unit, double value)
+{
+    struct bench_result *result = _bench_result_new(name, unit);
+    if (result == NULL)
+        return false;
+    result->value = value;
+    fprintf(stderr, "%-40s %14.3f %s\n", result->name, value, unit);
+    return true;
+}
+
+/**
+ * @brief ղڲʱ(ڲ)
+ * 
+ */
+static void _bench_empty_op(void *ctx)
+{
+    __asm__ __volatile__("" : : "r"(ctx) : "memory");
+}
+
+/**
+ * @brief һĺʱ(ڲ)
+ * 
+ * @return uint64_t ʱ(bench_cyclesλ)
+ */
+static uint64_t _bench_sample(void (*op)(void *ctx), void *ctx)
+{
+    uint64_t begin = bench_cycles();
+    for (uint32_t i = 0; i < BENCH_BATCH; i++)
+        op(ctx);
+    return bench_cycles() - begin;
+}
+
+/**
+ * @brief ʱĿȡղλ(ڲ)
+ * 
+ */
+static void _bench_measure_overhead(void)
+{
+    uint32_t num = 10001;
+    double *samples = (double *)malloc(num * sizeof(double));
+    if (samples == NULL)
+        return;
+    for (uint32_t i = 0; i < num; i++)
+        samples[i] = (double)_bench_sample(_bench_empty_op, NULL);
+    qsort(samples, num, sizeof(double), _bench_double_cmp);
+    bench_overhead_cycles = samples[num / 2];
+    free(samples);
+}
+
+/**
+ * @brief βӳٲԣԤٲ
+ * 
+ * @param name 
+ * @param op ÿεִһα
+ * @param ctx 
+ * @return true 
+ * @return false ˻ڴ治
+ */
+bool bench_latency(const char *name, void (*op)(void *ctx), void *ctx)
+{
+    uint32_t num = bench_opts.iterations;
+    double *samples;
+    uint64_t begin, end;
+    if (bench_enabled(name) == false)
+        return false;
+    samples = (double *)malloc(num * sizeof(double));
+    if (samples == NULL)
+        return false;
+    for (uint32_t i = 0; i < bench_opts.warmup; i++)
+        _bench_sample(op, ctx);
+    begin = bench_now_ns();
+    for (uint32_t i = 0; i < num; i++)
+    {
+        double cycles = (double)_bench_sample(op, ctx) - bench_overhead_cycles;
+        if (cycles < 0)
+            cycles = 0;
+        samples[i] = cycles / bench_cycles_per_ns / BENCH_BATCH;
+    }
+    end = bench_now_ns();
+    bool result = bench_report_samples(name, samples, num, (uint64_t)num * BENCH_BATCH, end - begin);
+    free(samples);
+    return result;
+}
+
+/**
+ * @brief ²ԣԤһֺظ֣ÿΪһ
+ * 
+ * @param name 
+ * @param op ÿεִcountα
+ * @param ctx 
+ * @param count ÿֵĲ
+ * @return true 
+ * @return false ˻ڴ治
+ */
+bool bench_throughput(const char *name, void (*op)(void *ctx, uint32_t count), void *ctx, uint32_t count)
+{
+    uint32_t rounds = bench_opts.quick ? 5 : 20;
+    double samples[20];
+    uint64_t total = 0;
+    if (bench_enabled(name) == false || count == 0)
+        return false;
+    op(ctx, count);
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        uint64_t begin = bench_now_ns();
+        op(ctx, count);
+        uint64_t ns = bench_now_ns() - begin;
+        total += ns;
+        samples[i] = (double)ns / count;
+    }
+    return bench_report_samples(name, samples, rounds, (uint64_t)rounds * count, total);
+}
+
+/**
+ * @brief ȡۼƵĶдϵͳô
+ * 
+ * @param count ϵͳô
+ * @return true ȡɹ
+ * @return false ں˲֧/proc/self/io
+ */
+bool bench_syscalls(uint64_t *count)
+{
+    char line[64];
+    unsigned long long value;
+    uint64_t sum = 0;
+    uint8_t found = 0;
+    FILE *fp = fopen("/proc/self/io", "r");
+    if (fp == NULL)
+        return false;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (sscanf(line, "syscr: %llu", &value) == 1 || sscanf(line, "syscw: %llu", &value) == 1)
+        {
+            sum += value;
+            found++;
+        }
+    }
+    fclose(fp);
+    *count = sum;
+    return found == 2;
+}
+
+/**
+ * @brief JSONʽĽ(ڲ)
+ * 
+ */
+static void _bench_write_json(FILE *fp)
+{
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"toolkit_version\": \"%s\",\n", TK_SW_VERSION);
+#if defined(TOOLKIT_USING_STATS)
+    fprintf(fp, "  \"config\": \"stats\",\n");
+#elif defined(TK_TIMER_USING_TRACE)
+    fprintf(fp, "  \"config\": \"trace\",\n");
+#else
+    fprintf(fp, "  \"config\": \"default\",\n");
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    fprintf(fp, "  \"clock\": \"rdtsc\",\n");
+#else
+    fprintf(fp, "  \"clock\": \"clock_gettime\",\n");
+#endif
+    fprintf(fp, "  \"cycles_per_ns\": %.4f,\n", bench_cycles_per_ns);
+    fprintf(fp, "  \"overhead_ns\": %.2f,\n", bench_cycles_to_ns((uint64_t)bench_overhead_cycles));
+    fprintf(fp, "  \"batch\": %d,\n", BENCH_BATCH);
+    fprintf(fp, "  \"iterations\": %u,\n", bench_opts.iterations);
+    fprintf(fp, "  \"warmup\": %u,\n", bench_opts.warmup);
+    fprintf(fp, "  \"threads\": %u,\n", bench_opts.threads);
+    fprintf(fp, "  \"results\": [");
+    for (uint32_t i = 0; i < bench_result_num; i++)
+    {
+        struct bench_result *r = &bench_results[i];
+        fprintf(fp, "%s\n    {\"name\": \"%s\", \"unit\": \"%s\"", i ? "," : "", r->name, r->unit);
+        if (r->has_percentile)
+        {
+            fprintf(fp, ", \"ops\": %llu, \"mean\": %.2f, \"p50\": %.2f, \"p90\": %.2f, \"p99\": %.2f, "
+                        "\"p999\": %.2f, \"max\": %.2f, \"ops_per_sec\": %.0f}",
+                    (unsigned long long)r->ops, r->mean, r->p50, r->p90, r->p99, r->p999, r->max, r->value);
+        }
+        else
+        {
+            fprintf(fp, ", \"value\": %.3f}", r->value);
+        }
+    }
+    fprintf(fp, "\n  ]\n}\n");
+}
+
+/**
+ * @brief ÷(ڲ)
+ * 
+ */
+static void _bench_usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--quick] [--filter NAME] [--iterations N] [--threads N] [--json FILE]"
+                    " [--journal-dir DIR] [--journal-mb N]"
+#ifdef TK_TIMER_USING_TRACE
+                    " [--trace FILE]"
+#endif /* TK_TIMER_USING_TRACE */
+                    "\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *json_path = NULL;
+#ifdef TK_TIMER_USING_TRACE
+    const char *trace_path = NULL;
+#endif /* TK_TIMER_USING_TRACE */
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            bench_opts.quick = true;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            bench_opts.filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+        {
+            bench_opts.iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            bench_opts.threads = (uint16_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--journal-dir") == 0 && i + 1 < argc)
+        {
+            bench_opts.journal_dir = argv[++i];
+        }
+        else if (strcmp(argv[i], "--journal-mb") == 0 && i + 1 < argc)
+        {
+            bench_opts.journal_mb = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+#ifdef TK_TIMER_USING_TRACE
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+        }
+#endif /* TK_TIMER_USING_TRACE */
+        else
+        {
+            _bench_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (bench_opts.quick)
+        bench_opts.iterations /= 10;
+    if (bench_opts.iterations < 100)
+        bench_opts.iterations = 100;
+    bench_opts.warmup = bench_opts.iterations / 10;
+    if (bench_opts.journal_mb == 0)
+        bench_opts.journal_mb = bench_opts.quick ? 64 : 1024;
+    if (bench_opts.threads == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        bench_opts.threads = cpus > 1 ? (uint16_t)cpus : 2;
+    }
+
+    _bench_calibrate();
+    _bench_measure_overhead();
+    tk_timer_func_init(bench_get_tick);
+#ifdef TK_TIMER_USING_TRACE
+    tk_timer_trace_set_time_func(_bench_trace_time, (uint32_t)(bench_cycles_per_ns * 1e9 / 16));
+#endif /* TK_TIMER_USING_TRACE */
+
+    for (uint32_t i = 0; i < sizeof(bench_groups) / sizeof(bench_groups[0]); i++)
+    {
+        fprintf(stderr, "[%s]\n", bench_groups[i].name);
+        bench_groups[i].run();
+    }
+
+#ifdef TK_TIMER_USING_TRACE
+    tk_timer_trace_summary(stderr);
+    if (trace_path != NULL)
+    {
+        FILE *fp = fopen(trace_path, "wb");
+        if (fp == NULL || tk_timer_trace_dump(fp) == false)
+            perror(trace_path);
+        if (fp != NULL)
+            fclose(fp);
+    }
+#endif /* TK_TIMER_USING_TRACE */
+    if (json_path != NULL)
+    {
+        FILE *fp = fopen(json_path, "w");
+        if (fp == NULL)
+        {
+            perror(json_path);
+            return 1;
+        }
+        _bench_write_json(fp);
+        fclose(fp);
+    }
+    else
+    {
+        _bench_write_json(stdout);
+    }
+    free(bench_results);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add timer trace variant
+* 2026-10-19     zhangran     add priority queue benchmark
+* 2026-10-19     zhangran     add queue journal benchmark
+* 2026-10-19     zhangran     add log benchmark
+* 2026-10-19     zhangran     add bus benchmark
+* 2026-10-19     zhangran     add timer table benchmark
+* 2026-10-19     zhangran     enable timer table simd scan
+* 2026-10-19     zhangran     enable timer simulation
+* 2026-10-19     zhangran     enable timer batch callback
+* 2026-10-19     zhangran     enable timer group
+* 2026-10-19     zhangran     enable queue ttl
+* 2026-10-19     zhangran     enable queue adaptive batch
+* 2026-10-19     zhangran     add mailbox benchmark
+* 2026-10-19     zhangran     add buffer pool benchmark
+* 2026-10-19     zhangran     add pipeline benchmark
+* 2026-10-19     zhangran     enable event wait any
+*/
+#ifndef __TOOLKIT_CFG_H_
+#define __TOOLKIT_CFG_H_
+
+/* toolkit_bench Configuration, all linux features enabled, assert disabled */
+#define TOOLKIT_USING_QUEUE
+#define TOOLKIT_USING_PQUEUE
+#define TOOLKIT_USING_TIMER
+#define TOOLKIT_USING_EVENT
+#define TOOLKIT_USING_BUS
+#define TOOLKIT_USING_MAILBOX
+#define TOOLKIT_USING_BUFPOOL
+#define TOOLKIT_USING_LOOP
+#define TOOLKIT_USING_RUNTIME
+#define TOOLKIT_USING_PIPELINE
+#define TOOLKIT_USING_COROUTINE
+#define TOOLKIT_USING_LOG
+#ifdef BENCH_USING_STATS
+#define TOOLKIT_USING_STATS
+#endif /* BENCH_USING_STATS */
+
+/* toolkit queue Configuration item */
+#define TK_QUEUE_USING_CREATE
+#define TK_QUEUE_USING_FD
+#define TK_QUEUE_USING_JOURNAL
+#define TK_QUEUE_USING_TTL
+#define TK_QUEUE_USING_BATCH
+
+/* toolkit priority queue Configuration item */
+#define TK_PQUEUE_USING_CREATE
+
+/* toolkit timer Configuration item */
+#define TK_TIMER_USING_CREATE
+#define TK_TIMER_USING_TIMEOUT_CALLBACK
+#define TK_TIMER_USING_BATCH_CALLBACK
+#define TK_TIMER_USING_GROUP
+#define TK_TIMER_USING_FD
+#define TK_TIMER_TICK_PER_SECOND 1000
+#define TK_TIMER_USING_TLS
+#define TK_TIMER_USING_TABLE
+#define TK_TIMER_USING_SIMD
+#define TK_TIMER_USING_SIM
+#ifdef BENCH_USING_TRACE
+#define TK_TIMER_USING_TRACE
+#endif /* BENCH_USING_TRACE */
+
+/* toolkit event Configuration item */
+#define TK_EVENT_USING_CREATE
+#define TK_EVENT_USING_FD
+#define TK_EVENT_USING_WAIT
+
+/* toolkit bus Configuration item */
+#define TK_BUS_USING_CREATE
+
+/* toolkit mailbox Configuration item */
+#define TK_MAILBOX_USING_CREATE
+
+/* toolkit buffer pool Configuration item */
+#define TK_BUFPOOL_USING_CREATE
+
+/* toolkit loop Configuration item */
+#define TK_LOOP_USING_CREATE
+
+#endif /* __TOOLKIT_CFG_H_ */
@@ -0,0 +1,199 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+#ifndef __TK_QUEUE_TYPED_H_
+#define __TK_QUEUE_TYPED_H_
+
+#include "toolkit.h"
+
+/*
+ * Type-specialised circular queue, header only.
+ *
+ * TK_QUEUE_DEFINE(name, type, capacity) generates struct name and the
+ * static inline functions below. Element size and capacity are compile
+ * time constants, so a push of a small type becomes a plain store and a
+ * power-of-two capacity turns the index wrap into a mask.
+ *
+ *   void     name_init(struct name *queue, bool keep_fresh);
+ *   bool     name_clean(struct name *queue);
+ *   bool     name_empty(struct name *queue);
+ *   bool     name_full(struct name *queue);
+ *   uint16_t name_curr_len(struct name *queue);
+ *   bool     name_push(struct name *queue, const type *val);
+ *   bool     name_pop(struct name *queue, type *pval);
+ *   bool     name_peep(struct name *queue, type *pval);
+ *   bool     name_remove(struct name *queue);
+ *   uint16_t name_push_multi(struct name *queue, const type *pval, uint16_t len);
+ *   uint16_t name_pop_multi(struct name *queue, type *pval, uint16_t len);
+ *
+ * Return values and keep_fresh follow tk_queue: a full queue rejects the
+ * push, or overwrites the oldest element when keep_fresh is true. The
+ * coroutine, eventfd, stats and journal hooks of tk_queue are not
+ * generated, use struct tk_queue when they are needed. type must be
+ * assignable (wrap arrays in a struct).
+ */
+#define TK_QUEUE_DEFINE(name, type, capacity)                                                  \
+    typedef char name##_capacity_check[((capacity) > 0 && (capacity) <= UINT16_MAX) ? 1 : -1]; \
+                                                                                               \
+    struct name                                                                                \
+    {                                                                                          \
+        bool keep_fresh;                                                                       \
+        uint16_t front;                                                                        \
+        uint16_t rear;                                                                         \
+        uint16_t len;                                                                          \
+        type pool[(capacity)];                                                                 \
+    };                                                                                         \
+                                                                                               \
+    static inline bool name##_clean(struct name *queue)                                        \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        queue->front = 0;                                                                      \
+        queue->rear = 0;                                                                       \
+        queue->len = 0;                                                                        \
+        return true;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_init(struct name *queue, bool keep_fresh)                        \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        queue->keep_fresh = keep_fresh;                                                        \
+        name##_clean(queue);                                                                   \
+    }                                                                                          \
+                                                                                               \
+    static inline bool name##_empty(struct name *queue)                                        \
+    {                                                                                          \
+        return queue->len == 0;                                                                \
+    }                                                                                          \
+                                                                                               \
+    static inline bool name##_full(struct name *queue)                                         \
+    {                                                                                          \
+        return queue->len >= (capacity);                                                       \
+    }                                                                                          \
+                                                                                               \
+    static inline uint16_t name##_curr_len(struct name *queue)                                 \
+    {                                                                                          \
+        return queue->len;                                                                     \
+    }                                                                                          \
+                                                                                               \
+    static inline bool name##_push(struct name *queue, const type *val)                        \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        if (queue->len >= (capacity))                                                          \
+        {                                                                                      \
+            if (queue->keep_fresh == false)                                                    \
+                return false;                                                                  \
+            queue->front = (uint16_t)((queue->front + 1) % (capacity));                        \
+            queue->len--;                                                                      \
+        }                                                                                      \
+        queue->pool[queue->rear] = *val;                                                       \
+        queue->rear = (uint16_t)((queue->rear + 1) % (capacity));                              \
+        queue->len++;                                                                          \
+        return true;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    static inline bool name##_peep(struct name *queue, type *pval)                             \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        if (queue->len == 0)                                                                   \
+            return false;                                                                      \
+        *pval = queue->pool[queue->front];                                                     \
+        return true;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    static inline bool name##_remove(struct name *queue)                                       \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        if (queue->len == 0)                                                                   \
+            return true;                                                                       \
+        queue->front = (uint16_t)((queue->front + 1) % (capacity));                            \
+        queue->len--;                                                                          \
+        return true;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    static inline bool name##_pop(struct name *queue, type *pval)                              \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        if (queue->len == 0)                                                                   \
+            return false;                                                                      \
+        *pval = queue->pool[queue->front];                                                     \
+        queue->front = (uint16_t)((queue->front + 1) % (capacity));                            \
+        queue->len--;                                                                          \
+        return true;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    /* copy at most two contiguous runs instead of one element at a time */                    \
+    static inline uint16_t name##_push_multi(struct name *queue, const type *pval, uint16_t len) \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        uint32_t count = len;                                                                  \
+        uint32_t first;                                                                        \
+        uint32_t total;                                                                        \
+        if (queue->keep_fresh == false)                                                        \
+        {                                                                                      \
+            if (count > (uint32_t)(capacity) - queue->len)                                     \
+                count = (uint32_t)(capacity) - queue->len;                                     \
+            len = (uint16_t)count;                                                             \
+        }                                                                                      \
+        else if (count > (capacity))                                                           \
+        {                                                                                      \
+            pval += count - (capacity);                                                        \
+            count = (capacity);                                                                \
+        }                                                                                      \
+        first = (uint32_t)(capacity) - queue->rear;                                            \
+        if (first > count)                                                                     \
+            first = count;                                                                     \
+        memcpy(&queue->pool[queue->rear], pval, first * sizeof(type));                         \
+        memcpy(&queue->pool[0], pval + first, (count - first) * sizeof(type));                 \
+        queue->rear = (uint16_t)((queue->rear + count) % (capacity));                          \
+        total = queue->len + count;                                                            \
+        if (total > (capacity))                                                                \
+        {                                                                                      \
+            queue->front = queue->rear;                                                        \
+            total = (capacity);                                                                \
+        }                                                                                      \
+        queue->len = (uint16_t)total;                                                          \
+        return len;                                                                            \
+    }                                                                                          \
+                                                                                               \
+    static inline uint16_t name##_pop_multi(struct name *queue, type *pval, uint16_t len)      \
+    {                                                                                          \
+        TK_ASSERT(queue);                                                                      \
+        uint32_t count = len;                                                                  \
+        uint32_t first;                                                                        \
+        if (count > queue->len)                                                                \
+            count = queue->len;                                                                \
+        first = (uint32_t)(capacity) - queue->front;                                           \
+        if (first > count)                                                                     \
+            first = count;                                                                     \
+        memcpy(pval, &queue->pool[queue->front], first * sizeof(type));                        \
+        memcpy(pval + first, &queue->pool[0], (count - first) * sizeof(type));                 \
+        queue->front = (uint16_t)((queue->front + count) % (capacity));                        \
+        queue->len = (uint16_t)(queue->len - count);                                           \
+        return (uint16_t)count;                                                                \
+    }
+
+#endif /* __TK_QUEUE_TYPED_H_ */
@@ -28,6 +28,32 @@
 * 2020-11-28     zhangran     add queue peep&remove extern code
 * 2020-12-09     zhangran     Modify event option type to prevent warning
 * 2023-07-31     zhangran     tk_timer adds the user_data pointer
+* 2026-10-19     zhangran     add eventfd bridge for queue&event
+* 2026-10-19     zhangran     add timerfd driver for timer
+* 2026-10-19     zhangran     add loop extern code
+* 2026-10-19     zhangran     add runtime extern code
+* 2026-10-19     zhangran     add coroutine extern code
+* 2026-10-19     zhangran     add stats extern code
+* 2026-10-19     zhangran     fix TK_ASSERT expansion when assert is disabled
+* 2026-10-19     zhangran     fix fallthrough warning in coroutine await macros
+* 2026-10-19     zhangran     add timer trace extern code
+* 2026-10-19     zhangran     add priority queue extern code
+* 2026-10-19     zhangran     add bus extern code
+* 2026-10-19     zhangran     add timer table extern code
+* 2026-10-19     zhangran     add timer table simd scan
+* 2026-10-19     zhangran     add queue journal extern code
+* 2026-10-19     zhangran     add log extern code
+* 2026-10-19     zhangran     add timer simulation extern code
+* 2026-10-19     zhangran     add timer batch callback
+* 2026-10-19     zhangran     add timer group
+* 2026-10-19     zhangran     defer timer deletes during dispatch
+* 2026-10-19     zhangran     add queue element ttl
+* 2026-10-19     zhangran     add queue adaptive batch signalling
+* 2026-10-19     zhangran     add mailbox extern code
+* 2026-10-19     zhangran     add buffer pool extern code
+* 2026-10-19     zhangran     add pipeline extern code
+* 2026-10-19     zhangran     add event wait any
+* 2026-10-19     zhangran     keep static timers when their group is deleted
 */
 #ifndef __TOOLKIT_H_
 #define __TOOLKIT_H_
@@ -52,11 +78,117 @@
             ;                                                             \
     }
 #else
-#define TK_ASSERT(EXPR) (void)EXPR
+#define TK_ASSERT(EXPR) ((void)(EXPR))
 #endif /* TOOLKIT_USING_ASSERT */
 
+/* toolkit stats */
+#ifdef TOOLKIT_USING_STATS
+#ifndef TK_STATS_HIST_SIZE
+#define TK_STATS_HIST_SIZE 16
+#endif /* TK_STATS_HIST_SIZE */
+
+/* counters are relaxed atomics, they never order other memory accesses */
+#if defined(__GNUC__)
+#define TK_STATS_ADD(VAR, N) __atomic_fetch_add(&(VAR), (N), __ATOMIC_RELAXED)
+#define TK_STATS_LOAD(VAR) __atomic_load_n(&(VAR), __ATOMIC_RELAXED)
+#define TK_STATS_STORE(VAR, N) __atomic_store_n(&(VAR), (N), __ATOMIC_RELAXED)
+/* CAS loop so concurrent updaters never lower the maximum */
+#define TK_STATS_MAX(VAR, N)                                                         \
+    do                                                                               \
+    {                                                                                \
+        __typeof__(VAR) _tk_stats_new = (N);                                         \
+        __typeof__(VAR) _tk_stats_old = __atomic_load_n(&(VAR), __ATOMIC_RELAXED);   \
+        while (_tk_stats_new > _tk_stats_old &&                                      \
+               !__atomic_compare_exchange_n(&(VAR), &_tk_stats_old, _tk_stats_new,   \
+                                            true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) \
+            ;                                                                        \
+    } while (0)
+#else
+#define TK_STATS_ADD(VAR, N) ((VAR) += (N))
+#define TK_STATS_LOAD(VAR) (VAR)
+#define TK_STATS_STORE(VAR, N) ((VAR) = (N))
+#define TK_STATS_MAX(VAR, N)               \
+    do                                     \
+    {                                      \
+        if ((N) > (VAR))                   \
+            (VAR) = (N);                   \
+    } while (0)
+#endif /* defined(__GNUC__) */
+
+typedef enum
+{
+    TK_STATS_TYPE_NONE = 0,
+    TK_STATS_TYPE_QUEUE,
+    TK_STATS_TYPE_TIMER,
+    TK_STATS_TYPE_EVENT,
+} tk_stats_type;
+
+struct tk_stats_entry
+{
+    uint8_t type;
+    const char *name;
+    void *object;
+    struct tk_stats_entry *next;
+    struct tk_stats_entry *prev; /* O(1) unregister */
+};
+
+struct tk_queue_stats
+{
+    uint32_t push;
+    uint32_t pop;
+    uint32_t push_fail;
+    uint32_t pop_fail;
+    uint32_t overwrite;
+    uint16_t high_water;
+};
+
+struct tk_timer_stats
+{
+    uint32_t fire;
+    uint32_t late_max;
+    uint32_t late_hist[TK_STATS_HIST_SIZE];
+    uint32_t callback_max;
+    uint64_t callback_total;
+};
+
+struct tk_event_stats
+{
+    uint32_t send;
+    uint32_t recv;
+    uint32_t hit;
+};
+
+bool tk_stats_register(struct tk_stats_entry *entry, tk_stats_type type, void *object, const char *name);
+bool tk_stats_unregister(struct tk_stats_entry *entry);
+void tk_stats_set_time_func(uint32_t (*time_func)(void));
+uint32_t tk_stats_get_time(void);
+uint8_t tk_stats_hist_index(uint32_t value);
+bool tk_stats_reset(void);
+bool tk_stats_dump(FILE *fp);
+#endif /* TOOLKIT_USING_STATS */
+
 /* toolkit queue */
 #ifdef TOOLKIT_USING_QUEUE
+#if defined(TK_QUEUE_USING_TTL) && !defined(TOOLKIT_USING_TIMER)
+#error "TK_QUEUE_USING_TTL needs TOOLKIT_USING_TIMER"
+#endif
+#if defined(TK_QUEUE_USING_BATCH) && \
+    (!defined(TK_QUEUE_USING_FD) || !defined(TOOLKIT_USING_TIMER) || !defined(TK_TIMER_USING_TIMEOUT_CALLBACK))
+#error "TK_QUEUE_USING_BATCH needs TK_QUEUE_USING_FD, TOOLKIT_USING_TIMER and TK_TIMER_USING_TIMEOUT_CALLBACK"
+#endif
+#ifdef TK_QUEUE_USING_BATCH
+/* adaptive batch size targets about this many consumer wakeups per tick */
+#ifndef TK_QUEUE_BATCH_WAKES_PER_TICK
+#define TK_QUEUE_BATCH_WAKES_PER_TICK 16
+#endif /* TK_QUEUE_BATCH_WAKES_PER_TICK */
+#endif /* TK_QUEUE_USING_BATCH */
+#ifdef TK_QUEUE_USING_JOURNAL
+#ifndef TK_QUEUE_JOURNAL_SEGMENT_SIZE
+#define TK_QUEUE_JOURNAL_SEGMENT_SIZE (64UL * 1024 * 1024)
+#endif /* TK_QUEUE_JOURNAL_SEGMENT_SIZE */
+struct tk_queue_journal;
+#endif /* TK_QUEUE_USING_JOURNAL */
+
 struct tk_queue
 {
     bool keep_fresh;
@@ -66,6 +198,38 @@ struct tk_queue
     uint16_t front;
     uint16_t rear;
     uint16_t len;
+#ifdef TOOLKIT_USING_COROUTINE
+    struct tk_co *co_wait_list; /* oldest waiter first */
+    struct tk_co *co_wait_tail;
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TOOLKIT_USING_STATS
+    struct tk_queue_stats stats;
+    struct tk_stats_entry stats_entry;
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_FD
+    bool fd_enabled;
+    bool fd_signaled;
+    int queue_fd;
+#endif /* TK_QUEUE_USING_FD */
+#ifdef TK_QUEUE_USING_JOURNAL
+    struct tk_queue_journal *journal;
+#endif /* TK_QUEUE_USING_JOURNAL */
+#ifdef TK_QUEUE_USING_TTL
+    uint32_t *stamp;  /* push tick of each slot, NULL when ttl is off */
+    bool stamp_alloc;
+    uint32_t ttl;     /* ticks an element stays fresh, 0 is off */
+    uint32_t expired; /* elements dropped by tk_queue_drop_expired */
+#endif /* TK_QUEUE_USING_TTL */
+#ifdef TK_QUEUE_USING_BATCH
+    struct tk_timer *batch_timer; /* flushes a partial batch, NULL when batching is off */
+    bool batch_timer_alloc;
+    uint16_t batch;        /* pending elements that signal the eventfd, follows the arrival rate */
+    uint16_t batch_max;
+    uint32_t batch_wait;   /* ticks the oldest pending element may wait */
+    uint32_t batch_tick;   /* tick of the current rate window */
+    uint32_t batch_count;  /* pushes in the current rate window */
+    uint32_t batch_rate;   /* pushes per tick, moving average in 1/256 units */
+#endif /* TK_QUEUE_USING_BATCH */
 };
 typedef struct tk_queue *tk_queue_t;
 
@@ -86,12 +250,111 @@ bool tk_queue_pop(struct tk_queue *queue, void *pval);
 uint16_t tk_queue_curr_len(struct tk_queue *queue);
 uint16_t tk_queue_push_multi(struct tk_queue *queue, void *pval, uint16_t len);
 uint16_t tk_queue_pop_multi(struct tk_queue *queue, void *pval, uint16_t len);
+#ifdef TK_QUEUE_USING_FD
+int tk_queue_get_fd(struct tk_queue *queue);
+#endif /* TK_QUEUE_USING_FD */
+#ifdef TK_QUEUE_USING_TTL
+bool tk_queue_set_ttl(struct tk_queue *queue, uint32_t ttl_tick, uint32_t *stamp_pool);
+uint16_t tk_queue_drop_expired(struct tk_queue *queue);
+bool tk_queue_pop_fresh(struct tk_queue *queue, void *pval);
+uint32_t tk_queue_get_expired(struct tk_queue *queue);
+#endif /* TK_QUEUE_USING_TTL */
+#ifdef TK_QUEUE_USING_BATCH
+bool tk_queue_set_batch(struct tk_queue *queue, struct tk_timer *timer, uint16_t batch_max, uint32_t wait_tick);
+uint16_t tk_queue_get_batch(struct tk_queue *queue);
+#endif /* TK_QUEUE_USING_BATCH */
+#ifdef TK_QUEUE_USING_JOURNAL
+bool tk_queue_journal_open(struct tk_queue *queue, const char *dir, uint32_t sync_batch);
+bool tk_queue_journal_close(struct tk_queue *queue);
+bool tk_queue_journal_sync(struct tk_queue *queue);
+uint64_t tk_queue_journal_len(struct tk_queue *queue);
+/* journal storage, used by tk_queue.c */
+bool tk_journal_append(struct tk_queue_journal *journal, const void *pval);
+bool tk_journal_peep(struct tk_queue_journal *journal, void *pval);
+bool tk_journal_consume(struct tk_queue_journal *journal);
+bool tk_journal_reset(struct tk_queue_journal *journal);
+uint64_t tk_journal_len(struct tk_queue_journal *journal);
+#endif /* TK_QUEUE_USING_JOURNAL */
 #endif /* TOOLKIT_USING_QUEUE */
 
+/* toolkit priority queue */
+#ifdef TOOLKIT_USING_PQUEUE
+#ifndef TK_PQUEUE_MAX_BANDS
+#define TK_PQUEUE_MAX_BANDS 8
+#endif /* TK_PQUEUE_MAX_BANDS */
+#if TK_PQUEUE_MAX_BANDS > 32
+#error "TK_PQUEUE_MAX_BANDS must not exceed 32"
+#endif
+
+/* heap node, smaller prio pops first, equal prio pops in push order */
+struct tk_pqueue_node
+{
+    uint16_t prio;
+    uint16_t slot;
+    uint32_t seq;
+};
+
+/* pool bytes needed by tk_pqueue_init for max_queues elements */
+#define TK_PQUEUE_POOL_SIZE(queue_size, max_queues) \
+    ((uint32_t)(max_queues) * (sizeof(struct tk_pqueue_node) + sizeof(uint16_t) + (queue_size)))
+
+struct tk_pqueue
+{
+    struct tk_pqueue_node *heap;
+    uint16_t *free_slots;
+    uint8_t *queue_pool;
+    uint16_t queue_size;
+    uint16_t max_queues;
+    uint16_t len;
+    uint32_t seq;
+};
+typedef struct tk_pqueue *tk_pqueue_t;
+
+struct tk_mlqueue
+{
+    uint8_t *queue_pool;
+    uint16_t queue_size;
+    uint16_t band_size;
+    uint8_t band_num;
+    uint32_t bitmap;
+    uint16_t front[TK_PQUEUE_MAX_BANDS];
+    uint16_t len[TK_PQUEUE_MAX_BANDS];
+};
+typedef struct tk_mlqueue *tk_mlqueue_t;
+
+#ifdef TK_PQUEUE_USING_CREATE
+struct tk_pqueue *tk_pqueue_create(uint16_t queue_size, uint16_t max_queues);
+bool tk_pqueue_delete(struct tk_pqueue *queue);
+struct tk_mlqueue *tk_mlqueue_create(uint16_t queue_size, uint16_t band_size, uint8_t band_num);
+bool tk_mlqueue_delete(struct tk_mlqueue *queue);
+#endif /* TK_PQUEUE_USING_CREATE */
+
+bool tk_pqueue_init(struct tk_pqueue *queue, void *queuepool, uint32_t pool_size, uint16_t queue_size);
+bool tk_pqueue_detach(struct tk_pqueue *queue);
+bool tk_pqueue_clean(struct tk_pqueue *queue);
+bool tk_pqueue_empty(struct tk_pqueue *queue);
+bool tk_pqueue_full(struct tk_pqueue *queue);
+uint16_t tk_pqueue_curr_len(struct tk_pqueue *queue);
+bool tk_pqueue_push(struct tk_pqueue *queue, void *pval, uint16_t prio);
+bool tk_pqueue_pop(struct tk_pqueue *queue, void *pval);
+bool tk_pqueue_peep(struct tk_pqueue *queue, void *pval, uint16_t *prio);
+
+bool tk_mlqueue_init(struct tk_mlqueue *queue, void *queuepool, uint32_t pool_size,
+                     uint16_t queue_size, uint8_t band_num);
+bool tk_mlqueue_detach(struct tk_mlqueue *queue);
+bool tk_mlqueue_clean(struct tk_mlqueue *queue);
+bool tk_mlqueue_empty(struct tk_mlqueue *queue);
+uint16_t tk_mlqueue_curr_len(struct tk_mlqueue *queue);
+bool tk_mlqueue_push(struct tk_mlqueue *queue, void *pval, uint8_t prio);
+bool tk_mlqueue_pop(struct tk_mlqueue *queue, void *pval);
+bool tk_mlqueue_peep(struct tk_mlqueue *queue, void *pval, uint8_t *prio);
+#endif /* TOOLKIT_USING_PQUEUE */
+
 /* toolkit timer */
 #ifdef TOOLKIT_USING_TIMER
 
 struct tk_timer;
+struct tk_timer_group;
 
 typedef enum
 {
@@ -106,9 +369,18 @@ typedef enum
     TIMER_MODE_LOOP,
 } tk_timer_mode;
 
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+/* timers expired in one pass, grouped by callback and kept in list order */
+typedef void (*tk_timer_batch_callback)(struct tk_timer **timers, uint32_t num);
+#ifndef TK_TIMER_BATCH_SIZE
+#define TK_TIMER_BATCH_SIZE 256
+#endif /* TK_TIMER_BATCH_SIZE */
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+
 struct tk_timer
 {
     bool enable;
+    bool dead; /* deleted, freed after the current pass or by the owner thread */
     tk_timer_state state;
     tk_timer_mode mode;
     uint32_t delay_tick;
@@ -119,12 +391,37 @@ struct tk_timer
 #ifdef TK_TIMER_USING_TIMEOUT_CALLBACK
 	void(*timeout_callback)(struct tk_timer *timer);
 #endif /* TK_TIMER_USING_TIMEOUT_CALLBACK */
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+    tk_timer_batch_callback batch_callback;
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+#ifdef TK_TIMER_USING_GROUP
+    struct tk_timer_group *group;
+    uint32_t group_gen;   /* group generation when started, stale means stopped by the group */
+    uint32_t group_shift; /* group shift already applied to timer_tick_timeout */
+#endif /* TK_TIMER_USING_GROUP */
+#ifdef TK_TIMER_USING_CREATE
+    bool created; /* allocated by tk_timer_create, static timers are only detached when their group is deleted */
+#endif /* TK_TIMER_USING_CREATE */
+#if defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS)
+    struct tk_timer **owner;      /* remote delete list of the thread whose list holds the timer */
+    struct tk_timer *remote_next;
+#endif /* defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS) */
+#ifdef TOOLKIT_USING_STATS
+    struct tk_timer_stats stats;
+    struct tk_stats_entry stats_entry;
+#endif /* TOOLKIT_USING_STATS */
 };
 typedef struct tk_timer *tk_timer_t;
 
 bool tk_timer_func_init(uint32_t (*get_tick_func)(void));
+bool tk_timer_func_deinit(void);
 
 #ifdef TK_TIMER_USING_CREATE
+/* timers of deleted groups freed per pass, timers deleted in callbacks are kept apart and all freed at the end of the pass */
+#ifndef TK_TIMER_RECLAIM_BATCH
+#define TK_TIMER_RECLAIM_BATCH 1024
+#endif /* TK_TIMER_RECLAIM_BATCH */
+
 struct tk_timer *tk_timer_create(void(*timeout_callback)(struct tk_timer *timer));
 bool tk_timer_delete(struct tk_timer *timer);
 #endif /* TK_TIMER_USING_CREATE */
@@ -138,6 +435,220 @@ bool tk_timer_restart(struct tk_timer *timer);
 tk_timer_mode tk_timer_get_mode(struct tk_timer *timer);
 tk_timer_state tk_timer_get_state(struct tk_timer *timer);
 bool tk_timer_loop_handler(void);
+bool tk_timer_get_next_tick(uint32_t *tick);
+uint32_t tk_timer_get_curr_tick(void);
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+bool tk_timer_set_batch_callback(struct tk_timer *timer, tk_timer_batch_callback batch_callback);
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+
+#ifdef TK_TIMER_USING_GROUP
+/* stop, shift and delete apply to all members in O(1), members catch up when the handler visits them */
+struct tk_timer_group
+{
+    uint32_t gen;   /* bumped by tk_timer_group_stop */
+    uint32_t shift; /* sum of tk_timer_group_shift deltas */
+    uint32_t num;   /* member count */
+    bool dead;      /* deleted, members are freed by tk_timer_loop_handler */
+};
+typedef struct tk_timer_group *tk_timer_group_t;
+
+#ifdef TK_TIMER_USING_CREATE
+struct tk_timer_group *tk_timer_group_create(void);
+bool tk_timer_group_delete(struct tk_timer_group *group);
+#endif /* TK_TIMER_USING_CREATE */
+bool tk_timer_group_init(struct tk_timer_group *group);
+bool tk_timer_group_detach(struct tk_timer_group *group);
+bool tk_timer_group_add(struct tk_timer_group *group, struct tk_timer *timer);
+bool tk_timer_group_remove(struct tk_timer *timer);
+bool tk_timer_group_stop(struct tk_timer_group *group);
+bool tk_timer_group_shift(struct tk_timer_group *group, int32_t delta_tick);
+#endif /* TK_TIMER_USING_GROUP */
+
+#ifndef TK_TIMER_TICK_PER_SECOND
+#define TK_TIMER_TICK_PER_SECOND 1000
+#endif /* TK_TIMER_TICK_PER_SECOND */
+
+#ifdef TK_TIMER_USING_FD
+uint32_t tk_timer_fd_get_tick(void);
+int tk_timer_get_fd(void);
+bool tk_timer_fd_handler(void);
+bool tk_timer_fd_wait(int32_t timeout_ms);
+bool tk_timer_release_fd(void);
+#endif /* TK_TIMER_USING_FD */
+
+#if defined(TK_TIMER_USING_SIMD) && !defined(TK_TIMER_USING_TABLE)
+#error "TK_TIMER_USING_SIMD needs TK_TIMER_USING_TABLE"
+#endif
+#ifdef TK_TIMER_USING_TABLE
+/* structure-of-arrays timer table, timers are addressed by id instead of pointer */
+#define TK_TIMER_TABLE_INVALID UINT32_MAX
+
+/* bytes per group of 32 timers: deadline, user_data, callback, delay, free id, state,
+   enable word, group minimum and two slots for the per 1024 timers summary */
+#define TK_TIMER_TABLE_GROUP_SIZE \
+    (32 * (sizeof(uint32_t) * 3 + sizeof(void *) + sizeof(tk_timer_table_callback) + sizeof(uint8_t)) + sizeof(uint32_t) * 4)
+/* pool bytes needed by tk_timer_table_init for max_timers timers */
+#define TK_TIMER_TABLE_POOL_SIZE(max_timers) \
+    ((((uint32_t)(max_timers) + 31) / 32) * TK_TIMER_TABLE_GROUP_SIZE)
+
+struct tk_timer_table;
+typedef void (*tk_timer_table_callback)(struct tk_timer_table *table, uint32_t id, void *user_data);
+
+struct tk_timer_table
+{
+    /* hot: read by every handler pass */
+    uint32_t *deadline;
+    uint32_t *enable;
+    uint32_t *group_min; /* per group, never later than its earliest enabled deadline */
+    uint32_t *block_min; /* the same per 1024 timers */
+    uint32_t *block_empty; /* bitmap of blocks without enabled timers */
+    /* cold: only touched on start/stop and on expiry */
+    void **user_data;
+    tk_timer_table_callback *callback;
+    uint32_t *delay_tick;
+    uint32_t *free_ids;
+    uint8_t *state;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t free_num;
+    bool next_valid;
+    uint32_t next_tick;
+};
+typedef struct tk_timer_table *tk_timer_table_t;
+
+/* expiry scan backend, selected once by cpuid unless set explicitly */
+typedef enum
+{
+    TK_TIMER_SCAN_SCALAR = 0,
+    TK_TIMER_SCAN_SSE2,
+    TK_TIMER_SCAN_AVX2,
+} tk_timer_scan_isa;
+
+#ifdef TK_TIMER_USING_CREATE
+struct tk_timer_table *tk_timer_table_create(uint32_t max_timers);
+bool tk_timer_table_delete(struct tk_timer_table *table);
+#endif /* TK_TIMER_USING_CREATE */
+bool tk_timer_table_init(struct tk_timer_table *table, void *pool, uint32_t pool_size);
+bool tk_timer_table_detach(struct tk_timer_table *table);
+uint32_t tk_timer_table_add(struct tk_timer_table *table, tk_timer_table_callback callback, void *user_data);
+bool tk_timer_table_remove(struct tk_timer_table *table, uint32_t id);
+bool tk_timer_table_start(struct tk_timer_table *table, uint32_t id, tk_timer_mode mode, uint32_t delay_tick);
+bool tk_timer_table_stop(struct tk_timer_table *table, uint32_t id);
+bool tk_timer_table_continue(struct tk_timer_table *table, uint32_t id);
+bool tk_timer_table_restart(struct tk_timer_table *table, uint32_t id);
+tk_timer_mode tk_timer_table_get_mode(struct tk_timer_table *table, uint32_t id);
+tk_timer_state tk_timer_table_get_state(struct tk_timer_table *table, uint32_t id);
+void *tk_timer_table_get_user_data(struct tk_timer_table *table, uint32_t id);
+bool tk_timer_table_handler(struct tk_timer_table *table);
+bool tk_timer_table_get_next_tick(struct tk_timer_table *table, uint32_t *tick);
+bool tk_timer_table_set_scan(tk_timer_scan_isa isa);
+tk_timer_scan_isa tk_timer_table_get_scan(void);
+#endif /* TK_TIMER_USING_TABLE */
+
+#ifdef TK_TIMER_USING_TRACE
+#ifndef TK_TIMER_TRACE_SIZE
+#define TK_TIMER_TRACE_SIZE 1024
+#endif /* TK_TIMER_TRACE_SIZE */
+#if (TK_TIMER_TRACE_SIZE & (TK_TIMER_TRACE_SIZE - 1)) != 0
+#error "TK_TIMER_TRACE_SIZE must be a power of 2"
+#endif
+/* trace one of every TK_TIMER_TRACE_SAMPLE handler passes that have expiries, 1 traces every pass */
+#ifndef TK_TIMER_TRACE_SAMPLE
+#define TK_TIMER_TRACE_SAMPLE 128
+#endif /* TK_TIMER_TRACE_SAMPLE */
+#if TK_TIMER_TRACE_SAMPLE == 0 || (TK_TIMER_TRACE_SAMPLE & (TK_TIMER_TRACE_SAMPLE - 1)) != 0
+#error "TK_TIMER_TRACE_SAMPLE must be a power of 2"
+#endif
+
+/* log-linear histogram, 8 sub-buckets per power of 2, relative error < 12.5% */
+#define TK_TIMER_TRACE_HIST_SUB_BITS 3
+#define TK_TIMER_TRACE_HIST_SIZE ((32 - TK_TIMER_TRACE_HIST_SUB_BITS + 1) << TK_TIMER_TRACE_HIST_SUB_BITS)
+
+#define TK_TIMER_TRACE_MAGIC   0x52544B54 /* "TKTR" */
+#define TK_TIMER_TRACE_VERSION 1
+
+typedef enum
+{
+    TK_TIMER_TRACE_LATENESS = 0,
+    TK_TIMER_TRACE_CALLBACK,
+} tk_timer_trace_hist;
+
+/* one record per expiry, times are in trace time units */
+struct tk_timer_trace_record
+{
+    uint32_t seq;        /* position in the ring + 1, 0 while being written */
+    uint32_t thread;     /* tracing thread number, starting from 1 */
+    uint64_t timer;      /* timer address */
+    uint32_t deadline;   /* scheduled deadline tick */
+    uint32_t tick;       /* tick when the first expiry of the handler pass was found */
+    uint32_t pass_begin; /* time when the first expiry of the handler pass was found */
+    uint32_t dispatch;   /* end of the previous callback in the pass, or pass_begin */
+    uint32_t duration;   /* callback duration */
+    uint32_t reserved;
+};
+
+/* binary dump header, followed by 'count' records, native byte order */
+struct tk_timer_trace_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t count;
+    uint32_t total;
+    uint32_t units_per_second;
+    uint32_t tick_per_second;
+};
+
+void tk_timer_trace_set_time_func(uint32_t (*time_func)(void), uint32_t units_per_second);
+void tk_timer_trace_enable(bool enable);
+bool tk_timer_trace_reset(void);
+uint32_t tk_timer_trace_read(struct tk_timer_trace_record *records, uint32_t num);
+uint32_t tk_timer_trace_percentile(tk_timer_trace_hist hist, uint16_t permille);
+bool tk_timer_trace_summary(FILE *fp);
+bool tk_timer_trace_dump(FILE *fp);
+#endif /* TK_TIMER_USING_TRACE */
+
+#ifdef TK_TIMER_USING_SIM
+/* virtual clock driver, jumps straight to the next deadline instead of stepping tick by tick */
+#ifndef TK_TIMER_SIM_MAX_TABLES
+#define TK_TIMER_SIM_MAX_TABLES 8
+#endif /* TK_TIMER_SIM_MAX_TABLES */
+
+/* one record per expiry, in dispatch order */
+struct tk_timer_sim_record
+{
+    uint64_t time;     /* virtual ticks since tk_timer_sim_begin */
+    uint32_t tick;     /* virtual tick, wraps like a real one */
+    uint32_t deadline; /* scheduled deadline tick, equal to tick unless the timer fired late */
+    uint32_t index;    /* position in the timer list, or id in the table */
+    uint32_t source;   /* 0 for the timer list, n for the n-th table passed to tk_timer_sim_add_table */
+    void *timer;       /* struct tk_timer * or struct tk_timer_table * */
+};
+
+struct tk_timer_sim_result
+{
+    uint64_t time;    /* virtual ticks since tk_timer_sim_begin */
+    uint64_t passes;  /* handler passes, one per distinct deadline */
+    uint64_t expired; /* expiries seen */
+    uint64_t late;    /* expiries whose deadline was before the virtual tick */
+    uint64_t digest;  /* FNV-1a over time, deadline, index and source of every expiry */
+};
+
+struct tk_timer;
+struct tk_timer_table;
+bool tk_timer_sim_begin(uint32_t start_tick);
+bool tk_timer_sim_end(void);
+uint32_t tk_timer_sim_get_tick(void);
+#ifdef TK_TIMER_USING_TABLE
+bool tk_timer_sim_add_table(struct tk_timer_table *table);
+#endif /* TK_TIMER_USING_TABLE */
+void tk_timer_sim_set_trace(struct tk_timer_sim_record *records, uint32_t size);
+uint64_t tk_timer_sim_run(uint64_t ticks);
+bool tk_timer_sim_get_result(struct tk_timer_sim_result *result);
+/* called by the handlers */
+bool tk_timer_sim_swap_tick(uint32_t (**get_tick_func)(void));
+void tk_timer_sim_expire(struct tk_timer *timer, struct tk_timer_table *table, uint32_t index, uint32_t deadline);
+#endif /* TK_TIMER_USING_SIM */
 #endif /* TOOLKIT_USING_TIMER */
 
 /* toolkit event */
@@ -149,9 +660,35 @@ typedef enum
     TK_EVENT_OPTION_CLEAR = 0x04,
 } tk_event_option;
 
+#ifdef TK_EVENT_USING_WAIT
+/* most events a single tk_event_wait_any call can wait on, nodes live on the waiter's stack */
+#ifndef TK_EVENT_WAIT_MAX
+#define TK_EVENT_WAIT_MAX 256
+#endif /* TK_EVENT_WAIT_MAX */
+struct tk_event_wait_node;
+#endif /* TK_EVENT_USING_WAIT */
+
 struct tk_event
 {
     uint32_t event_set;
+#ifdef TOOLKIT_USING_COROUTINE
+    struct tk_co *co_wait_list;
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TOOLKIT_USING_STATS
+    struct tk_event_stats stats;
+    struct tk_stats_entry stats_entry;
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_EVENT_USING_FD
+    bool fd_enabled;
+    bool fd_signaled;
+    uint8_t fd_option;
+    int event_fd;
+    uint32_t fd_event_set;
+#endif /* TK_EVENT_USING_FD */
+#ifdef TK_EVENT_USING_WAIT
+    struct tk_event_wait_node *wait_list; /* threads parked in tk_event_wait_any */
+    uint8_t wait_lock;
+#endif /* TK_EVENT_USING_WAIT */
 };
 typedef struct tk_event *tk_event_t;
 
@@ -163,6 +700,474 @@ bool tk_event_delete(struct tk_event *event);
 bool tk_event_init(struct tk_event *event);
 bool tk_event_send(struct tk_event *event, uint32_t event_set);
 bool tk_event_recv(struct tk_event *event, uint32_t event_set, uint8_t option, uint32_t *recved);
+#ifdef TK_EVENT_USING_FD
+int tk_event_get_fd(struct tk_event *event, uint32_t event_set, uint8_t option);
+bool tk_event_release_fd(struct tk_event *event);
+#endif /* TK_EVENT_USING_FD */
+#ifdef TK_EVENT_USING_WAIT
+bool tk_event_wait_any(struct tk_event **events, const uint32_t *event_sets, const uint8_t *options,
+                       uint16_t num, int32_t timeout_ms, uint16_t *index, uint32_t *recved);
+#endif /* TK_EVENT_USING_WAIT */
 #endif /* TOOLKIT_USING_EVENT */
 
+/* toolkit bus */
+#ifdef TOOLKIT_USING_BUS
+#ifndef TOOLKIT_USING_EVENT
+#error "TOOLKIT_USING_BUS needs TOOLKIT_USING_EVENT"
+#endif
+#ifndef TK_BUS_MAX_SUBSCRIBERS
+#define TK_BUS_MAX_SUBSCRIBERS 32
+#endif /* TK_BUS_MAX_SUBSCRIBERS */
+#if TK_BUS_MAX_SUBSCRIBERS > 255
+#error "TK_BUS_MAX_SUBSCRIBERS must not exceed 255"
+#endif
+
+struct tk_bus;
+
+/* subscriber, holds its own read cursor into the shared ring */
+struct tk_bus_sub
+{
+    struct tk_bus *bus;
+    struct tk_event *event;
+    uint32_t event_set;
+    uint32_t cursor;
+    uint32_t lost;
+};
+typedef struct tk_bus_sub *tk_bus_sub_t;
+
+/* one topic, all subscribers read the same ring */
+struct tk_bus
+{
+    uint8_t *msg_pool;
+    uint16_t msg_size;
+    bool keep_fresh;
+    uint8_t sub_num;
+    uint32_t mask;
+    uint32_t head;
+    uint32_t gate;
+    struct tk_bus_sub *subs[TK_BUS_MAX_SUBSCRIBERS];
+};
+typedef struct tk_bus *tk_bus_t;
+
+#ifdef TK_BUS_USING_CREATE
+struct tk_bus *tk_bus_create(uint16_t msg_size, uint32_t max_msgs, bool keep_fresh);
+bool tk_bus_delete(struct tk_bus *bus);
+#endif /* TK_BUS_USING_CREATE */
+
+bool tk_bus_init(struct tk_bus *bus, void *msgpool, uint32_t pool_size, uint16_t msg_size, bool keep_fresh);
+bool tk_bus_detach(struct tk_bus *bus);
+uint32_t tk_bus_capacity(struct tk_bus *bus);
+bool tk_bus_publish(struct tk_bus *bus, const void *pval);
+bool tk_bus_subscribe(struct tk_bus *bus, struct tk_bus_sub *sub, struct tk_event *event, uint32_t event_set);
+bool tk_bus_unsubscribe(struct tk_bus_sub *sub);
+bool tk_bus_read(struct tk_bus_sub *sub, void *pval);
+bool tk_bus_peep(struct tk_bus_sub *sub, void *pval);
+uint32_t tk_bus_pending(struct tk_bus_sub *sub);
+uint32_t tk_bus_lost(struct tk_bus_sub *sub);
+#endif /* TOOLKIT_USING_BUS */
+
+/* toolkit mailbox */
+#ifdef TOOLKIT_USING_MAILBOX
+/* pool size for a value, the writer alternates between two buffers */
+#define TK_MAILBOX_POOL_SIZE(value_size) (2 * (value_size))
+
+/* latest value, one writer and lock-free readers (double buffered seqlock) */
+struct tk_mailbox
+{
+    uint32_t version; /* last complete write, 0 when never written */
+    uint32_t seq[2];  /* version * 2 of each buffer, odd while the writer copies into it */
+    uint32_t value_size;
+    void *value_pool;
+};
+typedef struct tk_mailbox *tk_mailbox_t;
+
+#ifdef TK_MAILBOX_USING_CREATE
+struct tk_mailbox *tk_mailbox_create(uint32_t value_size);
+bool tk_mailbox_delete(struct tk_mailbox *mailbox);
+#endif /* TK_MAILBOX_USING_CREATE */
+
+bool tk_mailbox_init(struct tk_mailbox *mailbox, void *valuepool, uint32_t pool_size, uint32_t value_size);
+bool tk_mailbox_detach(struct tk_mailbox *mailbox);
+bool tk_mailbox_write(struct tk_mailbox *mailbox, const void *pval);
+bool tk_mailbox_read(struct tk_mailbox *mailbox, void *pval, uint32_t *version);
+uint32_t tk_mailbox_version(struct tk_mailbox *mailbox);
+uint32_t tk_mailbox_size(struct tk_mailbox *mailbox);
+#endif /* TOOLKIT_USING_MAILBOX */
+
+/* toolkit buffer pool */
+#ifdef TOOLKIT_USING_BUFPOOL
+#ifndef TK_BUFPOOL_ALIGN
+#define TK_BUFPOOL_ALIGN 64
+#endif /* TK_BUFPOOL_ALIGN */
+#if (TK_BUFPOOL_ALIGN & (TK_BUFPOOL_ALIGN - 1)) != 0
+#error "TK_BUFPOOL_ALIGN must be a power of two"
+#endif
+
+struct tk_bufpool;
+
+/* buffer handle, queues carry the pointer instead of the payload */
+struct tk_buf
+{
+    struct tk_bufpool *pool;
+    void *data;    /* TK_BUFPOOL_ALIGN aligned, pool->buf_size bytes */
+    uint32_t len;  /* bytes used, set by the producer */
+    uint32_t ref;  /* atomic, the buffer is freed when it drops to 0 */
+    uint32_t next; /* free list link, index + 1 */
+};
+typedef struct tk_buf *tk_buf_t;
+
+struct tk_bufpool
+{
+    uint64_t free_head; /* (tag << 32) | (index + 1), tag defeats ABA */
+    uint32_t free_num;
+    uint32_t buf_size;  /* rounded up to TK_BUFPOOL_ALIGN */
+    uint32_t buf_num;
+    struct tk_buf *bufs;
+    uint8_t *data_pool;
+    void *mem_pool;
+};
+typedef struct tk_bufpool *tk_bufpool_t;
+
+/* pool size for buf_num buffers of buf_size bytes, including headers and alignment */
+#define TK_BUFPOOL_BUF_SIZE(buf_size) (((buf_size) + TK_BUFPOOL_ALIGN - 1) & ~(TK_BUFPOOL_ALIGN - 1))
+#define TK_BUFPOOL_POOL_SIZE(buf_size, buf_num) \
+    ((buf_num) * (TK_BUFPOOL_BUF_SIZE(buf_size) + sizeof(struct tk_buf)) + TK_BUFPOOL_ALIGN)
+
+#ifdef TK_BUFPOOL_USING_CREATE
+struct tk_bufpool *tk_bufpool_create(uint32_t buf_size, uint32_t buf_num);
+bool tk_bufpool_delete(struct tk_bufpool *pool);
+#endif /* TK_BUFPOOL_USING_CREATE */
+
+bool tk_bufpool_init(struct tk_bufpool *pool, void *mempool, uint32_t pool_size, uint32_t buf_size);
+bool tk_bufpool_detach(struct tk_bufpool *pool);
+struct tk_buf *tk_bufpool_alloc(struct tk_bufpool *pool);
+bool tk_bufpool_retain(struct tk_buf *buf, uint32_t count);
+bool tk_bufpool_release(struct tk_buf *buf);
+uint32_t tk_bufpool_free_num(struct tk_bufpool *pool);
+#endif /* TOOLKIT_USING_BUFPOOL */
+
+/* toolkit loop */
+#ifdef TOOLKIT_USING_LOOP
+#ifndef TK_LOOP_MAX_EVENTS
+#define TK_LOOP_MAX_EVENTS 32
+#endif /* TK_LOOP_MAX_EVENTS */
+
+struct tk_loop;
+
+struct tk_loop_watch
+{
+    uint8_t type;
+    uint8_t option;
+    int fd;
+    uint32_t event_set;
+    uint32_t recved;
+    uint32_t revents;
+    void *source;
+    struct tk_loop *loop;
+    void *user_data;
+    void (*callback)(struct tk_loop_watch *watch);
+};
+typedef struct tk_loop_watch *tk_loop_watch_t;
+
+struct tk_loop
+{
+    bool running;
+    int epoll_fd;
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_FD)
+    struct tk_loop_watch timer_watch;
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_FD) */
+};
+typedef struct tk_loop *tk_loop_t;
+
+#ifdef TK_LOOP_USING_CREATE
+struct tk_loop *tk_loop_create(void);
+bool tk_loop_delete(struct tk_loop *loop);
+#endif /* TK_LOOP_USING_CREATE */
+
+bool tk_loop_init(struct tk_loop *loop);
+bool tk_loop_detach(struct tk_loop *loop);
+bool tk_loop_add_fd(struct tk_loop *loop, struct tk_loop_watch *watch, int fd, uint32_t events,
+                    void (*callback)(struct tk_loop_watch *watch));
+#if defined(TOOLKIT_USING_QUEUE) && defined(TK_QUEUE_USING_FD)
+bool tk_loop_add_queue(struct tk_loop *loop, struct tk_loop_watch *watch, struct tk_queue *queue,
+                       void (*callback)(struct tk_loop_watch *watch));
+#endif /* defined(TOOLKIT_USING_QUEUE) && defined(TK_QUEUE_USING_FD) */
+#if defined(TOOLKIT_USING_EVENT) && defined(TK_EVENT_USING_FD)
+bool tk_loop_add_event(struct tk_loop *loop, struct tk_loop_watch *watch, struct tk_event *event,
+                       uint32_t event_set, uint8_t option,
+                       void (*callback)(struct tk_loop_watch *watch));
+#endif /* defined(TOOLKIT_USING_EVENT) && defined(TK_EVENT_USING_FD) */
+bool tk_loop_remove(struct tk_loop_watch *watch);
+int tk_loop_run_once(struct tk_loop *loop, int timeout_ms);
+bool tk_loop_run(struct tk_loop *loop);
+bool tk_loop_stop(struct tk_loop *loop);
+#endif /* TOOLKIT_USING_LOOP */
+
+/* toolkit runtime */
+#ifdef TOOLKIT_USING_RUNTIME
+#ifndef TK_RUNTIME_DEQUE_SIZE
+#define TK_RUNTIME_DEQUE_SIZE 1024
+#endif /* TK_RUNTIME_DEQUE_SIZE */
+#ifndef TK_RUNTIME_INBOX_SIZE
+#define TK_RUNTIME_INBOX_SIZE 1024
+#endif /* TK_RUNTIME_INBOX_SIZE */
+#ifndef TK_RUNTIME_BATCH_SIZE
+#define TK_RUNTIME_BATCH_SIZE 32
+#endif /* TK_RUNTIME_BATCH_SIZE */
+#ifndef TK_RUNTIME_IDLE_MS
+#define TK_RUNTIME_IDLE_MS 10
+#endif /* TK_RUNTIME_IDLE_MS */
+#ifndef TK_TIMER_TICK_PER_SECOND
+#define TK_TIMER_TICK_PER_SECOND 1000
+#endif /* TK_TIMER_TICK_PER_SECOND */
+#if (TK_RUNTIME_DEQUE_SIZE & (TK_RUNTIME_DEQUE_SIZE - 1)) != 0
+#error "TK_RUNTIME_DEQUE_SIZE must be a power of 2"
+#endif
+#if TK_RUNTIME_INBOX_SIZE > 4095
+#error "TK_RUNTIME_INBOX_SIZE is limited by the uint16_t pool size of tk_queue"
+#endif
+
+struct tk_runtime;
+typedef struct tk_runtime *tk_runtime_t;
+
+struct tk_runtime *tk_runtime_create(uint16_t worker_num, uint32_t (*get_tick_func)(void));
+bool tk_runtime_delete(struct tk_runtime *runtime);
+bool tk_runtime_submit(struct tk_runtime *runtime, uint16_t worker_id, void (*fn)(void *arg), void *arg);
+bool tk_spawn(void (*fn)(void *arg), void *arg);
+int tk_runtime_worker_id(void);
+uint16_t tk_runtime_worker_num(struct tk_runtime *runtime);
+#endif /* TOOLKIT_USING_RUNTIME */
+
+/* toolkit pipeline */
+#ifdef TOOLKIT_USING_PIPELINE
+#ifndef TK_PIPELINE_MAX_STAGES
+#define TK_PIPELINE_MAX_STAGES 8
+#endif /* TK_PIPELINE_MAX_STAGES */
+#ifndef TK_PIPELINE_LINK_SIZE
+#define TK_PIPELINE_LINK_SIZE 1024
+#endif /* TK_PIPELINE_LINK_SIZE */
+#ifndef TK_PIPELINE_BATCH_SIZE
+#define TK_PIPELINE_BATCH_SIZE 32
+#endif /* TK_PIPELINE_BATCH_SIZE */
+#ifndef TK_PIPELINE_SPIN
+#define TK_PIPELINE_SPIN 100
+#endif /* TK_PIPELINE_SPIN */
+#if (TK_PIPELINE_LINK_SIZE & (TK_PIPELINE_LINK_SIZE - 1)) != 0
+#error "TK_PIPELINE_LINK_SIZE must be a power of 2"
+#endif
+#if TK_PIPELINE_BATCH_SIZE > TK_PIPELINE_LINK_SIZE
+#error "TK_PIPELINE_BATCH_SIZE must not exceed TK_PIPELINE_LINK_SIZE"
+#endif
+
+struct tk_pipeline;
+typedef struct tk_pipeline *tk_pipeline_t;
+
+/* handles num contiguous input elements, writes at most num elements to out (NULL for the last stage) and returns how many */
+typedef uint32_t (*tk_pipeline_stage_fn)(void *user_data, const void *in, void *out, uint32_t num);
+
+/* per stage counters, written by the stage thread */
+struct tk_pipeline_stats
+{
+    uint64_t in_num;    /* elements taken from the input link */
+    uint64_t out_num;   /* elements handed to the output link */
+    uint64_t batches;   /* stage function calls */
+    uint64_t occupancy; /* sum of input link length seen at each batch, divide by batches */
+    uint64_t starved;   /* parks on an empty input link */
+    uint64_t blocked;   /* parks on a full output link (backpressure) */
+    uint64_t busy_ns;   /* time spent in the stage function */
+    uint32_t link_len;  /* current input link length */
+};
+
+struct tk_pipeline *tk_pipeline_create(uint16_t in_size);
+bool tk_pipeline_delete(struct tk_pipeline *pipeline);
+bool tk_pipeline_add_stage(struct tk_pipeline *pipeline, tk_pipeline_stage_fn fn, void *user_data,
+                           uint16_t out_size, int cpu);
+bool tk_pipeline_start(struct tk_pipeline *pipeline);
+bool tk_pipeline_stop(struct tk_pipeline *pipeline);
+bool tk_pipeline_push(struct tk_pipeline *pipeline, const void *pval);
+uint32_t tk_pipeline_push_multi(struct tk_pipeline *pipeline, const void *pval, uint32_t num);
+bool tk_pipeline_get_stats(struct tk_pipeline *pipeline, uint16_t stage, struct tk_pipeline_stats *stats);
+#endif /* TOOLKIT_USING_PIPELINE */
+
+/* toolkit log */
+#ifdef TOOLKIT_USING_LOG
+#ifndef TOOLKIT_USING_QUEUE
+#error "TOOLKIT_USING_LOG needs TOOLKIT_USING_QUEUE"
+#endif
+#ifndef TK_LOG_RING_SIZE
+#define TK_LOG_RING_SIZE 512
+#endif /* TK_LOG_RING_SIZE */
+#ifndef TK_LOG_MAX_ARGS
+#define TK_LOG_MAX_ARGS 6
+#endif /* TK_LOG_MAX_ARGS */
+#ifndef TK_LOG_TEXT_SIZE
+#define TK_LOG_TEXT_SIZE 32
+#endif /* TK_LOG_TEXT_SIZE */
+#ifndef TK_LOG_BATCH_SIZE
+#define TK_LOG_BATCH_SIZE 64
+#endif /* TK_LOG_BATCH_SIZE */
+#ifndef TK_LOG_FLUSH_MS
+#define TK_LOG_FLUSH_MS 10
+#endif /* TK_LOG_FLUSH_MS */
+#if TK_LOG_RING_SIZE * (16 + 8 * TK_LOG_MAX_ARGS + TK_LOG_TEXT_SIZE) > 65535
+#error "TK_LOG_RING_SIZE records exceed the uint16_t pool size of tk_queue"
+#endif
+
+/* one per TK_LOG call site, argument types are parsed from fmt on first use */
+struct tk_log_site
+{
+    const char *fmt;
+    bool ready;
+    uint8_t argc;
+    uint8_t types[TK_LOG_MAX_ARGS];
+};
+
+/* binary record written by the calling thread, formatted by the log thread */
+struct tk_log_record
+{
+    const struct tk_log_site *site;
+    uint64_t time;
+    uint64_t args[TK_LOG_MAX_ARGS];
+    char text[TK_LOG_TEXT_SIZE];
+};
+
+bool tk_log_start(int fd, bool keep_fresh);
+bool tk_log_stop(void);
+bool tk_log_flush(void);
+bool tk_log_set_time_func(uint64_t (*time_func)(void), uint64_t units_per_second);
+uint64_t tk_log_lost(void);
+bool tk_log_write(struct tk_log_site *site, ...);
+/* FMT must be a string literal, the dead printf call only lets the compiler check the arguments */
+#define TK_LOG(FMT, ...)                                                   \
+    do                                                                     \
+    {                                                                      \
+        static struct tk_log_site _tk_log_site = {FMT, false, 0, {0}};     \
+        if (0)                                                             \
+            printf(FMT, ##__VA_ARGS__);                                    \
+        tk_log_write(&_tk_log_site, ##__VA_ARGS__);                        \
+    } while (0)
+#endif /* TOOLKIT_USING_LOG */
+
+/* toolkit coroutine */
+#ifdef TOOLKIT_USING_COROUTINE
+typedef enum
+{
+    TK_CO_STATE_IDLE = 0,
+    TK_CO_STATE_READY,
+    TK_CO_STATE_RUNNING,
+    TK_CO_STATE_SLEEP,
+    TK_CO_STATE_WAIT_EVENT,
+    TK_CO_STATE_WAIT_QUEUE,
+    TK_CO_STATE_DONE,
+} tk_co_state;
+
+/* coroutine function return value */
+#define TK_CO_YIELDED 0
+#define TK_CO_WAITING 1
+#define TK_CO_EXITED  2
+
+struct tk_co
+{
+    uint16_t line;
+    uint8_t state;
+    uint8_t option;
+    uint32_t value;
+    uint32_t recved;
+    void *wait_obj;
+    struct tk_co *next;
+    uint8_t (*entry)(struct tk_co *co);
+    void *user_data;
+#ifdef TOOLKIT_USING_TIMER
+    struct tk_co *heap_child; /* sleep heap, next links the siblings while sleeping */
+    struct tk_co *heap_prev;  /* parent when first child, otherwise left sibling */
+#endif /* TOOLKIT_USING_TIMER */
+};
+typedef struct tk_co *tk_co_t;
+
+/* stackless coroutine macros, local variables do not survive an await */
+/* awaits that test first and then wait are entered from the previous statement, mark it for -Wimplicit-fallthrough */
+#if defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define TK_CO_FALLTHROUGH __attribute__((fallthrough))
+#endif
+#endif
+#ifndef TK_CO_FALLTHROUGH
+#define TK_CO_FALLTHROUGH ((void)0)
+#endif /* TK_CO_FALLTHROUGH */
+#define TK_CO_FUNC(name) uint8_t name(struct tk_co *co)
+#define TK_CO_BEGIN()     \
+    switch (co->line)     \
+    {                     \
+    case 0:
+#define TK_CO_END()  \
+    }                \
+    co->line = 0;    \
+    return TK_CO_EXITED
+#define TK_CO_YIELD()           \
+    do                          \
+    {                           \
+        co->line = __LINE__;    \
+        return TK_CO_YIELDED;   \
+    case __LINE__:;             \
+    } while (0)
+#define TK_CO_EXIT()          \
+    do                        \
+    {                         \
+        co->line = 0;         \
+        return TK_CO_EXITED;  \
+    } while (0)
+
+bool tk_co_init(struct tk_co *co, uint8_t (*entry)(struct tk_co *co), void *user_data);
+bool tk_co_start(struct tk_co *co);
+bool tk_co_cancel(struct tk_co *co);
+uint32_t tk_co_schedule(void);
+bool tk_co_get_next_tick(uint32_t *tick);
+
+#ifdef TOOLKIT_USING_TIMER
+void tk_co_wait_timer(struct tk_co *co, uint32_t ms);
+#define TK_AWAIT_TIMER(ms)               \
+    do                                   \
+    {                                    \
+        tk_co_wait_timer(co, (ms));      \
+        co->line = __LINE__;             \
+        return TK_CO_WAITING;            \
+    case __LINE__:;                      \
+    } while (0)
+#endif /* TOOLKIT_USING_TIMER */
+
+#ifdef TOOLKIT_USING_EVENT
+void tk_co_wait_event(struct tk_co *co, struct tk_event *event, uint32_t event_set, uint8_t option);
+void tk_co_notify_event(struct tk_event *event);
+#define TK_AWAIT_EVENT(event, event_set, option)                                  \
+    do                                                                            \
+    {                                                                             \
+        TK_CO_FALLTHROUGH;                                                        \
+    case __LINE__:                                                                \
+        if (tk_event_recv((event), (event_set), (option), &co->recved) == false)  \
+        {                                                                         \
+            co->line = __LINE__;                                                  \
+            tk_co_wait_event(co, (event), (event_set), (option));                 \
+            return TK_CO_WAITING;                                                 \
+        }                                                                         \
+    } while (0)
+#endif /* TOOLKIT_USING_EVENT */
+
+#ifdef TOOLKIT_USING_QUEUE
+void tk_co_wait_queue(struct tk_co *co, struct tk_queue *queue);
+void tk_co_notify_queue(struct tk_queue *queue);
+#define TK_AWAIT_QUEUE(queue, out)                \
+    do                                            \
+    {                                             \
+        TK_CO_FALLTHROUGH;                        \
+    case __LINE__:                                \
+        if (tk_queue_pop((queue), (out)) == false) \
+        {                                         \
+            co->line = __LINE__;                  \
+            tk_co_wait_queue(co, (queue));        \
+            return TK_CO_WAITING;                 \
+        }                                         \
+    } while (0)
+#endif /* TOOLKIT_USING_QUEUE */
+#endif /* TOOLKIT_USING_COROUTINE */
+
 #endif /* __TOOLKIT_H_ */
@@ -25,6 +25,29 @@
 * Date           Author       Notes
 * 2020-01-29     zhangran     the first version
 * 2020-01-31     zhangran     add event define switch
+* 2026-10-19     zhangran     add eventfd switch (linux only)
+* 2026-10-19     zhangran     add timerfd switch (linux only)
+* 2026-10-19     zhangran     add loop define switch
+* 2026-10-19     zhangran     add runtime define switch
+* 2026-10-19     zhangran     add coroutine define switch
+* 2026-10-19     zhangran     add stats define switch
+* 2026-10-19     zhangran     add timer trace switch
+* 2026-10-19     zhangran     add priority queue define switch
+* 2026-10-19     zhangran     add queue journal switch (linux only)
+* 2026-10-19     zhangran     add log define switch
+* 2026-10-19     zhangran     add bus define switch
+* 2026-10-19     zhangran     add timer table switch
+* 2026-10-19     zhangran     add timer table simd switch
+* 2026-10-19     zhangran     add timer simulation switch
+* 2026-10-19     zhangran     add timer batch callback switch
+* 2026-10-19     zhangran     add timer group switch
+* 2026-10-19     zhangran     rename group reclaim batch to TK_TIMER_RECLAIM_BATCH
+* 2026-10-19     zhangran     add queue ttl switch
+* 2026-10-19     zhangran     add queue adaptive batch switch
+* 2026-10-19     zhangran     add mailbox define switch
+* 2026-10-19     zhangran     add buffer pool define switch
+* 2026-10-19     zhangran     add pipeline define switch
+* 2026-10-19     zhangran     add event wait any switch (linux only)
 */
 #ifndef __TOOLKIT_CFG_H_
 #define __TOOLKIT_CFG_H_
@@ -32,18 +55,93 @@
 /* toolkit Configuration item */
 #define TOOLKIT_USING_ASSERT
 #define TOOLKIT_USING_QUEUE
+//#define TOOLKIT_USING_PQUEUE
 #define TOOLKIT_USING_TIMER
 #define TOOLKIT_USING_EVENT
+//#define TOOLKIT_USING_BUS
+//#define TOOLKIT_USING_MAILBOX
+//#define TOOLKIT_USING_BUFPOOL
+//#define TOOLKIT_USING_LOOP
+//#define TOOLKIT_USING_RUNTIME
+//#define TOOLKIT_USING_PIPELINE
+//#define TOOLKIT_USING_COROUTINE
+//#define TOOLKIT_USING_LOG
+//#define TOOLKIT_USING_STATS
+
+/* toolkit stats Configuration item */
+//#define TK_STATS_HIST_SIZE 16
 
 /* toolkit queue Configuration item */
 #define TK_QUEUE_USING_CREATE
+//#define TK_QUEUE_USING_FD
+//#define TK_QUEUE_USING_JOURNAL
+//#define TK_QUEUE_JOURNAL_SEGMENT_SIZE (64UL * 1024 * 1024)
+//#define TK_QUEUE_USING_TTL
+//#define TK_QUEUE_USING_BATCH
+//#define TK_QUEUE_BATCH_WAKES_PER_TICK 16
+
+/* toolkit priority queue Configuration item */
+//#define TK_PQUEUE_USING_CREATE
+//#define TK_PQUEUE_MAX_BANDS 8
 
 /* toolkit timer Configuration item */
 #define TK_TIMER_USING_CREATE
+//#define TK_TIMER_RECLAIM_BATCH 1024
 //#define TK_TIMER_USING_INTERVAL
 #define TK_TIMER_USING_TIMEOUT_CALLBACK
+//#define TK_TIMER_USING_BATCH_CALLBACK
+//#define TK_TIMER_BATCH_SIZE 256
+//#define TK_TIMER_USING_GROUP
+//#define TK_TIMER_USING_FD
+//#define TK_TIMER_TICK_PER_SECOND 1000
+//#define TK_TIMER_USING_TLS
+//#define TK_TIMER_USING_TABLE
+//#define TK_TIMER_USING_SIMD
+//#define TK_TIMER_USING_SIM
+//#define TK_TIMER_SIM_MAX_TABLES 8
+//#define TK_TIMER_USING_TRACE
+//#define TK_TIMER_TRACE_SIZE 1024
+//#define TK_TIMER_TRACE_SAMPLE 128
 
 /* toolkit event Configuration item */
 #define TK_EVENT_USING_CREATE
+//#define TK_EVENT_USING_FD
+//#define TK_EVENT_USING_WAIT
+//#define TK_EVENT_WAIT_MAX 256
+
+/* toolkit bus Configuration item (needs TOOLKIT_USING_EVENT) */
+//#define TK_BUS_USING_CREATE
+//#define TK_BUS_MAX_SUBSCRIBERS 32
+
+/* toolkit mailbox Configuration item */
+//#define TK_MAILBOX_USING_CREATE
+
+/* toolkit buffer pool Configuration item */
+//#define TK_BUFPOOL_USING_CREATE
+//#define TK_BUFPOOL_ALIGN 64
+
+/* toolkit loop Configuration item (linux only) */
+//#define TK_LOOP_USING_CREATE
+//#define TK_LOOP_MAX_EVENTS 32
+
+/* toolkit runtime Configuration item (linux only, needs TOOLKIT_USING_QUEUE) */
+//#define TK_RUNTIME_USING_AFFINITY
+//#define TK_RUNTIME_DEQUE_SIZE 1024
+//#define TK_RUNTIME_INBOX_SIZE 1024
+//#define TK_RUNTIME_BATCH_SIZE 32
+//#define TK_RUNTIME_IDLE_MS 10
+
+/* toolkit pipeline Configuration item (linux only) */
+//#define TK_PIPELINE_MAX_STAGES 8
+//#define TK_PIPELINE_LINK_SIZE 1024
+//#define TK_PIPELINE_BATCH_SIZE 32
+//#define TK_PIPELINE_SPIN 100
+
+/* toolkit log Configuration item (linux only, needs TOOLKIT_USING_QUEUE) */
+//#define TK_LOG_RING_SIZE 512
+//#define TK_LOG_MAX_ARGS 6
+//#define TK_LOG_TEXT_SIZE 32
+//#define TK_LOG_BATCH_SIZE 64
+//#define TK_LOG_FLUSH_MS 10
 
 #endif /* __TOOLKIT_CFG_H_ */
@@ -0,0 +1,88 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <stdio.h>
+#include "toolkit.h"
+
+#define FRAME_SIZE (16 * 1024)
+#define FRAME_NUM 4
+
+/* ͼ֡أ̬ʽ */
+struct tk_bufpool frame_pool;
+uint8_t frame_mem[TK_BUFPOOL_POOL_SIZE(FRAME_SIZE, FRAME_NUM)];
+
+/* ߸һУֻ滺ָ */
+struct tk_queue encode_queue;
+struct tk_queue preview_queue;
+struct tk_buf *encode_pool[FRAME_NUM];
+struct tk_buf *preview_pool[FRAME_NUM];
+
+int main(int argc, char *argv[])
+{
+    struct tk_buf *frame;
+    uint32_t i;
+
+    tk_bufpool_init(&frame_pool, frame_mem, sizeof(frame_mem), FRAME_SIZE);
+    tk_queue_init(&encode_queue, encode_pool, sizeof(encode_pool), sizeof(struct tk_buf *), false);
+    tk_queue_init(&preview_queue, preview_pool, sizeof(preview_pool), sizeof(struct tk_buf *), false);
+    printf("frame pool: %u buffers\n", tk_bufpool_free_num(&frame_pool));
+
+    for (i = 0; i < 6; i++)
+    {
+        /* ֱд뻺ûплʱ֡ */
+        frame = tk_bufpool_alloc(&frame_pool);
+        if (frame == NULL)
+        {
+            printf("frame %u dropped\n", i);
+            continue;
+        }
+        memset(frame->data, (int)i, FRAME_SIZE);
+        frame->len = FRAME_SIZE;
+        /* 㲥ߣÿ߳һ */
+        tk_bufpool_retain(frame, 1);
+        tk_queue_push(&encode_queue, &frame);
+        tk_queue_push(&preview_queue, &frame);
+    }
+
+    /* Ԥȴ꣬Ա */
+    while (tk_queue_pop(&preview_queue, &frame))
+        tk_bufpool_release(frame);
+    printf("after preview: %u free\n", tk_bufpool_free_num(&frame_pool));
+
+    /* ͷһã黹 */
+    while (tk_queue_pop(&encode_queue, &frame))
+    {
+        printf("encode frame %u, %u bytes\n", ((uint8_t *)frame->data)[0], frame->len);
+        tk_bufpool_release(frame);
+    }
+    printf("after encode: %u free\n", tk_bufpool_free_num(&frame_pool));
+    tk_bufpool_detach(&frame_pool);
+
+    getchar();
+    return 0;
+}
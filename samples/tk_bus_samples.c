@@ -0,0 +1,99 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <stdio.h>
+#include "toolkit.h"
+
+#define BUS_MSG_MAX 8
+
+struct quote
+{
+    uint32_t id;
+    int32_t price;
+};
+
+/* ߾̬ʽĬģʽ(Ķ߶ǰٷ) */
+struct tk_bus quote_bus;
+/* ߻ */
+struct quote quote_pool[BUS_MSG_MAX];
+
+/* ߹һ¼ռһ¼λ */
+struct tk_event quote_event;
+#define fast_flag (1 << 0)
+#define slow_flag (1 << 1)
+struct tk_bus_sub fast_sub;
+struct tk_bus_sub slow_sub;
+
+int main(int argc, char *argv[])
+{
+    struct quote quote;
+    uint32_t recved;
+    uint32_t i;
+
+    tk_event_init(&quote_event);
+    tk_bus_init(&quote_bus, quote_pool, sizeof(quote_pool), sizeof(struct quote), false);
+    tk_bus_subscribe(&quote_bus, &fast_sub, &quote_event, fast_flag);
+    tk_bus_subscribe(&quote_bus, &slow_sub, &quote_event, slow_flag);
+
+    for (i = 0; i < 12; i++)
+    {
+        quote.id = i;
+        quote.price = 100 + (int32_t)i;
+        /* һֱ󷢲ʧ */
+        if (tk_bus_publish(&quote_bus, &quote) == false)
+            printf("publish %u failed, slow subscriber pending %u\n", i, tk_bus_pending(&slow_sub));
+
+        /* 충ÿյ¼Ϣ */
+        if (tk_event_recv(&quote_event, fast_flag, TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR, &recved))
+        {
+            while (tk_bus_read(&fast_sub, &quote))
+                printf("fast: quote %u price %d\n", quote.id, quote.price);
+        }
+    }
+
+    /* ߶ȫϢ߿Լ */
+    while (tk_bus_read(&slow_sub, &quote))
+        printf("slow: quote %u price %d\n", quote.id, quote.price);
+    tk_bus_detach(&quote_bus);
+
+    /* ̬ʽģʽߣʱɵϢ */
+    struct tk_bus *fresh_bus = tk_bus_create(sizeof(struct quote), 4, true);
+    tk_bus_subscribe(fresh_bus, &slow_sub, NULL, 0);
+    for (i = 0; i < 10; i++)
+    {
+        quote.id = i;
+        tk_bus_publish(fresh_bus, &quote);
+    }
+    printf("fresh: lost %u\n", tk_bus_lost(&slow_sub));
+    while (tk_bus_read(&slow_sub, &quote))
+        printf("fresh: quote %u\n", quote.id);
+    tk_bus_delete(fresh_bus);
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * ˵
+ *      ջЭ̣toolkit_cfg.hдTOOLKIT_USING_COROUTINE
+ *      Эÿ5tickqueueѹ1ݣѹ5֮event1_flag1
+ *      Э̵ȴݣȡ5ݺȴevent1_flag1
+ *      ЭֻڵȴʱűУÿЭֻռһstruct tk_co
+ *
+ * ע⣺
+ *      Э̺еľֲڵȴ󲻻ᱣҪ״̬user_data
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     zhangran     the first version
+ * 2026-10-19     zhangran     build warning-clean with -Wall -Wextra
+ */
+
+#include <stdio.h>
+#include "toolkit.h"
+
+uint32_t tick = 0;
+/* ȡϵͳtickص */
+uint32_t get_sys_tick(void)
+{
+    return tick;
+}
+
+/* о */
+struct tk_queue *queue = NULL;
+/* ¼ */
+struct tk_event event1;
+/* ¼־ */
+#define event1_flag1 (1 << 1)
+
+/* Э̾ */
+struct tk_co producer_co;
+struct tk_co consumer_co;
+
+/* Э״̬ */
+struct session
+{
+    uint32_t count;
+    uint32_t value;
+};
+struct session producer_session;
+struct session consumer_session;
+
+/* Э */
+TK_CO_FUNC(producer)
+{
+    struct session *s = co->user_data;
+    TK_CO_BEGIN();
+    for (s->count = 0; s->count < 5; s->count++)
+    {
+        TK_AWAIT_TIMER(5);
+        tk_queue_push(queue, &s->count);
+        printf("producer: push %u tick:%u\n", s->count, get_sys_tick());
+    }
+    tk_event_send(&event1, event1_flag1);
+    TK_CO_END();
+}
+
+/* Э */
+TK_CO_FUNC(consumer)
+{
+    struct session *s = co->user_data;
+    TK_CO_BEGIN();
+    for (s->count = 0; s->count < 5; s->count++)
+    {
+        TK_AWAIT_QUEUE(queue, &s->value);
+        printf("consumer: pop %u tick:%u\n", s->value, get_sys_tick());
+    }
+    TK_AWAIT_EVENT(&event1, event1_flag1, TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR);
+    printf("consumer: recv event 0x%x tick:%u\n", co->recved, get_sys_tick());
+    TK_CO_END();
+}
+
+int main(void)
+{
+    /* Э̵Ķʱȴʹʱtick */
+    tk_timer_func_init(get_sys_tick);
+
+    queue = tk_queue_create(sizeof(uint32_t), 4, false);
+    tk_event_init(&event1);
+
+    tk_co_init(&consumer_co, consumer, &consumer_session);
+    tk_co_init(&producer_co, producer, &producer_session);
+    tk_co_start(&consumer_co);
+    tk_co_start(&producer_co);
+
+    while (consumer_co.state != TK_CO_STATE_DONE)
+    {
+        /* Э̵ */
+        tk_co_schedule();
+        tick++;
+    }
+
+    tk_queue_delete(queue);
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * ˵
+ *      ¼ѭ(Linux)toolkit_cfg.hдTOOLKIT_USING_LOOPTK_QUEUE_USING_FD
+ *      TK_TIMER_USING_FDTK_EVENT_USING_FD
+ *      ʱtimer1ÿ100msqueueѹ1ݣзǿʱ¼ѭصȡ
+ *      timer110γʱevent1_flag1¼ֹͣ¼ѭ
+ *      ѭtk_timer_loop_handlerҲѯк¼¿ʱ߳epoll
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     zhangran     the first version
+ */
+
+#include <stdio.h>
+#include "toolkit.h"
+
+/* ¼ѭ */
+struct tk_loop loop;
+/* о */
+struct tk_queue *queue = NULL;
+/* ¼ */
+struct tk_event event1;
+/* ¼־ */
+#define event1_flag1 (1 << 1)
+
+/* Ӷ */
+struct tk_loop_watch queue_watch;
+struct tk_loop_watch event_watch;
+
+/* ʱʱص */
+void timer1_timeout_callback(struct tk_timer *timer)
+{
+    static uint32_t count = 0;
+    count++;
+    tk_queue_push(queue, &count);
+    if (count == 10)
+        tk_event_send(&event1, event1_flag1);
+}
+
+/* зǿջص */
+void queue_callback(struct tk_loop_watch *watch)
+{
+    uint32_t value;
+    while (tk_queue_pop((struct tk_queue *)watch->source, &value))
+        printf("queue_callback: pop %u tick:%u\n", value, tk_timer_fd_get_tick());
+}
+
+/* ¼ص */
+void event_callback(struct tk_loop_watch *watch)
+{
+    printf("event_callback: recv event 0x%x, stop loop\n", watch->recved);
+    tk_loop_stop(&loop);
+}
+
+int main(int argc, char *argv[])
+{
+    struct tk_timer *timer1;
+
+    /* ʹCLOCK_MONOTONICΪtickڴ¼ѭǰʼ */
+    tk_timer_func_init(tk_timer_fd_get_tick);
+    tk_loop_init(&loop);
+
+    queue = tk_queue_create(sizeof(uint32_t), 16, false);
+    tk_event_init(&event1);
+
+    tk_loop_add_queue(&loop, &queue_watch, queue, queue_callback);
+    tk_loop_add_event(&loop, &event_watch, &event1, event1_flag1,
+                      TK_EVENT_OPTION_OR | TK_EVENT_OPTION_CLEAR, event_callback);
+
+    /* ʱ1ѭģʽ100tickʱ */
+    timer1 = tk_timer_create(timer1_timeout_callback);
+    tk_timer_start(timer1, TIMER_MODE_LOOP, 100);
+
+    tk_loop_run(&loop);
+
+    tk_loop_remove(&queue_watch);
+    tk_loop_remove(&event_watch);
+    tk_timer_delete(timer1);
+    tk_queue_delete(queue);
+    tk_event_release_fd(&event1);
+    tk_loop_detach(&loop);
+    return 0;
+}
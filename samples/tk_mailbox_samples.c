@@ -0,0 +1,101 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <stdio.h>
+#include <pthread.h>
+#include "toolkit.h"
+
+struct sensor
+{
+    uint32_t seq;
+    float temperature;
+    float humidity;
+};
+
+/* ̬ʽ */
+struct tk_mailbox sensor_mailbox;
+/* 仺дд */
+uint8_t sensor_pool[TK_MAILBOX_POOL_SIZE(sizeof(struct sensor))];
+
+static volatile bool running = true;
+
+/* ֻ̣߳ݱ仯ʱ */
+static void *display_thread(void *param)
+{
+    struct sensor sensor;
+    uint32_t version = 0;
+    uint32_t shown = 0;
+    (void)param;
+    while (running)
+    {
+        if (tk_mailbox_read(&sensor_mailbox, &sensor, &version) == false)
+            continue;
+        shown++;
+    }
+    printf("display: shown %u updates, last seq %u version %u\n", shown, sensor.seq, version);
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    struct sensor sensor = {0};
+    uint32_t version = 0;
+    pthread_t thread;
+
+    tk_mailbox_init(&sensor_mailbox, sensor_pool, sizeof(sensor_pool), sizeof(struct sensor));
+    /* δдʱȡʧ */
+    if (tk_mailbox_read(&sensor_mailbox, &sensor, NULL) == false)
+        printf("mailbox empty\n");
+
+    pthread_create(&thread, NULL, display_thread, NULL);
+    /* дߣһֱдֵᱻ */
+    for (uint32_t i = 1; i <= 100000; i++)
+    {
+        sensor.seq = i;
+        sensor.temperature = 20.0f + (float)(i % 100) / 10.0f;
+        sensor.humidity = 50.0f;
+        tk_mailbox_write(&sensor_mailbox, &sensor);
+    }
+    running = false;
+    pthread_join(thread, NULL);
+
+    /* 汾δ仯ʱֱӷfalse */
+    tk_mailbox_read(&sensor_mailbox, &sensor, &version);
+    printf("main: seq %u version %u\n", sensor.seq, version);
+    if (tk_mailbox_read(&sensor_mailbox, &sensor, &version) == false)
+        printf("main: unchanged\n");
+    tk_mailbox_detach(&sensor_mailbox);
+
+    /* ̬ʽ4KB */
+    struct tk_mailbox *config_mailbox = tk_mailbox_create(4096);
+    printf("config mailbox size %u\n", tk_mailbox_size(config_mailbox));
+    tk_mailbox_delete(config_mailbox);
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <stdio.h>
+#include "toolkit.h"
+
+/* ԭʼ */
+struct packet
+{
+    uint32_t id;
+    uint16_t sensor;
+    uint16_t raw;
+};
+
+/* Ķ */
+struct reading
+{
+    uint32_t id;
+    uint16_t sensor;
+    float value;
+};
+
+static const char *stage_names[] = {"decode", "enrich", "aggregate", "emit"};
+static float totals[4];
+static uint32_t emitted = 0;
+
+/* 룺ԭʼֵΪÿδһԪ */
+static uint32_t decode(void *user_data, const void *in, void *out, uint32_t num)
+{
+    const struct packet *packets = in;
+    struct reading *readings = out;
+    (void)user_data;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        readings[i].id = packets[i].id;
+        readings[i].sensor = packets[i].sensor;
+        readings[i].value = (float)packets[i].raw / 10.0f;
+    }
+    return num;
+}
+
+/* ȫÿУ׼ƫ */
+static uint32_t enrich(void *user_data, const void *in, void *out, uint32_t num)
+{
+    const float *offset = user_data;
+    const struct reading *src = in;
+    struct reading *dst = out;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        dst[i] = src[i];
+        dst[i].value += offset[src[i].sensor];
+    }
+    return num;
+}
+
+/* ۺϣ̵ĶֵΪ */
+static uint32_t aggregate(void *user_data, const void *in, void *out, uint32_t num)
+{
+    const struct reading *src = in;
+    struct reading *dst = out;
+    uint32_t len = 0;
+    (void)user_data;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (src[i].value < 100.0f)
+            dst[len++] = src[i];
+    }
+    return len;
+}
+
+/* һ׶û·outΪNULL */
+static uint32_t emit(void *user_data, const void *in, void *out, uint32_t num)
+{
+    const struct reading *readings = in;
+    (void)user_data;
+    (void)out;
+    for (uint32_t i = 0; i < num; i++)
+        totals[readings[i].sensor] += readings[i].value;
+    emitted += num;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const float offset[4] = {0.5f, -0.5f, 1.0f, 0.0f};
+    struct tk_pipeline_stats stats;
+    struct packet packet;
+
+    /* ÿ׶һ̣߳ΰ󶨵CPU0~3 */
+    struct tk_pipeline *pipeline = tk_pipeline_create(sizeof(struct packet));
+    tk_pipeline_add_stage(pipeline, decode, NULL, sizeof(struct reading), 0);
+    tk_pipeline_add_stage(pipeline, enrich, (void *)offset, sizeof(struct reading), 1);
+    tk_pipeline_add_stage(pipeline, aggregate, NULL, sizeof(struct reading), 2);
+    tk_pipeline_add_stage(pipeline, emit, NULL, 0, 3);
+    tk_pipeline_start(pipeline);
+
+    /* δʱѹߵȴᶪ */
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        packet.id = i;
+        packet.sensor = i % 4;
+        packet.raw = (uint16_t)(i % 1200);
+        tk_pipeline_push(pipeline, &packet);
+    }
+    /* ȴѹȫ */
+    tk_pipeline_stop(pipeline);
+
+    printf("emitted %u readings\n", emitted);
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        tk_pipeline_get_stats(pipeline, i, &stats);
+        printf("%-9s in %llu out %llu batches %llu avg backlog %.1f starved %llu blocked %llu busy %llu us\n",
+               stage_names[i], (unsigned long long)stats.in_num, (unsigned long long)stats.out_num,
+               (unsigned long long)stats.batches,
+               stats.batches ? (double)stats.occupancy / (double)stats.batches : 0.0,
+               (unsigned long long)stats.starved, (unsigned long long)stats.blocked,
+               (unsigned long long)(stats.busy_ns / 1000));
+    }
+    tk_pipeline_delete(pipeline);
+
+    getchar();
+    return 0;
+}
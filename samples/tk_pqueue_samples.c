@@ -0,0 +1,79 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include <stdio.h>
+#include "toolkit.h"
+
+#define PQUEUE_MAX 8
+
+struct job
+{
+    uint16_t id;
+    uint16_t prio;
+};
+
+/* ȼо */
+struct tk_pqueue pqueue;
+/* ȼл */
+uint32_t pqueue_pool[TK_PQUEUE_POOL_SIZE(sizeof(struct job), PQUEUE_MAX) / sizeof(uint32_t)];
+
+int main(int argc, char *argv[])
+{
+    struct job jobs[] = {{0, 3}, {1, 1}, {2, 3}, {3, 0}, {4, 1}, {5, 2}};
+    struct job job;
+    uint8_t prio;
+    int i;
+
+    /* ̬ʽȼУֵԽСԽȳӣͬȼȽȳ */
+    tk_pqueue_init(&pqueue, pqueue_pool, sizeof(pqueue_pool), sizeof(struct job));
+    for (i = 0; i < sizeof(jobs) / sizeof(jobs[0]); i++)
+        tk_pqueue_push(&pqueue, &jobs[i], jobs[i].prio);
+
+    printf("pqueue (%d):", tk_pqueue_curr_len(&pqueue));
+    while (tk_pqueue_pop(&pqueue, &job))
+        printf(" %d/%d", job.id, job.prio);
+    printf("\n");
+    tk_pqueue_detach(&pqueue);
+
+    /* ̬ʽ4Уÿ4Ԫأʺȼٵĳ */
+    struct tk_mlqueue *mlqueue = tk_mlqueue_create(sizeof(struct job), 4, 4);
+    for (i = 0; i < sizeof(jobs) / sizeof(jobs[0]); i++)
+        tk_mlqueue_push(mlqueue, &jobs[i], (uint8_t)jobs[i].prio);
+
+    printf("mlqueue (%d):", tk_mlqueue_curr_len(mlqueue));
+    while (tk_mlqueue_peep(mlqueue, &job, &prio))
+    {
+        tk_mlqueue_pop(mlqueue, &job);
+        printf(" %d/%d", job.id, prio);
+    }
+    printf("\n");
+    tk_mlqueue_delete(mlqueue);
+
+    getchar();
+    return 0;
+}
@@ -0,0 +1,292 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_BUFPOOL
+
+/*
+ * ̶СTK_BUFPOOL_ALIGNĻأֻstruct tk_bufָ롣
+ * ÿԭü㲥NʱN-1ãһͷʱ黹
+ * лջջΪ( << 32) | (± + 1)ÿ޸ıǼ1ֹABA
+ * ǰСУͷںͷݲûС
+ */
+
+/**
+ * @brief ѹջ(ڲ)
+ * 
+ * @param pool ض
+ * @param index ±
+ */
+static void _tk_bufpool_push(struct tk_bufpool *pool, uint32_t index)
+{
+    uint64_t head = __atomic_load_n(&pool->free_head, __ATOMIC_RELAXED);
+    uint64_t next;
+    do
+    {
+        __atomic_store_n(&pool->bufs[index].next, (uint32_t)head, __ATOMIC_RELAXED);
+        next = (((head >> 32) + 1) << 32) | (index + 1);
+    } while (__atomic_compare_exchange_n(&pool->free_head, &head, next, true,
+                                         __ATOMIC_RELEASE, __ATOMIC_RELAXED) == false);
+    __atomic_add_fetch(&pool->free_num, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief ӿջһ(ڲ)
+ * 
+ * @param pool ض
+ * @return struct tk_buf* NULLΪûпл
+ */
+static struct tk_buf *_tk_bufpool_pop(struct tk_bufpool *pool)
+{
+    uint64_t head = __atomic_load_n(&pool->free_head, __ATOMIC_ACQUIRE);
+    uint64_t next;
+    uint32_t top;
+    do
+    {
+        top = (uint32_t)head;
+        if (top == 0)
+            return NULL;
+        /* nextѹڣʱѱ仯ȽϽʧ */
+        next = (((head >> 32) + 1) << 32) | __atomic_load_n(&pool->bufs[top - 1].next, __ATOMIC_RELAXED);
+    } while (__atomic_compare_exchange_n(&pool->free_head, &head, next, true,
+                                         __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE) == false);
+    __atomic_sub_fetch(&pool->free_num, 1, __ATOMIC_RELAXED);
+    return &pool->bufs[top - 1];
+}
+
+/**
+ * @brief Ѷֻȫѹջ(ڲ)
+ * 
+ * @param pool ض
+ * @param data ʼַѰTK_BUFPOOL_ALIGN
+ * @param buf_size СѰTK_BUFPOOL_ALIGNȡ
+ * @param buf_num 
+ */
+static void _tk_bufpool_setup(struct tk_bufpool *pool, uint8_t *data, uint32_t buf_size, uint32_t buf_num)
+{
+    pool->buf_size = buf_size;
+    pool->buf_num = buf_num;
+    pool->data_pool = data;
+    pool->bufs = (struct tk_buf *)(data + (size_t)buf_size * buf_num);
+    pool->free_head = 0;
+    pool->free_num = 0;
+    for (uint32_t i = buf_num; i > 0; i--)
+    {
+        struct tk_buf *buf = &pool->bufs[i - 1];
+        buf->pool = pool;
+        buf->data = data + (size_t)buf_size * (i - 1);
+        buf->len = 0;
+        buf->ref = 0;
+        _tk_bufpool_push(pool, i - 1);
+    }
+}
+
+/**
+ * @brief ̬ʼ
+ * 
+ * @param pool ض
+ * @param mempool TK_BUFPOOL_POOL_SIZE(buf_size, buf_num)С
+ * @param pool_size С(λֽ)
+ * @param buf_size ÿС(λֽ)ȡTK_BUFPOOL_ALIGN
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_bufpool_init(struct tk_bufpool *pool, void *mempool, uint32_t pool_size, uint32_t buf_size)
+{
+    TK_ASSERT(pool);
+    TK_ASSERT(mempool);
+    TK_ASSERT(buf_size);
+    uintptr_t data;
+    uint32_t offset, buf_num;
+    if (pool == NULL || mempool == NULL || buf_size == 0 || buf_size > 0x7FFFFFFFUL - TK_BUFPOOL_ALIGN)
+        return false;
+    data = ((uintptr_t)mempool + TK_BUFPOOL_ALIGN - 1) & ~(uintptr_t)(TK_BUFPOOL_ALIGN - 1);
+    offset = (uint32_t)(data - (uintptr_t)mempool);
+    if (pool_size <= offset)
+        return false;
+    buf_size = TK_BUFPOOL_BUF_SIZE(buf_size);
+    buf_num = (pool_size - offset) / (buf_size + sizeof(struct tk_buf));
+    if (buf_num == 0)
+        return false;
+    pool->mem_pool = mempool;
+    _tk_bufpool_setup(pool, (uint8_t *)data, buf_size, buf_num);
+    return true;
+}
+
+/**
+ * @brief ̬뻺أлͷŲ
+ * 
+ * @param pool ҪĻض
+ * @return true ɹ
+ * @return false ʧܣлδͷ
+ */
+bool tk_bufpool_detach(struct tk_bufpool *pool)
+{
+    TK_ASSERT(pool);
+    if (pool == NULL || tk_bufpool_free_num(pool) != pool->buf_num)
+        return false;
+    pool->free_head = 0;
+    pool->free_num = 0;
+    pool->buf_num = 0;
+    pool->bufs = NULL;
+    pool->data_pool = NULL;
+    pool->mem_pool = NULL;
+    return true;
+}
+
+#ifdef TK_BUFPOOL_USING_CREATE
+/**
+ * @brief ̬
+ * 
+ * @param buf_size ÿС(λֽ)ȡTK_BUFPOOL_ALIGN
+ * @param buf_num 
+ * @return struct tk_bufpool* ĻضNULLΪʧ
+ */
+struct tk_bufpool *tk_bufpool_create(uint32_t buf_size, uint32_t buf_num)
+{
+    TK_ASSERT(buf_size);
+    TK_ASSERT(buf_num);
+    struct tk_bufpool *pool;
+    void *mempool;
+    uint64_t pool_size;
+    if (buf_size == 0 || buf_num == 0 || buf_size > 0x7FFFFFFFUL - TK_BUFPOOL_ALIGN)
+        return NULL;
+    pool_size = TK_BUFPOOL_POOL_SIZE((uint64_t)buf_size, (uint64_t)buf_num);
+    if (pool_size > (size_t)-1)
+        return NULL;
+    if ((pool = malloc(sizeof(struct tk_bufpool))) == NULL)
+        return NULL;
+    if ((mempool = malloc((size_t)pool_size)) == NULL)
+    {
+        free(pool);
+        return NULL;
+    }
+    pool->mem_pool = mempool;
+    _tk_bufpool_setup(pool, (uint8_t *)(((uintptr_t)mempool + TK_BUFPOOL_ALIGN - 1) & ~(uintptr_t)(TK_BUFPOOL_ALIGN - 1)),
+                      TK_BUFPOOL_BUF_SIZE(buf_size), buf_num);
+    return pool;
+}
+
+/**
+ * @brief ̬ɾأлͷŲɾ
+ * 
+ * @param pool ҪɾĻض
+ * @return true ɾɹ
+ * @return false ɾʧܣлδͷ
+ */
+bool tk_bufpool_delete(struct tk_bufpool *pool)
+{
+    TK_ASSERT(pool);
+    void *mempool;
+    if (pool == NULL)
+        return false;
+    mempool = pool->mem_pool;
+    if (tk_bufpool_detach(pool) == false)
+        return false;
+    free(mempool);
+    free(pool);
+    return true;
+}
+#endif /* TK_BUFPOOL_USING_CREATE */
+
+/**
+ * @brief һüΪ1̵߳
+ * 
+ * @param pool ض
+ * @return struct tk_buf* NULLΪûпл
+ */
+struct tk_buf *tk_bufpool_alloc(struct tk_bufpool *pool)
+{
+    TK_ASSERT(pool);
+    struct tk_buf *buf;
+    if (pool == NULL || pool->bufs == NULL)
+        return NULL;
+    buf = _tk_bufpool_pop(pool);
+    if (buf == NULL)
+        return NULL;
+    buf->len = 0;
+    __atomic_store_n(&buf->ref, 1, __ATOMIC_RELAXED);
+    return buf;
+}
+
+/**
+ * @brief ã㲥Nǰtk_bufpool_retain(buf, N - 1)
+ * 
+ * @param buf 
+ * @param count ӵø
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_bufpool_retain(struct tk_buf *buf, uint32_t count)
+{
+    TK_ASSERT(buf);
+    if (buf == NULL)
+        return false;
+    __atomic_add_fetch(&buf->ref, count, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @brief ͷһãһͷʱ黹̵߳
+ * 
+ * @param buf 
+ * @return true ɹ
+ * @return false ʧܣѾȫͷ
+ */
+bool tk_bufpool_release(struct tk_buf *buf)
+{
+    TK_ASSERT(buf);
+    uint32_t ref;
+    if (buf == NULL)
+        return false;
+    ref = __atomic_fetch_sub(&buf->ref, 1, __ATOMIC_ACQ_REL);
+    if (ref == 0)
+    {
+        TK_ASSERT(ref != 0);
+        __atomic_add_fetch(&buf->ref, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    if (ref == 1)
+        _tk_bufpool_push(buf->pool, (uint32_t)(buf - buf->pool->bufs));
+    return true;
+}
+
+/**
+ * @brief ȡл
+ * 
+ * @param pool ض
+ * @return uint32_t л
+ */
+uint32_t tk_bufpool_free_num(struct tk_bufpool *pool)
+{
+    TK_ASSERT(pool);
+    if (pool == NULL)
+        return 0;
+    return __atomic_load_n(&pool->free_num, __ATOMIC_RELAXED);
+}
+#endif /* TOOLKIT_USING_BUFPOOL */
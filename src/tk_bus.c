@@ -0,0 +1,383 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_BUS
+
+/*
+ * ÿһλֻдһݣÿֻԼĶαꡣ
+ * headΪһϢţαhead֮ΪδϢ
+ * Űuint32_tȻƣСȡ2ݣλ±Ϊ&mask
+ * ĬģʽĶһȦʱʧ(ɷԻó)
+ * ģʽֱӸǣĶڶȡʱǵϢ붪ʧ
+ */
+
+/**
+ * @brief ϢȡΪ2(ڲ)
+ * 
+ * @param num Ϣ
+ * @return uint32_t num2ݣnumΪ0ʱ0
+ */
+static uint32_t _tk_bus_floor_pow2(uint32_t num)
+{
+    uint32_t pow2 = 1;
+    if (num == 0)
+        return 0;
+    while (pow2 <= num / 2 && pow2 < 0x80000000UL)
+        pow2 <<= 1;
+    return pow2;
+}
+
+/**
+ * @brief ͻС(ڲ)
+ * 
+ * @param bus ߶
+ * @param msgpool Ϣ
+ * @param max_msgs СΪ2
+ * @param msg_size ϢС(λֽ)
+ * @param keep_fresh ǷΪģʽ
+ */
+static void _tk_bus_setup(struct tk_bus *bus, void *msgpool, uint32_t max_msgs, uint16_t msg_size, bool keep_fresh)
+{
+    bus->msg_pool = (uint8_t *)msgpool;
+    bus->msg_size = msg_size;
+    bus->keep_fresh = keep_fresh;
+    bus->sub_num = 0;
+    bus->mask = max_msgs - 1;
+    bus->head = 0;
+    bus->gate = 0;
+}
+
+/**
+ * @brief ¼ߵα(ڲ)
+ * ֻڻʱãƽʱҪ
+ * 
+ * @param bus ߶
+ */
+static void _tk_bus_update_gate(struct tk_bus *bus)
+{
+    uint32_t gate = bus->head;
+    for (uint8_t i = 0; i < bus->sub_num; i++)
+    {
+        if ((int32_t)(bus->subs[i]->cursor - gate) < 0)
+            gate = bus->subs[i]->cursor;
+    }
+    bus->gate = gate;
+}
+
+/**
+ * @brief ģʽѱǵϢ(ڲ)
+ * 
+ * @param sub ߶
+ */
+static void _tk_bus_catch_up(struct tk_bus_sub *sub)
+{
+    struct tk_bus *bus = sub->bus;
+    uint32_t behind = bus->head - sub->cursor;
+    if (behind > bus->mask + 1)
+    {
+        sub->lost += behind - (bus->mask + 1);
+        sub->cursor = bus->head - (bus->mask + 1);
+    }
+}
+
+/**
+ * @brief ̬ʼ
+ * СΪpool_size/msg_sizeȡ2ݣĻʹ
+ * 
+ * @param bus ߶
+ * @param msgpool Ϣ
+ * @param pool_size С(λֽ)
+ * @param msg_size ϢС(λֽ)
+ * @param keep_fresh ǷΪģʽ,trueϢ falseĬ(Ķ߶ǰٷ)
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_bus_init(struct tk_bus *bus, void *msgpool, uint32_t pool_size, uint16_t msg_size, bool keep_fresh)
+{
+    TK_ASSERT(bus);
+    TK_ASSERT(msgpool);
+    TK_ASSERT(msg_size);
+    uint32_t max_msgs;
+    if (bus == NULL || msgpool == NULL || msg_size == 0)
+        return false;
+    max_msgs = _tk_bus_floor_pow2(pool_size / msg_size);
+    if (max_msgs == 0)
+        return false;
+    _tk_bus_setup(bus, msgpool, max_msgs, msg_size, keep_fresh);
+    return true;
+}
+
+/**
+ * @brief ̬ߣжͬʱȡ
+ * 
+ * @param bus Ҫ߶
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_bus_detach(struct tk_bus *bus)
+{
+    TK_ASSERT(bus);
+    if (bus == NULL)
+        return false;
+    for (uint8_t i = 0; i < bus->sub_num; i++)
+        bus->subs[i]->bus = NULL;
+    bus->sub_num = 0;
+    bus->msg_pool = NULL;
+    bus->head = 0;
+    bus->gate = 0;
+    return true;
+}
+
+#ifdef TK_BUS_USING_CREATE
+/**
+ * @brief ̬
+ * 
+ * @param msg_size ϢС(λֽ)
+ * @param max_msgs Сȡ2
+ * @param keep_fresh ǷΪģʽ,trueϢ falseĬ(Ķ߶ǰٷ)
+ * @return struct tk_bus* ߶NULLΪʧ
+ */
+struct tk_bus *tk_bus_create(uint16_t msg_size, uint32_t max_msgs, bool keep_fresh)
+{
+    TK_ASSERT(msg_size);
+    TK_ASSERT(max_msgs);
+    struct tk_bus *bus;
+    void *msgpool;
+    uint32_t ring_size;
+    if (msg_size == 0 || max_msgs == 0 || max_msgs > 0x80000000UL)
+        return NULL;
+    ring_size = _tk_bus_floor_pow2(max_msgs);
+    if (ring_size < max_msgs)
+        ring_size <<= 1;
+    if ((bus = malloc(sizeof(struct tk_bus))) == NULL)
+        return NULL;
+    if ((msgpool = malloc((size_t)ring_size * msg_size)) == NULL)
+    {
+        free(bus);
+        return NULL;
+    }
+    _tk_bus_setup(bus, msgpool, ring_size, msg_size, keep_fresh);
+    return bus;
+}
+
+/**
+ * @brief ̬ɾߣжͬʱȡ
+ * 
+ * @param bus Ҫɾ߶
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_bus_delete(struct tk_bus *bus)
+{
+    TK_ASSERT(bus);
+    if (bus == NULL)
+        return false;
+    free(bus->msg_pool);
+    tk_bus_detach(bus);
+    free(bus);
+    return true;
+}
+#endif /* TK_BUS_USING_CREATE */
+
+/**
+ * @brief ȡ߻С
+ * 
+ * @param bus ߶
+ * @return uint32_t ౣϢ
+ */
+uint32_t tk_bus_capacity(struct tk_bus *bus)
+{
+    TK_ASSERT(bus);
+    return bus->mask + 1;
+}
+
+/**
+ * @brief һϢ
+ * ϢֻһεУɿձΪǿʱ¼¼λ
+ * ˶յ¼Ӧһֱȡtk_bus_readfalse
+ * 
+ * @param bus ߶
+ * @param pval ҪϢ
+ * @return true ɹ
+ * @return false ʧ(ĬģʽĶ߻һȦδ)
+ */
+bool tk_bus_publish(struct tk_bus *bus, const void *pval)
+{
+    TK_ASSERT(bus);
+    TK_ASSERT(pval);
+    if (bus == NULL || pval == NULL || bus->msg_pool == NULL)
+        return false;
+    if (bus->keep_fresh == false && bus->head - bus->gate > bus->mask)
+    {
+        _tk_bus_update_gate(bus);
+        if (bus->head - bus->gate > bus->mask)
+            return false;
+    }
+    memcpy(bus->msg_pool + (size_t)(bus->head & bus->mask) * bus->msg_size, pval, bus->msg_size);
+    bus->head++;
+    for (uint8_t i = 0; i < bus->sub_num; i++)
+    {
+        struct tk_bus_sub *sub = bus->subs[i];
+        if (sub->event != NULL && bus->head - sub->cursor == 1)
+            tk_event_send(sub->event, sub->event_set);
+    }
+    return true;
+}
+
+/**
+ * @brief ߣֻ֮ܶ󷢲Ϣ
+ * 
+ * @param bus ߶
+ * @param sub ߶
+ * @param event Ϣʱ֪ͨ¼NULLΪ֪ͨ(ѯ)
+ * @param event_set ֪ͨʱ͵¼λ
+ * @return true ĳɹ
+ * @return false ʧ(Ѷ)
+ */
+bool tk_bus_subscribe(struct tk_bus *bus, struct tk_bus_sub *sub, struct tk_event *event, uint32_t event_set)
+{
+    TK_ASSERT(bus);
+    TK_ASSERT(sub);
+    if (bus == NULL || sub == NULL || bus->msg_pool == NULL)
+        return false;
+    if (bus->sub_num >= TK_BUS_MAX_SUBSCRIBERS)
+        return false;
+    for (uint8_t i = 0; i < bus->sub_num; i++)
+    {
+        if (bus->subs[i] == sub)
+            return false;
+    }
+    sub->bus = bus;
+    sub->event = event;
+    sub->event_set = event_set;
+    sub->cursor = bus->head;
+    sub->lost = 0;
+    bus->subs[bus->sub_num++] = sub;
+    return true;
+}
+
+/**
+ * @brief ȡģδϢ
+ * 
+ * @param sub ߶
+ * @return true ȡɹ
+ * @return false ȡʧ(δ)
+ */
+bool tk_bus_unsubscribe(struct tk_bus_sub *sub)
+{
+    TK_ASSERT(sub);
+    struct tk_bus *bus;
+    if (sub == NULL || (bus = sub->bus) == NULL)
+        return false;
+    for (uint8_t i = 0; i < bus->sub_num; i++)
+    {
+        if (bus->subs[i] == sub)
+        {
+            bus->subs[i] = bus->subs[--bus->sub_num];
+            break;
+        }
+    }
+    sub->bus = NULL;
+    return true;
+}
+
+/**
+ * @brief ߶ȡһϢ
+ * 
+ * @param sub ߶
+ * @param pval Ϣ
+ * @return true ȡɹ
+ * @return false ȡʧ(ûδϢ)
+ */
+bool tk_bus_read(struct tk_bus_sub *sub, void *pval)
+{
+    TK_ASSERT(sub);
+    TK_ASSERT(pval);
+    if (tk_bus_peep(sub, pval) == false)
+        return false;
+    sub->cursor++;
+    return true;
+}
+
+/**
+ * @brief ߲鿴һϢƶα
+ * 
+ * @param sub ߶
+ * @param pval Ϣ
+ * @return true ȡɹ
+ * @return false ȡʧ(ûδϢ)
+ */
+bool tk_bus_peep(struct tk_bus_sub *sub, void *pval)
+{
+    TK_ASSERT(sub);
+    TK_ASSERT(pval);
+    struct tk_bus *bus;
+    if (sub == NULL || pval == NULL || (bus = sub->bus) == NULL)
+        return false;
+    if (sub->cursor == bus->head)
+        return false;
+    if (bus->keep_fresh == true)
+        _tk_bus_catch_up(sub);
+    memcpy(pval, bus->msg_pool + (size_t)(sub->cursor & bus->mask) * bus->msg_size, bus->msg_size);
+    return true;
+}
+
+/**
+ * @brief ȡδϢ
+ * 
+ * @param sub ߶
+ * @return uint32_t δϢ
+ */
+uint32_t tk_bus_pending(struct tk_bus_sub *sub)
+{
+    TK_ASSERT(sub);
+    if (sub == NULL || sub->bus == NULL)
+        return 0;
+    if (sub->bus->keep_fresh == true)
+        _tk_bus_catch_up(sub);
+    return sub->bus->head - sub->cursor;
+}
+
+/**
+ * @brief ȡ౻ǵϢ(ģʽ)
+ * 
+ * @param sub ߶
+ * @return uint32_t ʧϢ
+ */
+uint32_t tk_bus_lost(struct tk_bus_sub *sub)
+{
+    TK_ASSERT(sub);
+    if (sub == NULL)
+        return 0;
+    if (sub->bus != NULL && sub->bus->keep_fresh == true)
+        _tk_bus_catch_up(sub);
+    return sub->lost;
+}
+
+#endif /* TOOLKIT_USING_BUS */
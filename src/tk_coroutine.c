@@ -0,0 +1,462 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     sleepers in a pairing heap, O(1) queue waiter push
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_COROUTINE
+
+static struct tk_co *tk_co_ready_head = NULL;
+static struct tk_co *tk_co_ready_tail = NULL;
+static uint32_t tk_co_ready_num = 0;
+#ifdef TOOLKIT_USING_TIMER
+/* ʱ˯ЭԶѣΪ绽ѵЭ */
+static struct tk_co *tk_co_sleep_root = NULL;
+#endif /* TOOLKIT_USING_TIMER */
+
+/**
+ * @brief β(ڲ)
+ * 
+ * @param co Э̶
+ */
+static void _tk_co_ready_push(struct tk_co *co)
+{
+    co->state = TK_CO_STATE_READY;
+    co->next = NULL;
+    if (tk_co_ready_tail == NULL)
+        tk_co_ready_head = co;
+    else
+        tk_co_ready_tail->next = co;
+    tk_co_ready_tail = co;
+    tk_co_ready_num++;
+}
+
+/**
+ * @brief ӵƳЭ(ڲ)
+ * 
+ * @param head ͷַָ
+ * @param co ҪƳЭ̶
+ * @return struct tk_co* ƳڵǰNULLΪͷڵδҵ
+ */
+static struct tk_co *_tk_co_list_remove(struct tk_co **head, struct tk_co *co)
+{
+    struct tk_co *prev = NULL;
+    struct tk_co *node = *head;
+    while (node != NULL && node != co)
+    {
+        prev = node;
+        node = node->next;
+    }
+    if (node == NULL)
+        return NULL;
+    if (prev == NULL)
+        *head = co->next;
+    else
+        prev->next = co->next;
+    co->next = NULL;
+    return prev;
+}
+
+#ifdef TOOLKIT_USING_TIMER
+/**
+ * @brief ϲ˯߶ѣʱ̽ĸΪһ׸ӽڵ(ڲ)
+ * 
+ * @param a ѵĸnextheap_prevΪNULL
+ * @param b ѵĸnextheap_prevΪNULL
+ * @return struct tk_co* ϲĸ
+ */
+static struct tk_co *_tk_co_heap_meld(struct tk_co *a, struct tk_co *b)
+{
+    if ((uint32_t)(b->value - a->value) > (UINT32_MAX / 2))
+    {
+        struct tk_co *t = a;
+        a = b;
+        b = t;
+    }
+    b->heap_prev = a;
+    b->next = a->heap_child;
+    if (a->heap_child != NULL)
+        a->heap_child->heap_prev = b;
+    a->heap_child = b;
+    return a;
+}
+
+/**
+ * @brief ˺ϲֵΪһѣ̯O(log n)(ڲ)
+ * 
+ * @param first ֵ׸ڵ
+ * @return struct tk_co* ϲĸNULLΪ
+ */
+static struct tk_co *_tk_co_heap_merge_pairs(struct tk_co *first)
+{
+    struct tk_co *pairs = NULL;
+    struct tk_co *root = NULL;
+    /* һˣϲҵpairs */
+    while (first != NULL)
+    {
+        struct tk_co *a = first;
+        struct tk_co *b = a->next;
+        first = (b != NULL) ? b->next : NULL;
+        a->next = NULL;
+        a->heap_prev = NULL;
+        if (b != NULL)
+        {
+            b->next = NULL;
+            b->heap_prev = NULL;
+            a = _tk_co_heap_meld(a, b);
+        }
+        a->heap_prev = pairs;
+        pairs = a;
+    }
+    /* ڶˣҵκϲ */
+    while (pairs != NULL)
+    {
+        struct tk_co *a = pairs;
+        pairs = a->heap_prev;
+        a->heap_prev = NULL;
+        root = (root == NULL) ? a : _tk_co_heap_meld(root, a);
+    }
+    return root;
+}
+
+/**
+ * @brief ˯߶ƳЭ̣̯O(log n)(ڲ)
+ * 
+ * @param co ˯еЭ̶
+ */
+static void _tk_co_heap_remove(struct tk_co *co)
+{
+    struct tk_co *sub;
+    if (co == tk_co_sleep_root)
+    {
+        tk_co_sleep_root = _tk_co_heap_merge_pairs(co->heap_child);
+    }
+    else
+    {
+        if (co->heap_prev->heap_child == co)
+            co->heap_prev->heap_child = co->next;
+        else
+            co->heap_prev->next = co->next;
+        if (co->next != NULL)
+            co->next->heap_prev = co->heap_prev;
+        sub = _tk_co_heap_merge_pairs(co->heap_child);
+        if (sub != NULL)
+            tk_co_sleep_root = _tk_co_heap_meld(tk_co_sleep_root, sub);
+    }
+    co->heap_child = NULL;
+    co->heap_prev = NULL;
+    co->next = NULL;
+}
+#endif /* TOOLKIT_USING_TIMER */
+
+/**
+ * @brief ʼЭ
+ * 
+ * @param co Э̶
+ * @param entry Э̺ʹTK_CO_FUNC
+ * @param user_data û
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_co_init(struct tk_co *co, uint8_t (*entry)(struct tk_co *co), void *user_data)
+{
+    TK_ASSERT(co);
+    TK_ASSERT(entry);
+    if (co == NULL || entry == NULL)
+        return false;
+    co->line = 0;
+    co->state = TK_CO_STATE_IDLE;
+    co->option = 0;
+    co->value = 0;
+    co->recved = 0;
+    co->wait_obj = NULL;
+    co->next = NULL;
+    co->entry = entry;
+    co->user_data = user_data;
+#ifdef TOOLKIT_USING_TIMER
+    co->heap_child = NULL;
+    co->heap_prev = NULL;
+#endif /* TOOLKIT_USING_TIMER */
+    return true;
+}
+
+/**
+ * @brief Э̣Э̽´εʱ
+ * 
+ * @param co Э̶
+ * @return true ɹ
+ * @return false ʧ(Э)
+ */
+bool tk_co_start(struct tk_co *co)
+{
+    TK_ASSERT(co);
+    if (co->state != TK_CO_STATE_IDLE && co->state != TK_CO_STATE_DONE)
+        return false;
+    co->line = 0;
+    _tk_co_ready_push(co);
+    return true;
+}
+
+/**
+ * @brief ȡЭ̣Ӿ˯߻ȴƳ
+ * 
+ * @param co Э̶
+ * @return true ȡɹ
+ * @return false ȡʧ
+ */
+bool tk_co_cancel(struct tk_co *co)
+{
+    TK_ASSERT(co);
+    struct tk_co *prev;
+    switch (co->state)
+    {
+    case TK_CO_STATE_READY:
+        prev = _tk_co_list_remove(&tk_co_ready_head, co);
+        if (tk_co_ready_tail == co)
+            tk_co_ready_tail = prev;
+        tk_co_ready_num--;
+        break;
+#ifdef TOOLKIT_USING_TIMER
+    case TK_CO_STATE_SLEEP:
+        _tk_co_heap_remove(co);
+        break;
+#endif /* TOOLKIT_USING_TIMER */
+#ifdef TOOLKIT_USING_EVENT
+    case TK_CO_STATE_WAIT_EVENT:
+        _tk_co_list_remove(&((struct tk_event *)co->wait_obj)->co_wait_list, co);
+        break;
+#endif /* TOOLKIT_USING_EVENT */
+#ifdef TOOLKIT_USING_QUEUE
+    case TK_CO_STATE_WAIT_QUEUE:
+    {
+        struct tk_queue *queue = (struct tk_queue *)co->wait_obj;
+        prev = _tk_co_list_remove(&queue->co_wait_list, co);
+        if (queue->co_wait_tail == co)
+            queue->co_wait_tail = prev;
+        break;
+    }
+#endif /* TOOLKIT_USING_QUEUE */
+    default:
+        break;
+    }
+    co->state = TK_CO_STATE_DONE;
+    co->wait_obj = NULL;
+    return true;
+}
+
+#ifdef TOOLKIT_USING_TIMER
+/**
+ * @brief Э̵ȴһʱ(TK_AWAIT_TIMER)
+ * ˯Э̱ԶУO(1)ȡ̯O(log n)ͬһʱ̻ѵЭ˳ȷ
+ * 
+ * @param co Э̶
+ * @param ms ȴʱ(λms)
+ */
+void tk_co_wait_timer(struct tk_co *co, uint32_t ms)
+{
+    TK_ASSERT(co);
+    uint32_t tick = (uint32_t)((uint64_t)ms * TK_TIMER_TICK_PER_SECOND / 1000);
+    co->value = tk_timer_get_curr_tick() + tick;
+    co->state = TK_CO_STATE_SLEEP;
+    co->next = NULL;
+    co->heap_child = NULL;
+    co->heap_prev = NULL;
+    if (tk_co_sleep_root == NULL)
+        tk_co_sleep_root = co;
+    else
+        tk_co_sleep_root = _tk_co_heap_meld(tk_co_sleep_root, co);
+}
+#endif /* TOOLKIT_USING_TIMER */
+
+#ifdef TOOLKIT_USING_EVENT
+/**
+ * @brief Э̵ȴ¼(TK_AWAIT_EVENT)
+ * 
+ * @param co Э̶
+ * @param event ¼
+ * @param event_set Ȥı־
+ * @param option :־룺TK_EVENT_OPTION_AND; ־TK_EVENT_OPTION_OR
+ */
+void tk_co_wait_event(struct tk_co *co, struct tk_event *event, uint32_t event_set, uint8_t option)
+{
+    TK_ASSERT(co);
+    TK_ASSERT(event);
+    co->state = TK_CO_STATE_WAIT_EVENT;
+    co->wait_obj = event;
+    co->value = event_set;
+    co->option = option;
+    co->next = event->co_wait_list;
+    event->co_wait_list = co;
+}
+
+/**
+ * @brief ¼ͺĵȴЭ(tk_event_send)
+ * 
+ * @param event ¼
+ */
+void tk_co_notify_event(struct tk_event *event)
+{
+    struct tk_co **link = &event->co_wait_list;
+    while (*link != NULL)
+    {
+        struct tk_co *co = *link;
+        bool hit;
+        if (co->option & TK_EVENT_OPTION_AND)
+            hit = ((event->event_set & co->value) == co->value);
+        else
+            hit = ((event->event_set & co->value) != 0);
+        if (hit)
+        {
+            *link = co->next;
+            co->wait_obj = NULL;
+            _tk_co_ready_push(co);
+        }
+        else
+        {
+            link = &co->next;
+        }
+    }
+}
+#endif /* TOOLKIT_USING_EVENT */
+
+#ifdef TOOLKIT_USING_QUEUE
+/**
+ * @brief Э̵ȴзǿ(TK_AWAIT_QUEUE)
+ * 
+ * @param co Э̶
+ * @param queue ж
+ */
+void tk_co_wait_queue(struct tk_co *co, struct tk_queue *queue)
+{
+    TK_ASSERT(co);
+    TK_ASSERT(queue);
+    co->state = TK_CO_STATE_WAIT_QUEUE;
+    co->wait_obj = queue;
+    co->next = NULL;
+    if (queue->co_wait_tail == NULL)
+        queue->co_wait_list = co;
+    else
+        queue->co_wait_tail->next = co;
+    queue->co_wait_tail = co;
+}
+
+/**
+ * @brief ѹѵȴõЭ(tk_queue_push)
+ * 
+ * @param queue ж
+ */
+void tk_co_notify_queue(struct tk_queue *queue)
+{
+    struct tk_co *co = queue->co_wait_list;
+    queue->co_wait_list = co->next;
+    if (queue->co_wait_list == NULL)
+        queue->co_wait_tail = NULL;
+    co->wait_obj = NULL;
+    _tk_co_ready_push(co);
+}
+#endif /* TOOLKIT_USING_QUEUE */
+
+/**
+ * @brief Э̵ȣѵڵ˯Э̲боЭ
+ * ó(TK_CO_YIELD)򱻻ѵЭһ
+ * 
+ * @return uint32_t еЭ̸
+ */
+uint32_t tk_co_schedule(void)
+{
+    uint32_t run_num = 0;
+    uint32_t ready_num;
+#ifdef TOOLKIT_USING_TIMER
+    if (tk_co_sleep_root != NULL)
+    {
+        uint32_t now = tk_timer_get_curr_tick();
+        while (tk_co_sleep_root != NULL &&
+               (uint32_t)(now - tk_co_sleep_root->value) < (UINT32_MAX / 2))
+        {
+            struct tk_co *co = tk_co_sleep_root;
+            _tk_co_heap_remove(co);
+            _tk_co_ready_push(co);
+        }
+    }
+#endif /* TOOLKIT_USING_TIMER */
+    ready_num = tk_co_ready_num;
+    while (ready_num-- && tk_co_ready_head != NULL)
+    {
+        struct tk_co *co = tk_co_ready_head;
+        tk_co_ready_head = co->next;
+        if (tk_co_ready_head == NULL)
+            tk_co_ready_tail = NULL;
+        tk_co_ready_num--;
+        co->next = NULL;
+        co->state = TK_CO_STATE_RUNNING;
+        switch (co->entry(co))
+        {
+        case TK_CO_YIELDED:
+            _tk_co_ready_push(co);
+            break;
+        case TK_CO_EXITED:
+            co->state = TK_CO_STATE_DONE;
+            break;
+        default:
+            /* TK_CO_WAITING: Ѽ˯߻ȴ */
+            break;
+        }
+        run_num++;
+    }
+    return run_num;
+}
+
+/**
+ * @brief ȡЭ̵Ҫٴеʱ̣ڼʱ
+ * 
+ * @param tick ´Ҫȵʱ
+ * @return true ȡɹ
+ * @return false ޾˯ߵЭ
+ */
+bool tk_co_get_next_tick(uint32_t *tick)
+{
+    TK_ASSERT(tick);
+    if (tk_co_ready_head != NULL)
+    {
+#ifdef TOOLKIT_USING_TIMER
+        *tick = tk_timer_get_curr_tick();
+#else
+        *tick = 0;
+#endif /* TOOLKIT_USING_TIMER */
+        return true;
+    }
+#ifdef TOOLKIT_USING_TIMER
+    if (tk_co_sleep_root != NULL)
+    {
+        *tick = tk_co_sleep_root->value;
+        return true;
+    }
+#endif /* TOOLKIT_USING_TIMER */
+    return false;
+}
+
+#endif /* TOOLKIT_USING_COROUTINE */
@@ -25,10 +25,157 @@
 * Date           Author       Notes
 * 2020-01-31     zhangran     the first version
 * 2020-12-09     zhangran     Modify option type to prevent warning
+* 2026-10-19     zhangran     add eventfd bridge for epoll
+* 2026-10-19     zhangran     wake up waiting coroutines
+* 2026-10-19     zhangran     add event stats
+* 2026-10-19     zhangran     add tk_event_wait_any
 */
 
 #include "toolkit.h"
 #ifdef TOOLKIT_USING_EVENT
+#ifdef TK_EVENT_USING_FD
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif /* TK_EVENT_USING_FD */
+#ifdef TK_EVENT_USING_WAIT
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* tk_event_wait_anyÿ¼Ϲһڵ㣬ͬһεȴĽڵ㹲һfutex */
+struct tk_event_wait_node
+{
+    struct tk_event_wait_node *prev;
+    struct tk_event_wait_node *next;
+    uint32_t *fired;
+    uint32_t event_set;
+    uint8_t option;
+};
+#endif /* TK_EVENT_USING_WAIT */
+
+/**
+ * @brief жϱ־ֵǷ(ڲ)
+ * 
+ * @param current ǰ־ֵ
+ * @param event_set Ȥı־
+ * @param option :־룺TK_EVENT_OPTION_AND; ־TK_EVENT_OPTION_OR
+ * @return true 
+ * @return false 
+ */
+static bool _tk_event_check(uint32_t current, uint32_t event_set, uint8_t option)
+{
+    if (option & TK_EVENT_OPTION_AND)
+        return ((current & event_set) == event_set);
+    else if (option & TK_EVENT_OPTION_OR)
+        return ((current & event_set) != 0);
+    TK_ASSERT(0);
+    return false;
+}
+
+/**
+ * @brief ȡ¼ǰ־ֵTK_EVENT_USING_WAIT߳̿ͬʱ޸(ڲ)
+ * 
+ * @param event ¼
+ * @return uint32_t ǰ־ֵ
+ */
+static uint32_t _tk_event_get(struct tk_event *event)
+{
+#ifdef TK_EVENT_USING_WAIT
+    return __atomic_load_n(&event->event_set, __ATOMIC_ACQUIRE);
+#else
+    return event->event_set;
+#endif /* TK_EVENT_USING_WAIT */
+}
+
+#ifdef TK_EVENT_USING_WAIT
+/**
+ * @brief ¼ĵȴ̵ֻ߳ȴʱʹ(ڲ)
+ * 
+ * @param event ¼
+ */
+static void _tk_event_lock(struct tk_event *event)
+{
+    uint32_t spin = 0;
+    while (__atomic_exchange_n(&event->wait_lock, 1, __ATOMIC_ACQUIRE) != 0)
+    {
+        /* ߿ܱռóCPU */
+        if (++spin > 64)
+            sched_yield();
+    }
+}
+
+/**
+ * @brief ¼ĵȴ(ڲ)
+ * 
+ * @param event ¼
+ */
+static void _tk_event_unlock(struct tk_event *event)
+{
+    __atomic_store_n(&event->wait_lock, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief ĵȴ̣߳ÿȴֻ߳һ(ڲ)
+ * 
+ * @param event ¼
+ */
+static void _tk_event_wake_waiters(struct tk_event *event)
+{
+    struct tk_event_wait_node *node;
+    uint32_t current;
+    _tk_event_lock(event);
+    current = _tk_event_get(event);
+    for (node = event->wait_list; node != NULL; node = node->next)
+    {
+        if (_tk_event_check(current, node->event_set, node->option) &&
+            __atomic_exchange_n(node->fired, 1, __ATOMIC_SEQ_CST) == 0)
+            syscall(SYS_futex, node->fired, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+    _tk_event_unlock(event);
+}
+#endif /* TK_EVENT_USING_WAIT */
+
+#ifdef TK_EVENT_USING_FD
+/**
+ * @brief ж¼Ƿ(ڲ)
+ * 
+ * @param event ¼
+ * @param event_set Ȥı־
+ * @param option :־룺TK_EVENT_OPTION_AND; ־TK_EVENT_OPTION_OR
+ * @return true 
+ * @return false 
+ */
+static bool _tk_event_match(struct tk_event *event, uint32_t event_set, uint8_t option)
+{
+    return _tk_event_check(_tk_event_get(event), event_set, option);
+}
+
+/**
+ * @brief ¼ͬeventfdɶ״̬(ڲ)
+ * ֻ/ʧЧıظһϵͳãͲظд
+ * 
+ * @param event ¼
+ */
+static void _tk_event_fd_update(struct tk_event *event)
+{
+    uint64_t value = 1;
+    if (event->fd_enabled == false)
+        return;
+    bool hit = _tk_event_match(event, event->fd_event_set, event->fd_option);
+    if (hit == true && event->fd_signaled == false)
+    {
+        if (write(event->event_fd, &value, sizeof(value)) == sizeof(value))
+            event->fd_signaled = true;
+    }
+    else if (hit == false && event->fd_signaled == true)
+    {
+        if (read(event->event_fd, &value, sizeof(value)) == sizeof(value))
+            event->fd_signaled = false;
+    }
+}
+#endif /* TK_EVENT_USING_FD */
 
 #ifdef TK_EVENT_USING_CREATE
 /**
@@ -42,6 +189,21 @@ struct tk_event *tk_event_create(void)
     if ((event = malloc(sizeof(struct tk_event))) == NULL)
         return NULL;
     event->event_set = 0;
+#ifdef TOOLKIT_USING_COROUTINE
+    event->co_wait_list = NULL;
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TOOLKIT_USING_STATS
+    memset(&event->stats, 0, sizeof(event->stats));
+    event->stats_entry.object = NULL;
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_EVENT_USING_FD
+    event->fd_enabled = false;
+    event->fd_signaled = false;
+#endif /* TK_EVENT_USING_FD */
+#ifdef TK_EVENT_USING_WAIT
+    event->wait_list = NULL;
+    event->wait_lock = 0;
+#endif /* TK_EVENT_USING_WAIT */
     return event;
 }
 
@@ -55,6 +217,12 @@ struct tk_event *tk_event_create(void)
 bool tk_event_delete(struct tk_event *event)
 {
     TK_ASSERT(event);
+#ifdef TOOLKIT_USING_STATS
+    tk_stats_unregister(&event->stats_entry);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_EVENT_USING_FD
+    tk_event_release_fd(event);
+#endif /* TK_EVENT_USING_FD */
     free(event);
     return true;
 }
@@ -71,6 +239,21 @@ bool tk_event_init(struct tk_event *event)
 {
     TK_ASSERT(event);
     event->event_set = 0;
+#ifdef TOOLKIT_USING_COROUTINE
+    event->co_wait_list = NULL;
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TOOLKIT_USING_STATS
+    memset(&event->stats, 0, sizeof(event->stats));
+    event->stats_entry.object = NULL;
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_EVENT_USING_FD
+    event->fd_enabled = false;
+    event->fd_signaled = false;
+#endif /* TK_EVENT_USING_FD */
+#ifdef TK_EVENT_USING_WAIT
+    event->wait_list = NULL;
+    event->wait_lock = 0;
+#endif /* TK_EVENT_USING_WAIT */
     return true;
 }
 
@@ -85,7 +268,26 @@ bool tk_event_init(struct tk_event *event)
 bool tk_event_send(struct tk_event *event, uint32_t event_set)
 {
     TK_ASSERT(event);
+#ifdef TK_EVENT_USING_WAIT
+    __atomic_fetch_or(&event->event_set, event_set, __ATOMIC_SEQ_CST);
+#else
     event->event_set |= event_set;
+#endif /* TK_EVENT_USING_WAIT */
+#ifdef TOOLKIT_USING_STATS
+    TK_STATS_ADD(event->stats.send, 1);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TOOLKIT_USING_COROUTINE
+    if (event->co_wait_list != NULL)
+        tk_co_notify_event(event);
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TK_EVENT_USING_FD
+    _tk_event_fd_update(event);
+#endif /* TK_EVENT_USING_FD */
+#ifdef TK_EVENT_USING_WAIT
+    /* tk_event_wait_anyϽڵļԣⶪʧ */
+    if (__atomic_load_n(&event->wait_list, __ATOMIC_SEQ_CST) != NULL)
+        _tk_event_wake_waiters(event);
+#endif /* TK_EVENT_USING_WAIT */
     return true;
 }
 
@@ -102,30 +304,216 @@ bool tk_event_send(struct tk_event *event, uint32_t event_set)
 bool tk_event_recv(struct tk_event *event, uint32_t event_set, uint8_t option, uint32_t *recved)
 {
     TK_ASSERT(event);
-    bool result = false;
-    if (option & TK_EVENT_OPTION_AND)
+    uint32_t current = _tk_event_get(event);
+    bool result = _tk_event_check(current, event_set, option);
+#ifdef TK_EVENT_USING_WAIT
+    /* ߳̿ͬʱͻգжϺΪһԭӲ */
+    while (result == true && (option & TK_EVENT_OPTION_CLEAR) &&
+           __atomic_compare_exchange_n(&event->event_set, &current, current & ~event_set, true,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == false)
+        result = _tk_event_check(current, event_set, option);
+#endif /* TK_EVENT_USING_WAIT */
+#ifdef TOOLKIT_USING_STATS
+    TK_STATS_ADD(event->stats.recv, 1);
+    if (result == true)
+        TK_STATS_ADD(event->stats.hit, 1);
+#endif /* TOOLKIT_USING_STATS */
+    if (result == true)
     {
-        if ((event->event_set & event_set) == event_set)
-            result = true;
+        if (recved)
+            *recved = (current & event_set);
+
+        if (option & TK_EVENT_OPTION_CLEAR)
+        {
+#ifndef TK_EVENT_USING_WAIT
+            event->event_set &= ~event_set;
+#endif /* TK_EVENT_USING_WAIT */
+#ifdef TK_EVENT_USING_FD
+            _tk_event_fd_update(event);
+#endif /* TK_EVENT_USING_FD */
+        }
     }
-    else if (option & TK_EVENT_OPTION_OR)
+    return result;
+}
+
+#ifdef TK_EVENT_USING_FD
+/**
+ * @brief ȡ¼Ӧeventfdepollȶ·
+ * ¼event_set/optionʱfdɶʧЧ(ղ)fdɶ
+ * 
+ * @param event ¼
+ * @param event_set Ȥı־ÿ־ռ1Bit־"|"
+ * @param option :־룺TK_EVENT_OPTION_AND; ־TK_EVENT_OPTION_OR
+ * @return int ļ-1Ϊȡʧ
+ */
+int tk_event_get_fd(struct tk_event *event, uint32_t event_set, uint8_t option)
+{
+    TK_ASSERT(event);
+    TK_ASSERT(option & (TK_EVENT_OPTION_AND | TK_EVENT_OPTION_OR));
+    if (event == NULL)
+        return -1;
+    if (event->fd_enabled == false)
+    {
+        event->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (event->event_fd < 0)
+            return -1;
+        event->fd_enabled = true;
+        event->fd_signaled = false;
+    }
+    event->fd_event_set = event_set;
+    event->fd_option = option;
+    _tk_event_fd_update(event);
+    return event->event_fd;
+}
+
+/**
+ * @brief ͷ¼Ӧeventfd
+ * 
+ * @param event ¼
+ * @return true ͷųɹ
+ * @return false ͷʧ
+ */
+bool tk_event_release_fd(struct tk_event *event)
+{
+    TK_ASSERT(event);
+    if (event == NULL)
+        return false;
+    if (event->fd_enabled == true)
+        close(event->event_fd);
+    event->event_fd = -1;
+    event->fd_enabled = false;
+    event->fd_signaled = false;
+    return true;
+}
+#endif /* TK_EVENT_USING_FD */
+
+#ifdef TK_EVENT_USING_WAIT
+/**
+ * @brief ˳յһ¼(ڲ)
+ * 
+ * @param events ¼
+ * @param event_sets ÿ¼Ȥı־
+ * @param options ÿ¼Ĳ
+ * @param num ¼
+ * @param index ¼±
+ * @param recved յı־
+ * @return true ճɹ
+ * @return false 
+ */
+static bool _tk_event_recv_any(struct tk_event **events, const uint32_t *event_sets, const uint8_t *options,
+                               uint16_t num, uint16_t *index, uint32_t *recved)
+{
+    uint16_t i;
+    for (i = 0; i < num; i++)
+    {
+        if (tk_event_recv(events[i], event_sets[i], options[i], recved))
+        {
+            if (index)
+                *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief ͬʱȴ¼صһ¼ʱ
+ * ȴڼÿ¼Ϲһڵ㣬нڵ㹲һfutexһ¼ʱɷ̻߳ѣ
+ * Ѻ˳գ±С¼ȡ߳̿ͬʱЩ¼
+ * 
+ * @param events ¼
+ * @param event_sets ÿ¼Ȥı־ÿ־ռ1Bit־"|"
+ * @param options ÿ¼Ĳ:־룺TK_EVENT_OPTION_AND; ־TK_EVENT_OPTION_OR; ־:TK_EVENT_OPTION_CLEAR
+ * @param num ¼TK_EVENT_WAIT_MAX
+ * @param timeout_ms ʱʱ(λms)0Ϊȴ-1Ϊһֱȴ
+ * @param index ¼±꣬ΪNULL
+ * @param recved յı־ΪNULL
+ * @return true ճɹ
+ * @return false ʱ
+ */
+bool tk_event_wait_any(struct tk_event **events, const uint32_t *event_sets, const uint8_t *options,
+                       uint16_t num, int32_t timeout_ms, uint16_t *index, uint32_t *recved)
+{
+    TK_ASSERT(events);
+    TK_ASSERT(event_sets);
+    TK_ASSERT(options);
+    TK_ASSERT(num <= TK_EVENT_WAIT_MAX);
+    struct tk_event_wait_node nodes[TK_EVENT_WAIT_MAX];
+    struct timespec now, deadline, remain;
+    uint32_t fired = 0;
+    bool result;
+    uint16_t i;
+    if (events == NULL || event_sets == NULL || options == NULL || num == 0 || num > TK_EVENT_WAIT_MAX)
+        return false;
+    /* ¼ʱҽڵ */
+    if (_tk_event_recv_any(events, event_sets, options, num, index, recved))
+        return true;
+    if (timeout_ms == 0)
+        return false;
+    if (timeout_ms > 0)
     {
-        if (event->event_set & event_set)
-            result = true;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
     }
-    else
+    for (i = 0; i < num; i++)
     {
-        TK_ASSERT(0);
+        struct tk_event_wait_node *node = &nodes[i];
+        node->fired = &fired;
+        node->event_set = event_sets[i];
+        node->option = options[i];
+        node->prev = NULL;
+        _tk_event_lock(events[i]);
+        node->next = events[i]->wait_list;
+        if (node->next != NULL)
+            node->next->prev = node;
+        __atomic_store_n(&events[i]->wait_list, node, __ATOMIC_RELAXED);
+        _tk_event_unlock(events[i]);
     }
-    if (result == true)
+    while (1)
     {
-        if (recved)
-            *recved = (event->event_set & event_set);
-
-        if (option & TK_EVENT_OPTION_CLEAR)
-            event->event_set &= ~event_set;
+        /* ѱ־ټ飬֮ķͻʹfutexȴ */
+        __atomic_store_n(&fired, 0, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        result = _tk_event_recv_any(events, event_sets, options, num, index, recved);
+        if (result == true)
+            break;
+        if (timeout_ms < 0)
+        {
+            syscall(SYS_futex, &fired, FUTEX_WAIT_PRIVATE, 0, NULL, NULL, 0);
+            continue;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        remain.tv_sec = deadline.tv_sec - now.tv_sec;
+        remain.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+        if (remain.tv_nsec < 0)
+        {
+            remain.tv_sec--;
+            remain.tv_nsec += 1000000000L;
+        }
+        if (remain.tv_sec < 0)
+            break;
+        syscall(SYS_futex, &fired, FUTEX_WAIT_PRIVATE, 0, &remain, NULL, 0);
+    }
+    for (i = 0; i < num; i++)
+    {
+        struct tk_event_wait_node *node = &nodes[i];
+        _tk_event_lock(events[i]);
+        if (node->prev != NULL)
+            node->prev->next = node->next;
+        else
+            __atomic_store_n(&events[i]->wait_list, node->next, __ATOMIC_RELAXED);
+        if (node->next != NULL)
+            node->next->prev = node->prev;
+        _tk_event_unlock(events[i]);
     }
     return result;
 }
+#endif /* TK_EVENT_USING_WAIT */
 
 #endif /* TOOLKIT_USING_EVENT */
@@ -0,0 +1,755 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "toolkit.h"
+#if defined(TOOLKIT_USING_QUEUE) && defined(TK_QUEUE_USING_JOURNAL)
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TK_JOURNAL_MAGIC 0x4A514B54 /* "TKQJ" */
+#define TK_JOURNAL_VERSION 1
+#define TK_JOURNAL_HEADER_SIZE 64
+#define TK_JOURNAL_SUFFIX ".tkj"
+#define TK_JOURNAL_NAME_LEN 20 /* 16λʮƶκ + ".tkj" */
+#define TK_JOURNAL_CHECKPOINT "checkpoint"
+#define TK_JOURNAL_CHECKPOINT_SLOT 64
+
+/* ļͷλÿļͷռTK_JOURNAL_HEADER_SIZEֽ */
+struct tk_journal_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t record_size;
+    uint32_t segment_records;
+    uint64_t index;
+};
+
+/* ¼ͷqueue_sizeֽڵԪݣcrcźԪ */
+struct tk_journal_record
+{
+    uint32_t crc;
+    uint32_t seq;
+};
+
+/* 㣬λд룬ȡʱȡЧҴĲλ */
+struct tk_journal_checkpoint
+{
+    uint32_t magic;
+    uint32_t crc;
+    uint64_t generation;
+    uint64_t seq;  /* λ */
+    uint64_t tail; /* ̵׷λãָʱ￪ʼУβ */
+};
+
+/* һӳĶļˢ̵ݷΧ */
+struct tk_journal_map
+{
+    uint64_t index;
+    uint8_t *base;
+    size_t dirty_begin;
+    size_t dirty_end;
+};
+
+struct tk_queue_journal
+{
+    char *dir;
+    uint16_t queue_size;
+    uint32_t record_size;
+    uint32_t segment_records;
+    size_t segment_size;
+    uint64_t head;       /* һҪѵļ¼ */
+    uint64_t tail;       /* һҪ׷ӵļ¼ */
+    uint64_t checkpoint; /* дλ */
+    uint64_t committed;  /* д׷λ */
+    uint64_t generation;
+    uint64_t oldest;     /* ɵĶκ */
+    uint32_t sync_batch;
+    uint32_t pending;
+    bool failed;
+    int checkpoint_fd;
+    struct tk_journal_map write_map;
+    struct tk_journal_map read_map;
+};
+
+static uint32_t tk_journal_crc_table[256];
+static bool tk_journal_crc_ready = false;
+
+/**
+ * @brief CRC32(ڲ)
+ * 
+ * @param crc һݵCRC׶Ϊ0
+ * @param data 
+ * @param len ݳ
+ * @return uint32_t CRC32
+ */
+static uint32_t _tk_journal_crc(uint32_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    if (tk_journal_crc_ready == false)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (uint8_t j = 0; j < 8; j++)
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            tk_journal_crc_table[i] = c;
+        }
+        tk_journal_crc_ready = true;
+    }
+    crc = ~crc;
+    while (len--)
+        crc = tk_journal_crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/**
+ * @brief һ¼CRCǼ¼źԪ(ڲ)
+ * 
+ * @param seq ¼
+ * @param pval Ԫ
+ * @param size ԪشС
+ * @return uint32_t CRC32
+ */
+static uint32_t _tk_journal_record_crc(uint64_t seq, const void *pval, uint16_t size)
+{
+    return _tk_journal_crc(_tk_journal_crc(0, &seq, sizeof(seq)), pval, size);
+}
+
+/**
+ * @brief ɶļ·(ڲ)
+ * 
+ * @param journal ־
+ * @param index κ
+ * @param path ·
+ * @param size С
+ */
+static void _tk_journal_path(struct tk_queue_journal *journal, uint64_t index, char *path, size_t size)
+{
+    snprintf(path, size, "%s/%016" PRIx64 TK_JOURNAL_SUFFIX, journal->dir, index);
+}
+
+/**
+ * @brief ־Ŀ¼Ԫˢ̣֤½ɾĶļڵɼ(ڲ)
+ * 
+ * @param journal ־
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_journal_sync_dir(struct tk_queue_journal *journal)
+{
+    int fd = open(journal->dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    bool result;
+    if (fd < 0)
+        return false;
+    result = (fsync(fd) == 0);
+    close(fd);
+    return result;
+}
+
+/**
+ * @brief ļݷΧͬ(ڲ)
+ * 
+ * @param journal ־
+ * @param map ӳ
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_journal_flush(struct tk_queue_journal *journal, struct tk_journal_map *map)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t begin;
+    (void)journal;
+    if (map->base == NULL || map->dirty_end <= map->dirty_begin)
+        return true;
+    begin = map->dirty_begin & ~(page - 1);
+    if (msync(map->base + begin, map->dirty_end - begin, MS_SYNC) != 0)
+        return false;
+    map->dirty_begin = SIZE_MAX;
+    map->dirty_end = 0;
+    return true;
+}
+
+/**
+ * @brief ˢ̲ļӳ(ڲ)
+ * 
+ * @param journal ־
+ * @param map ӳ
+ * @return true ɹ
+ * @return false ˢʧ
+ */
+static bool _tk_journal_unmap(struct tk_queue_journal *journal, struct tk_journal_map *map)
+{
+    bool result = _tk_journal_flush(journal, map);
+    if (map->base != NULL)
+        munmap(map->base, journal->segment_size);
+    map->base = NULL;
+    return result;
+}
+
+/**
+ * @brief ӳļļʱɴԤռ(ڲ)
+ * ԤɱдӳڴʱSIGBUS
+ * 
+ * @param journal ־
+ * @param map ӳ
+ * @param index κ
+ * @param create ļʱǷ񴴽
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_journal_map(struct tk_queue_journal *journal, struct tk_journal_map *map,
+                            uint64_t index, bool create)
+{
+    char path[PATH_MAX];
+    struct stat st;
+    struct tk_journal_header *header;
+    bool created = false;
+    void *base;
+    int fd;
+    _tk_journal_path(journal, index, path, sizeof(path));
+    fd = open(path, O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0644);
+    if (fd < 0)
+        return false;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    if (st.st_size == 0 && create)
+    {
+        int err = posix_fallocate(fd, 0, (off_t)journal->segment_size);
+        if (err == EOPNOTSUPP || err == EINVAL)
+            err = ftruncate(fd, (off_t)journal->segment_size);
+        if (err != 0)
+        {
+            close(fd);
+            unlink(path);
+            return false;
+        }
+        created = true;
+    }
+    else if ((size_t)st.st_size != journal->segment_size)
+    {
+        close(fd);
+        return false;
+    }
+    base = mmap(NULL, journal->segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return false;
+    madvise(base, journal->segment_size, MADV_SEQUENTIAL);
+    header = (struct tk_journal_header *)base;
+    map->dirty_begin = SIZE_MAX;
+    map->dirty_end = 0;
+    if (created)
+    {
+        header->magic = TK_JOURNAL_MAGIC;
+        header->version = TK_JOURNAL_VERSION;
+        header->header_size = TK_JOURNAL_HEADER_SIZE;
+        header->record_size = journal->record_size;
+        header->segment_records = journal->segment_records;
+        header->index = index;
+        map->dirty_begin = 0;
+        map->dirty_end = sizeof(struct tk_journal_header);
+        _tk_journal_sync_dir(journal);
+    }
+    else if (header->magic != TK_JOURNAL_MAGIC || header->version != TK_JOURNAL_VERSION ||
+             header->header_size != TK_JOURNAL_HEADER_SIZE || header->record_size != journal->record_size ||
+             header->segment_records != journal->segment_records || header->index != index)
+    {
+        munmap(base, journal->segment_size);
+        return false;
+    }
+    map->index = index;
+    map->base = (uint8_t *)base;
+    return true;
+}
+
+/**
+ * @brief ȡ¼ڶεӳ䣬Ҫʱлӳ(ڲ)
+ * дʹдӳ䣬ȡʹöӳ䣬ָͬһʱӳ
+ * 
+ * @param journal ־
+ * @param seq ¼
+ * @param write ǷΪд
+ * @return struct tk_journal_map* ӳ䣬NULLΪʧ
+ */
+static struct tk_journal_map *_tk_journal_get_map(struct tk_queue_journal *journal, uint64_t seq, bool write)
+{
+    uint64_t index = seq / journal->segment_records;
+    struct tk_journal_map *map;
+    if (journal->write_map.base != NULL && journal->write_map.index == index)
+        return &journal->write_map;
+    if (journal->read_map.base != NULL && journal->read_map.index == index)
+        return &journal->read_map;
+    map = write ? &journal->write_map : &journal->read_map;
+    /* лдǰˢ̣ɶε֮ύ */
+    if (_tk_journal_unmap(journal, map) == false)
+        journal->failed = true;
+    if (_tk_journal_map(journal, map, index, write) == false)
+        return NULL;
+    return map;
+}
+
+/**
+ * @brief ȡ¼ڶӳеĵַ(ڲ)
+ * 
+ * @param journal ־
+ * @param map ӳ
+ * @param seq ¼
+ * @return struct tk_journal_record* ¼ַ
+ */
+static struct tk_journal_record *_tk_journal_record(struct tk_queue_journal *journal,
+                                                    struct tk_journal_map *map, uint64_t seq)
+{
+    return (struct tk_journal_record *)(map->base + TK_JOURNAL_HEADER_SIZE +
+                                        (size_t)(seq % journal->segment_records) * journal->record_size);
+}
+
+/**
+ * @brief CRC(ڲ)
+ * 
+ * @param cp 
+ * @return uint32_t CRC32
+ */
+static uint32_t _tk_journal_checkpoint_crc(const struct tk_journal_checkpoint *cp)
+{
+    return _tk_journal_crc(0, &cp->generation, sizeof(*cp) - offsetof(struct tk_journal_checkpoint, generation));
+}
+
+/**
+ * @brief д(ڲ)
+ * 
+ * @param journal ־
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_journal_write_checkpoint(struct tk_queue_journal *journal)
+{
+    struct tk_journal_checkpoint cp;
+    off_t offset;
+    memset(&cp, 0, sizeof(cp));
+    cp.magic = TK_JOURNAL_MAGIC;
+    cp.generation = journal->generation + 1;
+    cp.seq = journal->head;
+    cp.tail = journal->tail;
+    cp.crc = _tk_journal_checkpoint_crc(&cp);
+    offset = (off_t)(cp.generation & 1) * TK_JOURNAL_CHECKPOINT_SLOT;
+    if (pwrite(journal->checkpoint_fd, &cp, sizeof(cp), offset) != (ssize_t)sizeof(cp))
+        return false;
+    if (fdatasync(journal->checkpoint_fd) != 0)
+        return false;
+    journal->generation = cp.generation;
+    journal->checkpoint = cp.seq;
+    journal->committed = cp.tail;
+    return true;
+}
+
+/**
+ * @brief ȡ㣬λȡЧҴһ(ڲ)
+ * 
+ * @param journal ־
+ */
+static void _tk_journal_read_checkpoint(struct tk_queue_journal *journal)
+{
+    struct tk_journal_checkpoint cp;
+    journal->generation = 0;
+    journal->checkpoint = 0;
+    journal->committed = 0;
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        if (pread(journal->checkpoint_fd, &cp, sizeof(cp), (off_t)i * TK_JOURNAL_CHECKPOINT_SLOT) != (ssize_t)sizeof(cp))
+            continue;
+        if (cp.magic != TK_JOURNAL_MAGIC || cp.crc != _tk_journal_checkpoint_crc(&cp))
+            continue;
+        if (cp.generation >= journal->generation)
+        {
+            journal->generation = cp.generation;
+            journal->checkpoint = cp.seq;
+            journal->committed = cp.tail;
+        }
+    }
+}
+
+/**
+ * @brief ɾȫҼ̵Ķļ(ڲ)
+ * 
+ * @param journal ־
+ */
+static void _tk_journal_trim(struct tk_queue_journal *journal)
+{
+    char path[PATH_MAX];
+    uint64_t index = journal->checkpoint / journal->segment_records;
+    while (journal->oldest < index)
+    {
+        if (journal->read_map.base != NULL && journal->read_map.index == journal->oldest)
+            _tk_journal_unmap(journal, &journal->read_map);
+        _tk_journal_path(journal, journal->oldest, path, sizeof(path));
+        unlink(path);
+        journal->oldest++;
+    }
+}
+
+/**
+ * @brief ύͬ׷ӵļ¼д(ڲ)
+ * ¼ڼ̣ظͶϴύѵԪأᶪʧԪء
+ * λñ仯׷ӽ¶ʱд㣬ָ֤ʱУһ
+ * 
+ * @param journal ־
+ * @param force Ƿǿд
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_journal_commit(struct tk_queue_journal *journal, bool force)
+{
+    bool result = true;
+    journal->pending = 0;
+    if (_tk_journal_flush(journal, &journal->write_map) == false ||
+        _tk_journal_flush(journal, &journal->read_map) == false)
+        result = false;
+    if (result && (force || journal->head != journal->checkpoint ||
+                   journal->tail / journal->segment_records != journal->committed / journal->segment_records))
+        result = _tk_journal_write_checkpoint(journal);
+    if (result)
+        _tk_journal_trim(journal);
+    return result;
+}
+
+/**
+ * @brief ۼδύĲﵽsync_batchʱύ(ڲ)
+ * 
+ * @param journal ־
+ */
+static void _tk_journal_pending(struct tk_queue_journal *journal)
+{
+    if (journal->sync_batch != 0 && ++journal->pending >= journal->sync_batch)
+    {
+        if (_tk_journal_commit(journal, false) == false)
+            journal->failed = true;
+    }
+}
+
+/**
+ * @brief УβΣҵһЧ¼Ϊ׷λ(ڲ)
+ * ֻβοܴδ̵ļ¼֮ǰĶлʱˢ̣¼׷λ֮ǰ
+ * ļ¼̣ӸλÿʼУ顣ָʱΪУһΣѹ޹
+ * 
+ * @param journal ־
+ * @param index βζκ
+ * @return true ɹ
+ * @return false β޷ӳ
+ */
+static bool _tk_journal_recover_tail(struct tk_queue_journal *journal, uint64_t index)
+{
+    uint64_t seq = index * journal->segment_records;
+    uint64_t end = seq + journal->segment_records;
+    if (_tk_journal_map(journal, &journal->write_map, index, false) == false)
+        return false;
+    if (journal->committed > seq && journal->committed <= end)
+        seq = journal->committed;
+    for (; seq < end; seq++)
+    {
+        struct tk_journal_record *rec = _tk_journal_record(journal, &journal->write_map, seq);
+        if (rec->seq != (uint32_t)seq || rec->crc != _tk_journal_record_crc(seq, rec + 1, journal->queue_size))
+            break;
+    }
+    journal->tail = seq;
+    return true;
+}
+
+/**
+ * @brief ־Ŀ¼ȡ㲢ɨļָͷβλ(ڲ)
+ * 
+ * @param journal ־
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_journal_recover(struct tk_queue_journal *journal)
+{
+    char path[PATH_MAX];
+    struct dirent *entry;
+    uint64_t min = UINT64_MAX, max = 0;
+    DIR *dir;
+    if (mkdir(journal->dir, 0755) != 0 && errno != EEXIST)
+        return false;
+    snprintf(path, sizeof(path), "%s/" TK_JOURNAL_CHECKPOINT, journal->dir);
+    journal->checkpoint_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (journal->checkpoint_fd < 0)
+        return false;
+    _tk_journal_read_checkpoint(journal);
+    journal->head = journal->checkpoint;
+
+    /* ֻȡĿ¼ȡļ */
+    if ((dir = opendir(journal->dir)) == NULL)
+        return false;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        char *end;
+        uint64_t index;
+        if (strlen(entry->d_name) != TK_JOURNAL_NAME_LEN ||
+            strcmp(entry->d_name + 16, TK_JOURNAL_SUFFIX) != 0)
+            continue;
+        index = strtoull(entry->d_name, &end, 16);
+        if (end != entry->d_name + 16)
+            continue;
+        if (index < min)
+            min = index;
+        if (index > max)
+            max = index;
+    }
+    closedir(dir);
+
+    if (min == UINT64_MAX)
+    {
+        journal->tail = journal->head;
+        journal->oldest = journal->head / journal->segment_records;
+        return true;
+    }
+    journal->oldest = min;
+    if (_tk_journal_recover_tail(journal, max) == false)
+        return false;
+    /* ֮ǰĶοѱɾ֮ļ¼δ */
+    if (journal->head < min * journal->segment_records)
+        journal->head = min * journal->segment_records;
+    if (journal->head > journal->tail)
+        journal->head = journal->tail;
+    return true;
+}
+
+/**
+ * @brief ͷ־(ڲ)
+ * 
+ * @param journal ־
+ */
+static void _tk_journal_free(struct tk_queue_journal *journal)
+{
+    _tk_journal_unmap(journal, &journal->write_map);
+    _tk_journal_unmap(journal, &journal->read_map);
+    if (journal->checkpoint_fd >= 0)
+        close(journal->checkpoint_fd);
+    free(journal->dir);
+    free(journal);
+}
+
+/**
+ * @brief ־׷1¼
+ * 
+ * @param journal ־
+ * @param pval Ԫ
+ * @return true ɹ
+ * @return false ʧ(ļӳʧ)
+ */
+bool tk_journal_append(struct tk_queue_journal *journal, const void *pval)
+{
+    struct tk_journal_map *map;
+    struct tk_journal_record *rec;
+    size_t offset;
+    if ((map = _tk_journal_get_map(journal, journal->tail, true)) == NULL)
+        return false;
+    rec = _tk_journal_record(journal, map, journal->tail);
+    memcpy(rec + 1, pval, journal->queue_size);
+    rec->seq = (uint32_t)journal->tail;
+    rec->crc = _tk_journal_record_crc(journal->tail, pval, journal->queue_size);
+    offset = (uint8_t *)rec - map->base;
+    if (offset < map->dirty_begin)
+        map->dirty_begin = offset;
+    if (offset + journal->record_size > map->dirty_end)
+        map->dirty_end = offset + journal->record_size;
+    journal->tail++;
+    _tk_journal_pending(journal);
+    return true;
+}
+
+/**
+ * @brief ȡɵ1¼()
+ * 
+ * @param journal ־
+ * @param pval ȡֵ
+ * @return true ɹ
+ * @return false ʧ(־Ϊջļӳʧ)
+ */
+bool tk_journal_peep(struct tk_queue_journal *journal, void *pval)
+{
+    struct tk_journal_map *map;
+    if (journal->head == journal->tail)
+        return false;
+    if ((map = _tk_journal_get_map(journal, journal->head, false)) == NULL)
+        return false;
+    memcpy(pval, _tk_journal_record(journal, map, journal->head) + 1, journal->queue_size);
+    return true;
+}
+
+/**
+ * @brief ɵ1¼λ´ύʱд
+ * 
+ * @param journal ־
+ * @return true ɹ
+ * @return false ʧ(־Ϊ)
+ */
+bool tk_journal_consume(struct tk_queue_journal *journal)
+{
+    if (journal->head == journal->tail)
+        return false;
+    journal->head++;
+    /* һκӳ䣬ļڼ̺ɾ */
+    if (journal->head % journal->segment_records == 0 && journal->read_map.base != NULL &&
+        journal->read_map.index < journal->head / journal->segment_records)
+        _tk_journal_unmap(journal, &journal->read_map);
+    _tk_journal_pending(journal);
+    return true;
+}
+
+/**
+ * @brief ־ем¼ύ
+ * 
+ * @param journal ־
+ * @return true ɹ
+ * @return false ύʧ
+ */
+bool tk_journal_reset(struct tk_queue_journal *journal)
+{
+    journal->head = journal->tail;
+    return _tk_journal_commit(journal, false);
+}
+
+/**
+ * @brief ѯ־δѵļ¼
+ * 
+ * @param journal ־
+ * @return uint64_t ¼
+ */
+uint64_t tk_journal_len(struct tk_queue_journal *journal)
+{
+    return journal->tail - journal->head;
+}
+
+/**
+ * @brief Ϊд򿪳־û־־Ŀ¼ָδѵԪ
+ * 򿪺tk_queue_push/popȺΪд־лʹãֻܴ
+ * 
+ * @param queue жѳʼԪشС¼С
+ * @param dir ־Ŀ¼ʱԶͬһĿ¼ֻһд
+ * @param sync_batch ÿۼƶٴѹ/ԶύһΣ0Ϊֻڵtk_queue_journal_syncʱύ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_queue_journal_open(struct tk_queue *queue, const char *dir, uint32_t sync_batch)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(dir);
+    struct tk_queue_journal *journal;
+    if (queue == NULL || dir == NULL || queue->journal != NULL || queue->queue_size == 0)
+        return false;
+    if ((journal = calloc(1, sizeof(struct tk_queue_journal))) == NULL)
+        return false;
+    journal->checkpoint_fd = -1;
+    journal->queue_size = queue->queue_size;
+    journal->record_size = (sizeof(struct tk_journal_record) + queue->queue_size + 7) & ~7u;
+    journal->segment_records = (uint32_t)((TK_QUEUE_JOURNAL_SEGMENT_SIZE - TK_JOURNAL_HEADER_SIZE) / journal->record_size);
+    journal->segment_size = TK_JOURNAL_HEADER_SIZE + (size_t)journal->segment_records * journal->record_size;
+    journal->sync_batch = sync_batch;
+    if (journal->segment_records == 0 || (journal->dir = strdup(dir)) == NULL ||
+        _tk_journal_recover(journal) == false)
+    {
+        _tk_journal_free(journal);
+        return false;
+    }
+    _tk_journal_trim(journal);
+    queue->journal = journal;
+    queue->front = 0;
+    queue->rear = 0;
+    tk_queue_journal_len(queue);
+    return true;
+}
+
+/**
+ * @brief ύرնеĳ־û־лָΪʹûͨ(Ϊ)
+ * tk_queue_detachtk_queue_deleteԶر־
+ * 
+ * @param queue ж
+ * @return true ɹ
+ * @return false ʧ(δ־һύʧ)
+ */
+bool tk_queue_journal_close(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    bool result;
+    if (queue == NULL || queue->journal == NULL)
+        return false;
+    result = _tk_journal_commit(queue->journal, true) && queue->journal->failed == false;
+    _tk_journal_free(queue->journal);
+    queue->journal = NULL;
+    queue->len = 0;
+    return result;
+}
+
+/**
+ * @brief ύͬѹԪزдλü
+ * ڶʱڵãʵְʱύ
+ * 
+ * @param queue ж
+ * @return true ɹ
+ * @return false ʧ(λ֮ǰԶύʧ)
+ */
+bool tk_queue_journal_sync(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    bool result;
+    if (queue == NULL || queue->journal == NULL)
+        return false;
+    result = _tk_journal_commit(queue->journal, false) && queue->journal->failed == false;
+    queue->journal->failed = false;
+    return result;
+}
+
+/**
+ * @brief ѯ־δѵԪظ
+ * ͬʱˢtk_queue_curr_lenʹõĳȣ65535ʱtk_queue_curr_len65535
+ * 
+ * @param queue ж
+ * @return uint64_t Ԫظ
+ */
+uint64_t tk_queue_journal_len(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    uint64_t len;
+    if (queue == NULL || queue->journal == NULL)
+        return 0;
+    len = tk_journal_len(queue->journal);
+    queue->len = (len > UINT16_MAX) ? UINT16_MAX : (uint16_t)len;
+    return len;
+}
+#endif /* defined(TOOLKIT_USING_QUEUE) && defined(TK_QUEUE_USING_JOURNAL) */
@@ -0,0 +1,750 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     set time function only while stopped
+*/
+
+#define _GNU_SOURCE
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_LOG
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ־ʽ󳤶ȣֱض */
+#define TK_LOG_LINE_SIZE 256
+
+/* ʽ˵ӦĲ */
+typedef enum
+{
+    TK_LOG_ARG_NONE = 0, /* %%ֵ֧˵ */
+    TK_LOG_ARG_INT,
+    TK_LOG_ARG_LONG,
+    TK_LOG_ARG_LLONG,
+    TK_LOG_ARG_SIZE,
+    TK_LOG_ARG_INTMAX,
+    TK_LOG_ARG_PTRDIFF,
+    TK_LOG_ARG_DOUBLE,
+    TK_LOG_ARG_LDOUBLE,
+    TK_LOG_ARG_STRING,
+    TK_LOG_ARG_POINTER,
+} tk_log_arg_type;
+
+/* һʽ˵ */
+struct tk_log_spec
+{
+    const char *begin; /* ָ'%' */
+    const char *end;   /* ָ˵ַ֮ */
+    uint8_t stars;     /* 뾫'*'ĸÿ'*'ռһint */
+    uint8_t type;
+};
+
+/* ÿ߳һλɵ߳д롢־̶߳ */
+struct tk_log_ring
+{
+    struct tk_queue queue;
+    pthread_mutex_t lock;
+    uint64_t lost;
+    uint64_t reported;
+    bool exited;
+    struct tk_log_ring *next;
+    struct tk_log_record pool[TK_LOG_RING_SIZE];
+};
+
+struct tk_log
+{
+    bool running;
+    bool keep_fresh;
+    int fd;
+    pthread_t thread;
+    pthread_mutex_t list_lock;  /* rings */
+    pthread_mutex_t drain_lock; /* ־߳tk_log_flush */
+    struct tk_log_ring *rings;
+    uint64_t lost;              /* ͷŵĻλۼƶʧļ¼ */
+    uint64_t (*time_func)(void);
+    uint64_t units_per_second;
+    uint64_t base_units;
+    uint64_t base_ns;
+    time_t last_sec;
+    char last_prefix[24];
+    struct tk_log_record records[TK_LOG_BATCH_SIZE];
+    char lines[TK_LOG_BATCH_SIZE + 1][TK_LOG_LINE_SIZE];
+    struct iovec iov[TK_LOG_BATCH_SIZE + 1];
+};
+
+static struct tk_log tk_log_ctx = {
+    .running = false,
+    .fd = -1,
+    .list_lock = PTHREAD_MUTEX_INITIALIZER,
+    .drain_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+static __thread struct tk_log_ring *tk_log_curr_ring = NULL;
+static pthread_key_t tk_log_key;
+static pthread_once_t tk_log_key_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Ĭʱ亯CLOCK_REALTIME(ڲ)
+ * 
+ * @return uint64_t ǰʱ
+ */
+static uint64_t _tk_log_realtime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief ߳˳ʱ价λ־̶߳պͷ(ڲ)
+ * 
+ * @param arg λ
+ */
+static void _tk_log_thread_exit(void *arg)
+{
+    struct tk_log_ring *ring = (struct tk_log_ring *)arg;
+    __atomic_store_n(&ring->exited, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief ߳˳֪ͨʹõkey(ڲ)
+ * 
+ */
+static void _tk_log_key_create(void)
+{
+    pthread_key_create(&tk_log_key, _tk_log_thread_exit);
+}
+
+/**
+ * @brief Ϊǰ̴߳λ(ڲ)
+ * 
+ * @return struct tk_log_ring* λNULLΪʧ
+ */
+static struct tk_log_ring *_tk_log_ring_create(void)
+{
+    struct tk_log_ring *ring = (struct tk_log_ring *)calloc(1, sizeof(struct tk_log_ring));
+    if (ring == NULL)
+        return NULL;
+    tk_queue_init(&ring->queue, ring->pool, sizeof(ring->pool), sizeof(struct tk_log_record),
+                  tk_log_ctx.keep_fresh);
+    pthread_mutex_init(&ring->lock, NULL);
+    pthread_once(&tk_log_key_once, _tk_log_key_create);
+    pthread_setspecific(tk_log_key, ring);
+    pthread_mutex_lock(&tk_log_ctx.list_lock);
+    ring->next = tk_log_ctx.rings;
+    tk_log_ctx.rings = ring;
+    pthread_mutex_unlock(&tk_log_ctx.list_lock);
+    tk_log_curr_ring = ring;
+    return ring;
+}
+
+/**
+ * @brief һʽ˵(ڲ)
+ * дʱ˵ȡʽʱͬĹԭ
+ * 
+ * @param p ָ'%'
+ * @param spec 
+ */
+static void _tk_log_parse_spec(const char *p, struct tk_log_spec *spec)
+{
+    uint8_t length = 0; /* 0: 1:h 2:hh 3:l 4:ll 5:z 6:j 7:t 8:L */
+    spec->begin = p++;
+    spec->stars = 0;
+    spec->type = TK_LOG_ARG_NONE;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' || *p == '\'')
+        p++;
+    if (*p == '*')
+    {
+        spec->stars++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec->stars++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+    switch (*p)
+    {
+    case 'h':
+        length = (p[1] == 'h') ? 2 : 1;
+        p += length;
+        break;
+    case 'l':
+        length = (p[1] == 'l') ? 4 : 3;
+        p += length - 2;
+        break;
+    case 'q':
+        length = 4;
+        p++;
+        break;
+    case 'z':
+        length = 5;
+        p++;
+        break;
+    case 'j':
+        length = 6;
+        p++;
+        break;
+    case 't':
+        length = 7;
+        p++;
+        break;
+    case 'L':
+        length = 8;
+        p++;
+        break;
+    default:
+        break;
+    }
+    switch (*p)
+    {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+        spec->type = (length == 3) ? TK_LOG_ARG_LONG : (length == 4) ? TK_LOG_ARG_LLONG
+                   : (length == 5) ? TK_LOG_ARG_SIZE : (length == 6) ? TK_LOG_ARG_INTMAX
+                   : (length == 7) ? TK_LOG_ARG_PTRDIFF : TK_LOG_ARG_INT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->type = (length == 8) ? TK_LOG_ARG_LDOUBLE : TK_LOG_ARG_DOUBLE;
+        break;
+    case 's':
+        spec->type = TK_LOG_ARG_STRING;
+        break;
+    case 'p':
+        spec->type = TK_LOG_ARG_POINTER;
+        break;
+    default:
+        /* %%ֵ֧˵(%n)ռò */
+        spec->stars = 0;
+        break;
+    }
+    spec->end = (*p != '\0') ? p + 1 : p;
+}
+
+/**
+ * @brief õʽַиͣÿõֻһ(ڲ)
+ * ߳ͬʱ״εʱظͬ
+ * 
+ * @param site õ
+ */
+static void _tk_log_site_parse(struct tk_log_site *site)
+{
+    struct tk_log_spec spec;
+    const char *p = site->fmt;
+    uint8_t argc = 0;
+    while ((p = strchr(p, '%')) != NULL)
+    {
+        _tk_log_parse_spec(p, &spec);
+        p = spec.end;
+        if (spec.type == TK_LOG_ARG_NONE)
+            continue;
+        if (argc + spec.stars >= TK_LOG_MAX_ARGS)
+            break;
+        for (uint8_t i = 0; i < spec.stars; i++)
+            site->types[argc++] = TK_LOG_ARG_INT;
+        site->types[argc++] = spec.type;
+    }
+    site->argc = argc;
+    __atomic_store_n(&site->ready, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief õĲȡ¼ַ¼text(ڲ)
+ * 
+ * @param record ־¼
+ * @param site õ
+ * @param ap б
+ */
+static void _tk_log_capture(struct tk_log_record *record, const struct tk_log_site *site, va_list ap)
+{
+    uint16_t text_len = 0;
+    for (uint8_t i = 0; i < site->argc; i++)
+    {
+        switch (site->types[i])
+        {
+        case TK_LOG_ARG_INT:
+            record->args[i] = (uint64_t)(int64_t)va_arg(ap, int);
+            break;
+        case TK_LOG_ARG_LONG:
+            record->args[i] = (uint64_t)va_arg(ap, long);
+            break;
+        case TK_LOG_ARG_LLONG:
+            record->args[i] = (uint64_t)va_arg(ap, long long);
+            break;
+        case TK_LOG_ARG_SIZE:
+            record->args[i] = (uint64_t)va_arg(ap, size_t);
+            break;
+        case TK_LOG_ARG_INTMAX:
+            record->args[i] = (uint64_t)va_arg(ap, intmax_t);
+            break;
+        case TK_LOG_ARG_PTRDIFF:
+            record->args[i] = (uint64_t)va_arg(ap, ptrdiff_t);
+            break;
+        case TK_LOG_ARG_DOUBLE:
+        case TK_LOG_ARG_LDOUBLE:
+        {
+            double value = (site->types[i] == TK_LOG_ARG_DOUBLE) ? va_arg(ap, double) : (double)va_arg(ap, long double);
+            memcpy(&record->args[i], &value, sizeof(value));
+            break;
+        }
+        case TK_LOG_ARG_STRING:
+        {
+            const char *str = va_arg(ap, const char *);
+            /* ¼textеƫƣUINT64_MAXʾNULL */
+            record->args[i] = UINT64_MAX;
+            if (str == NULL || text_len >= TK_LOG_TEXT_SIZE)
+                break;
+            record->args[i] = text_len;
+            while (*str != '\0' && text_len < TK_LOG_TEXT_SIZE - 1)
+                record->text[text_len++] = *str++;
+            record->text[text_len++] = '\0';
+            break;
+        }
+        case TK_LOG_ARG_POINTER:
+            record->args[i] = (uint64_t)(uintptr_t)va_arg(ap, void *);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief ʱǰ׺"YYYY-MM-DD HH:MM:SS.uuuuuu "(ڲ)
+ * 
+ * @param time ¼ʱ
+ * @param out 
+ * @param size С
+ * @return size_t д볤
+ */
+static size_t _tk_log_format_time(uint64_t time, char *out, size_t size)
+{
+    struct tk_log *log = &tk_log_ctx;
+    int64_t delta = (int64_t)(time - log->base_units);
+    uint64_t ns = log->base_ns + (int64_t)((double)delta * 1e9 / (double)log->units_per_second);
+    time_t sec = (time_t)(ns / 1000000000ULL);
+    int len;
+    if (sec != log->last_sec)
+    {
+        struct tm tm;
+        localtime_r(&sec, &tm);
+        strftime(log->last_prefix, sizeof(log->last_prefix), "%Y-%m-%d %H:%M:%S", &tm);
+        log->last_sec = sec;
+    }
+    len = snprintf(out, size, "%s.%06u ", log->last_prefix, (unsigned)(ns % 1000000000ULL / 1000));
+    return (len < 0) ? 0 : ((size_t)len >= size ? size - 1 : (size_t)len);
+}
+
+/**
+ * @brief ־߳н¼ʽΪһı(ڲ)
+ * 
+ * @param record ־¼
+ * @param out СΪTK_LOG_LINE_SIZE
+ * @return size_t ı
+ */
+static size_t _tk_log_format(const struct tk_log_record *record, char *out)
+{
+    struct tk_log_spec spec;
+    const char *p = record->site->fmt;
+    size_t size = TK_LOG_LINE_SIZE - 1; /* Ԥз */
+    size_t len = _tk_log_format_time(record->time, out, size);
+    uint8_t argc = 0;
+    while (*p != '\0' && len < size)
+    {
+        char buf[64];
+        size_t n = 0;
+        int written;
+        if (*p != '%')
+        {
+            out[len++] = *p++;
+            continue;
+        }
+        _tk_log_parse_spec(p, &spec);
+        p = spec.end;
+        if (spec.type == TK_LOG_ARG_NONE)
+        {
+            if (spec.end - spec.begin == 2 && spec.begin[1] == '%')
+                out[len++] = '%';
+            continue;
+        }
+        if (argc + spec.stars >= TK_LOG_MAX_ARGS || (size_t)(spec.end - spec.begin) > 16)
+        {
+            /* TK_LOG_MAX_ARGS˺˵ԭ */
+            argc = TK_LOG_MAX_ARGS;
+            for (const char *c = spec.begin; c < spec.end && len < size; c++)
+                out[len++] = *c;
+            continue;
+        }
+        /* ؽ˵'*'滻Ϊ¼ֵȥ˫ȵ'L' */
+        for (const char *c = spec.begin; c < spec.end; c++)
+        {
+            if (*c == '*')
+                n += (size_t)snprintf(buf + n, sizeof(buf) - n, "%d", (int)record->args[argc++]);
+            else if (*c != 'L')
+                buf[n++] = *c;
+        }
+        buf[n] = '\0';
+        switch (spec.type)
+        {
+        case TK_LOG_ARG_INT:
+            written = snprintf(out + len, size + 1 - len, buf, (int)record->args[argc]);
+            break;
+        case TK_LOG_ARG_LONG:
+            written = snprintf(out + len, size + 1 - len, buf, (long)record->args[argc]);
+            break;
+        case TK_LOG_ARG_LLONG:
+            written = snprintf(out + len, size + 1 - len, buf, (long long)record->args[argc]);
+            break;
+        case TK_LOG_ARG_SIZE:
+            written = snprintf(out + len, size + 1 - len, buf, (size_t)record->args[argc]);
+            break;
+        case TK_LOG_ARG_INTMAX:
+            written = snprintf(out + len, size + 1 - len, buf, (intmax_t)record->args[argc]);
+            break;
+        case TK_LOG_ARG_PTRDIFF:
+            written = snprintf(out + len, size + 1 - len, buf, (ptrdiff_t)record->args[argc]);
+            break;
+        case TK_LOG_ARG_DOUBLE:
+        case TK_LOG_ARG_LDOUBLE:
+        {
+            double value;
+            memcpy(&value, &record->args[argc], sizeof(value));
+            written = snprintf(out + len, size + 1 - len, buf, value);
+            break;
+        }
+        case TK_LOG_ARG_STRING:
+            written = snprintf(out + len, size + 1 - len, buf,
+                               (record->args[argc] < TK_LOG_TEXT_SIZE) ? record->text + record->args[argc] : "(null)");
+            break;
+        case TK_LOG_ARG_POINTER:
+            written = snprintf(out + len, size + 1 - len, buf, (void *)(uintptr_t)record->args[argc]);
+            break;
+        default:
+            written = 0;
+            break;
+        }
+        argc++;
+        if (written > 0)
+            len = ((size_t)written > size - len) ? size : len + (size_t)written;
+    }
+    if (len == 0 || out[len - 1] != '\n')
+        out[len++] = '\n';
+    return len;
+}
+
+/**
+ * @brief дiovecд(ڲ)
+ * 
+ * @param iov iovec飬ᱻ޸
+ * @param count 
+ */
+static void _tk_log_writev(struct iovec *iov, int count)
+{
+    while (count > 0)
+    {
+        ssize_t n = writev(tk_log_ctx.fd, iov, count);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        while (count > 0 && (size_t)n >= iov->iov_len)
+        {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0)
+        {
+            iov->iov_base = (uint8_t *)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+}
+
+/**
+ * @brief һλем¼д(ڲ)
+ * ֻڿ¼ʱлʽϵͳö
+ * 
+ * @param ring λ
+ * @return uint32_t дļ¼
+ */
+static uint32_t _tk_log_drain_ring(struct tk_log_ring *ring)
+{
+    struct tk_log *log = &tk_log_ctx;
+    uint32_t total = 0;
+    uint16_t num;
+    do
+    {
+        uint64_t lost;
+        int count = 0;
+        pthread_mutex_lock(&ring->lock);
+        num = tk_queue_pop_multi(&ring->queue, log->records, TK_LOG_BATCH_SIZE);
+        lost = ring->lost;
+        pthread_mutex_unlock(&ring->lock);
+        if (lost != ring->reported)
+        {
+            int len = snprintf(log->lines[TK_LOG_BATCH_SIZE], TK_LOG_LINE_SIZE, "tk_log: %llu records lost\n",
+                               (unsigned long long)(lost - ring->reported));
+            log->iov[count].iov_base = log->lines[TK_LOG_BATCH_SIZE];
+            log->iov[count++].iov_len = (size_t)len;
+            ring->reported = lost;
+        }
+        for (uint16_t i = 0; i < num; i++)
+        {
+            log->iov[count].iov_base = log->lines[i];
+            log->iov[count++].iov_len = _tk_log_format(&log->records[i], log->lines[i]);
+        }
+        _tk_log_writev(log->iov, count);
+        total += num;
+    } while (num == TK_LOG_BATCH_SIZE);
+    return total;
+}
+
+/**
+ * @brief ̵߳ļ¼ͷ˳̵߳Ļλ(ڲ)
+ * 
+ * @return uint32_t дļ¼
+ */
+static uint32_t _tk_log_drain(void)
+{
+    struct tk_log *log = &tk_log_ctx;
+    struct tk_log_ring **link;
+    uint32_t total = 0;
+    pthread_mutex_lock(&log->drain_lock);
+    pthread_mutex_lock(&log->list_lock);
+    link = &log->rings;
+    while (*link != NULL)
+    {
+        struct tk_log_ring *ring = *link;
+        bool exited = __atomic_load_n(&ring->exited, __ATOMIC_ACQUIRE);
+        total += _tk_log_drain_ring(ring);
+        if (exited)
+        {
+            *link = ring->next;
+            log->lost += ring->lost;
+            pthread_mutex_destroy(&ring->lock);
+            free(ring);
+            continue;
+        }
+        link = &ring->next;
+    }
+    pthread_mutex_unlock(&log->list_lock);
+    pthread_mutex_unlock(&log->drain_lock);
+    return total;
+}
+
+/**
+ * @brief ־̣߳ڶ̵߳ļ¼д(ڲ)
+ * 
+ * @param arg δʹ
+ * @return void* NULL
+ */
+static void *_tk_log_thread(void *arg)
+{
+    struct timespec ts = {TK_LOG_FLUSH_MS / 1000, (TK_LOG_FLUSH_MS % 1000) * 1000000L};
+    (void)arg;
+    while (__atomic_load_n(&tk_log_ctx.running, __ATOMIC_ACQUIRE))
+    {
+        if (_tk_log_drain() == 0)
+            nanosleep(&ts, NULL);
+    }
+    return NULL;
+}
+
+/**
+ * @brief ־ʱ亯ĬΪCLOCK_REALTIME
+ * Ϊrdtscȸʱʱʱ̻Ϊʱ
+ * ־̶߳ȡʱ亯ͻʱֻ־߳δʱ
+ * 
+ * @param time_func ʱ亯NULLָĬ
+ * @param units_per_second ʱ亯ÿļ
+ * @return true ɹ
+ * @return false ʧ(־߳)
+ */
+bool tk_log_set_time_func(uint64_t (*time_func)(void), uint64_t units_per_second)
+{
+    if (__atomic_load_n(&tk_log_ctx.running, __ATOMIC_ACQUIRE))
+        return false;
+    if (time_func == NULL || units_per_second == 0)
+    {
+        time_func = _tk_log_realtime;
+        units_per_second = 1000000000ULL;
+    }
+    tk_log_ctx.base_ns = _tk_log_realtime();
+    tk_log_ctx.base_units = time_func();
+    tk_log_ctx.units_per_second = units_per_second;
+    tk_log_ctx.time_func = time_func;
+    return true;
+}
+
+/**
+ * @brief ־߳
+ * 
+ * @param fd ־ļSTDERR_FILENO򿪵־ļ
+ * @param keep_fresh ʱĴʽtrueɵļ¼ false¼¼ַʽ붪ʧ
+ * @return true ɹ
+ * @return false ʧ(̴߳ʧ)
+ */
+bool tk_log_start(int fd, bool keep_fresh)
+{
+    struct tk_log *log = &tk_log_ctx;
+    TK_ASSERT(fd >= 0);
+    if (fd < 0 || log->running)
+        return false;
+    if (log->time_func == NULL)
+        tk_log_set_time_func(NULL, 0);
+    log->fd = fd;
+    log->keep_fresh = keep_fresh;
+    log->last_sec = (time_t)-1;
+    pthread_mutex_lock(&log->list_lock);
+    for (struct tk_log_ring *ring = log->rings; ring != NULL; ring = ring->next)
+        ring->queue.keep_fresh = keep_fresh;
+    pthread_mutex_unlock(&log->list_lock);
+    __atomic_store_n(&log->running, true, __ATOMIC_RELEASE);
+    if (pthread_create(&log->thread, NULL, _tk_log_thread, NULL) != 0)
+    {
+        log->running = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ֹͣ־̣߳дʣ¼
+ * ̵߳Ļλ߳˳ٴʹ
+ * 
+ * @return true ɹ
+ * @return false ʧ(δ)
+ */
+bool tk_log_stop(void)
+{
+    struct tk_log *log = &tk_log_ctx;
+    if (log->running == false)
+        return false;
+    __atomic_store_n(&log->running, false, __ATOMIC_RELEASE);
+    pthread_join(log->thread, NULL);
+    while (_tk_log_drain() != 0)
+        ;
+    return true;
+}
+
+/**
+ * @brief ڵǰ߳д߳дļ¼
+ * 
+ * @return true ɹ
+ * @return false ʧ(δ)
+ */
+bool tk_log_flush(void)
+{
+    if (__atomic_load_n(&tk_log_ctx.running, __ATOMIC_ACQUIRE) == false)
+        return false;
+    while (_tk_log_drain() != 0)
+        ;
+    return true;
+}
+
+/**
+ * @brief ѯ򻺳ʧ(򱻸)ļ¼
+ * 
+ * @return uint64_t ʧļ¼
+ */
+uint64_t tk_log_lost(void)
+{
+    struct tk_log *log = &tk_log_ctx;
+    uint64_t lost;
+    pthread_mutex_lock(&log->list_lock);
+    lost = log->lost;
+    for (struct tk_log_ring *ring = log->rings; ring != NULL; ring = ring->next)
+        lost += __atomic_load_n(&ring->lost, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&log->list_lock);
+    return lost;
+}
+
+/**
+ * @brief дһ־ֻ¼õ㡢ʱ䣬־̸߳ʽһͨTK_LOG
+ * %sڵʱÿ¼TK_LOG_TEXT_SIZEֽڣֱضϣ¼TK_LOG_MAX_ARGS
+ * 
+ * @param site õ㣬ʽַprintfͬ
+ * @param ... 
+ * @return true ɹ
+ * @return false ʧ(־δ򻺳ҲǱģʽ)
+ */
+bool tk_log_write(struct tk_log_site *site, ...)
+{
+    struct tk_log_ring *ring = tk_log_curr_ring;
+    struct tk_log_record record;
+    bool result = true;
+    va_list ap;
+    TK_ASSERT(site);
+    /* acquiretk_log_startԣʱtime_func */
+    if (site == NULL || __atomic_load_n(&tk_log_ctx.running, __ATOMIC_ACQUIRE) == false)
+        return false;
+    if (ring == NULL && (ring = _tk_log_ring_create()) == NULL)
+        return false;
+    if (__atomic_load_n(&site->ready, __ATOMIC_ACQUIRE) == false)
+        _tk_log_site_parse(site);
+    record.site = site;
+    record.time = tk_log_ctx.time_func();
+    va_start(ap, site);
+    _tk_log_capture(&record, site, ap);
+    va_end(ap);
+    pthread_mutex_lock(&ring->lock);
+    if (tk_queue_full(&ring->queue))
+    {
+        __atomic_store_n(&ring->lost, ring->lost + 1, __ATOMIC_RELAXED);
+        result = ring->queue.keep_fresh;
+    }
+    if (result)
+        tk_queue_push(&ring->queue, &record);
+    pthread_mutex_unlock(&ring->lock);
+    return result;
+}
+#endif /* TOOLKIT_USING_LOG */
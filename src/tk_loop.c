@@ -0,0 +1,419 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     drive timers by epoll timeout without timerfd
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_LOOP
+#include <sys/epoll.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+typedef enum
+{
+    TK_LOOP_WATCH_FD = 0,
+    TK_LOOP_WATCH_QUEUE,
+    TK_LOOP_WATCH_EVENT,
+    TK_LOOP_WATCH_TIMER,
+} tk_loop_watch_type;
+
+/**
+ * @brief Ӷepoll(ڲ)
+ * 
+ * @param loop ¼ѭ
+ * @param watch Ӷ
+ * @param fd ļ
+ * @param events epoll¼
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_loop_watch_add(struct tk_loop *loop, struct tk_loop_watch *watch,
+                               int fd, uint32_t events)
+{
+    struct epoll_event ev;
+    if (fd < 0)
+        return false;
+    watch->fd = fd;
+    watch->loop = loop;
+    ev.events = events;
+    ev.data.ptr = watch;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+    {
+        watch->loop = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ̬ʼ¼ѭ
+ * ¼ѭͬʱʱĳʱTK_TIMER_USING_FDʱtimerfd
+ * 糬ʱʱepollȴʱ䣬ʱtickλTK_TIMER_TICK_PER_SECONDһ
+ * 
+ * @param loop Ҫʼ¼ѭ
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_loop_init(struct tk_loop *loop)
+{
+    TK_ASSERT(loop);
+    if (loop == NULL)
+        return false;
+    loop->running = false;
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd < 0)
+        return false;
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_FD)
+    loop->timer_watch.type = TK_LOOP_WATCH_TIMER;
+    loop->timer_watch.source = NULL;
+    loop->timer_watch.callback = NULL;
+    if (_tk_loop_watch_add(loop, &loop->timer_watch, tk_timer_get_fd(), EPOLLIN) == false)
+    {
+        close(loop->epoll_fd);
+        loop->epoll_fd = -1;
+        return false;
+    }
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_FD) */
+    return true;
+}
+
+/**
+ * @brief ̬¼ѭ
+ * 
+ * @param loop Ҫ¼ѭ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_loop_detach(struct tk_loop *loop)
+{
+    TK_ASSERT(loop);
+    if (loop == NULL)
+        return false;
+    if (loop->epoll_fd >= 0)
+        close(loop->epoll_fd);
+    loop->epoll_fd = -1;
+    loop->running = false;
+    return true;
+}
+
+#ifdef TK_LOOP_USING_CREATE
+/**
+ * @brief ̬¼ѭ
+ * 
+ * @return struct tk_loop* ¼ѭNULLΪʧ
+ */
+struct tk_loop *tk_loop_create(void)
+{
+    struct tk_loop *loop;
+    if ((loop = malloc(sizeof(struct tk_loop))) == NULL)
+        return NULL;
+    if (tk_loop_init(loop) == false)
+    {
+        free(loop);
+        return NULL;
+    }
+    return loop;
+}
+
+/**
+ * @brief ̬ɾ¼ѭ
+ * 
+ * @param loop Ҫɾ¼ѭ
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_loop_delete(struct tk_loop *loop)
+{
+    TK_ASSERT(loop);
+    if (tk_loop_detach(loop) == false)
+        return false;
+    free(loop);
+    return true;
+}
+#endif /* TK_LOOP_USING_CREATE */
+
+/**
+ * @brief ļ
+ * 
+ * @param loop ¼ѭ
+ * @param watch Ӷ
+ * @param fd Ҫӵļ
+ * @param events epoll¼EPOLLIN
+ * @param callback ص
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_loop_add_fd(struct tk_loop *loop, struct tk_loop_watch *watch, int fd, uint32_t events,
+                    void (*callback)(struct tk_loop_watch *watch))
+{
+    TK_ASSERT(loop);
+    TK_ASSERT(watch);
+    TK_ASSERT(callback);
+    if (loop == NULL || watch == NULL)
+        return false;
+    watch->type = TK_LOOP_WATCH_FD;
+    watch->source = NULL;
+    watch->revents = 0;
+    watch->callback = callback;
+    return _tk_loop_watch_add(loop, watch, fd, events);
+}
+
+#if defined(TOOLKIT_USING_QUEUE) && defined(TK_QUEUE_USING_FD)
+/**
+ * @brief ӶУзǿʱûص
+ * صӦȡݣδȡʱ´ѭٴλص
+ * 
+ * @param loop ¼ѭ
+ * @param watch Ӷ
+ * @param queue ҪӵĶж
+ * @param callback зǿջص
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_loop_add_queue(struct tk_loop *loop, struct tk_loop_watch *watch, struct tk_queue *queue,
+                       void (*callback)(struct tk_loop_watch *watch))
+{
+    TK_ASSERT(loop);
+    TK_ASSERT(watch);
+    TK_ASSERT(queue);
+    TK_ASSERT(callback);
+    if (loop == NULL || watch == NULL || queue == NULL)
+        return false;
+    watch->type = TK_LOOP_WATCH_QUEUE;
+    watch->source = queue;
+    watch->callback = callback;
+    return _tk_loop_watch_add(loop, watch, tk_queue_get_fd(queue), EPOLLIN);
+}
+#endif /* defined(TOOLKIT_USING_QUEUE) && defined(TK_QUEUE_USING_FD) */
+
+#if defined(TOOLKIT_USING_EVENT) && defined(TK_EVENT_USING_FD)
+/**
+ * @brief ¼ʱ¼ûص
+ * յı־watch->recved
+ * 
+ * @param loop ¼ѭ
+ * @param watch Ӷ
+ * @param event Ҫӵ¼
+ * @param event_set Ȥı־ÿ־ռ1Bit־"|"
+ * @param option :־룺TK_EVENT_OPTION_AND; ־TK_EVENT_OPTION_OR; ־:TK_EVENT_OPTION_CLEAR
+ * @param callback ¼ص
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_loop_add_event(struct tk_loop *loop, struct tk_loop_watch *watch, struct tk_event *event,
+                       uint32_t event_set, uint8_t option,
+                       void (*callback)(struct tk_loop_watch *watch))
+{
+    TK_ASSERT(loop);
+    TK_ASSERT(watch);
+    TK_ASSERT(event);
+    TK_ASSERT(callback);
+    if (loop == NULL || watch == NULL || event == NULL)
+        return false;
+    watch->type = TK_LOOP_WATCH_EVENT;
+    watch->source = event;
+    watch->event_set = event_set;
+    watch->option = option;
+    watch->recved = 0;
+    watch->callback = callback;
+    return _tk_loop_watch_add(loop, watch, tk_event_get_fd(event, event_set, option), EPOLLIN);
+}
+#endif /* defined(TOOLKIT_USING_EVENT) && defined(TK_EVENT_USING_FD) */
+
+/**
+ * @brief ƳӶ󣬿ڻصе
+ * 
+ * @param watch ҪƳļӶ
+ * @return true Ƴɹ
+ * @return false Ƴʧ
+ */
+bool tk_loop_remove(struct tk_loop_watch *watch)
+{
+    TK_ASSERT(watch);
+    if (watch == NULL || watch->loop == NULL)
+        return false;
+    epoll_ctl(watch->loop->epoll_fd, EPOLL_CTL_DEL, watch->fd, NULL);
+    watch->loop = NULL;
+    return true;
+}
+
+/**
+ * @brief ַļӶ(ڲ)
+ * 
+ * @param watch Ӷ
+ * @param revents epoll¼
+ * @return true ѵûص
+ * @return false δûص
+ */
+static bool _tk_loop_dispatch(struct tk_loop_watch *watch, uint32_t revents)
+{
+    switch (watch->type)
+    {
+    case TK_LOOP_WATCH_TIMER:
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_FD)
+        tk_timer_fd_handler();
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_FD) */
+        return true;
+#if defined(TOOLKIT_USING_EVENT) && defined(TK_EVENT_USING_FD)
+    case TK_LOOP_WATCH_EVENT:
+        if (tk_event_recv((struct tk_event *)watch->source, watch->event_set,
+                          watch->option, &watch->recved) == false)
+            return false;
+        break;
+#endif /* defined(TOOLKIT_USING_EVENT) && defined(TK_EVENT_USING_FD) */
+    case TK_LOOP_WATCH_FD:
+        watch->revents = revents;
+        break;
+    default:
+        break;
+    }
+    watch->callback(watch);
+    return true;
+}
+
+#if defined(TOOLKIT_USING_TIMER) && !defined(TK_TIMER_USING_FD)
+/**
+ * @brief 糬ʱʱepollȴʱ(ڲ)
+ * 
+ * @param timeout_ms ָȴʱ(λms)-1Ϊһֱȴ
+ * @return int ʵʵȴʱ(λms)
+ */
+static int _tk_loop_timer_timeout(int timeout_ms)
+{
+    uint32_t next, delta;
+    uint64_t wait_ms;
+    if (tk_timer_get_next_tick(&next) == false)
+        return timeout_ms;
+    delta = next - tk_timer_get_curr_tick();
+    if (delta == 0 || delta > (UINT32_MAX / 2))
+        return 0;
+    /* ȡǰת */
+    wait_ms = ((uint64_t)delta * 1000ULL + TK_TIMER_TICK_PER_SECOND - 1) / TK_TIMER_TICK_PER_SECOND;
+    if (wait_ms > INT_MAX)
+        wait_ms = INT_MAX;
+    if (timeout_ms < 0 || (int)wait_ms < timeout_ms)
+        return (int)wait_ms;
+    return timeout_ms;
+}
+
+/**
+ * @brief 糬ʱʱѵʱʱ(ڲ)
+ * 
+ * @return true Ѵʱ
+ * @return false ޳ʱĶʱ
+ */
+static bool _tk_loop_timer_handler(void)
+{
+    uint32_t next;
+    if (tk_timer_get_next_tick(&next) == false)
+        return false;
+    if ((uint32_t)(tk_timer_get_curr_tick() - next) > (UINT32_MAX / 2))
+        return false;
+    return tk_timer_loop_handler();
+}
+#endif /* defined(TOOLKIT_USING_TIMER) && !defined(TK_TIMER_USING_FD) */
+
+/**
+ * @brief ִһ¼ѭ
+ * ʱʱ¼зǿջļȻַص
+ * 
+ * @param loop ¼ѭ
+ * @param timeout_ms ȴʱ(λms)-1Ϊһֱȴ
+ * @return int ηַĻص-1Ϊ쳣
+ */
+int tk_loop_run_once(struct tk_loop *loop, int timeout_ms)
+{
+    TK_ASSERT(loop);
+    struct epoll_event events[TK_LOOP_MAX_EVENTS];
+    int dispatched = 0;
+    int i, n;
+    if (loop == NULL || loop->epoll_fd < 0)
+        return -1;
+#if defined(TOOLKIT_USING_TIMER) && !defined(TK_TIMER_USING_FD)
+    timeout_ms = _tk_loop_timer_timeout(timeout_ms);
+#endif /* defined(TOOLKIT_USING_TIMER) && !defined(TK_TIMER_USING_FD) */
+    n = epoll_wait(loop->epoll_fd, events, TK_LOOP_MAX_EVENTS, timeout_ms);
+    if (n < 0)
+        return (errno == EINTR) ? 0 : -1;
+    for (i = 0; i < n; i++)
+    {
+        struct tk_loop_watch *watch = events[i].data.ptr;
+        /* ͬѱǰĻصƳ */
+        if (watch->loop != loop)
+            continue;
+        if (_tk_loop_dispatch(watch, events[i].events) == true)
+            dispatched++;
+    }
+#if defined(TOOLKIT_USING_TIMER) && !defined(TK_TIMER_USING_FD)
+    if (_tk_loop_timer_handler() == true)
+        dispatched++;
+#endif /* defined(TOOLKIT_USING_TIMER) && !defined(TK_TIMER_USING_FD) */
+    return dispatched;
+}
+
+/**
+ * @brief ¼ѭֱtk_loop_stop
+ * 
+ * @param loop ¼ѭ
+ * @return true ˳
+ * @return false 쳣
+ */
+bool tk_loop_run(struct tk_loop *loop)
+{
+    TK_ASSERT(loop);
+    if (loop == NULL)
+        return false;
+    loop->running = true;
+    while (loop->running == true)
+    {
+        if (tk_loop_run_once(loop, -1) < 0)
+        {
+            loop->running = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief ֹͣ¼ѭڻصе
+ * 
+ * @param loop ¼ѭ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_loop_stop(struct tk_loop *loop)
+{
+    TK_ASSERT(loop);
+    if (loop == NULL)
+        return false;
+    loop->running = false;
+    return true;
+}
+
+#endif /* TOOLKIT_USING_LOOP */
@@ -0,0 +1,234 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_MAILBOX
+
+/*
+ * д߶ߵֵ(˫seqlock)
+ * vдʹûv&1дȽûseqΪv*2+1()ɺΪv*2ٷversion=v
+ * ߰versionҵǰûseqversion*2˵һݣ¶ȡversion
+ * д߱ռڿ;ʱversionָһĻ߲˵ȴ
+ * ֻһζȡԽдһдʱҪԡ߲дڴ棬ٶҲдߡ
+ */
+
+/**
+ * @brief (ڲ)
+ * 
+ * @param mailbox 
+ * @param valuepool ݻ
+ * @param value_size ݴС(λֽ)
+ */
+static void _tk_mailbox_setup(struct tk_mailbox *mailbox, void *valuepool, uint32_t value_size)
+{
+    mailbox->version = 0;
+    mailbox->seq[0] = 0;
+    mailbox->seq[1] = 0;
+    mailbox->value_size = value_size;
+    mailbox->value_pool = valuepool;
+}
+
+/**
+ * @brief ̬ʼ
+ * 
+ * @param mailbox 
+ * @param valuepool ݻд
+ * @param pool_size С(λֽ)СTK_MAILBOX_POOL_SIZE(value_size)
+ * @param value_size ݴС(λֽ)
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_mailbox_init(struct tk_mailbox *mailbox, void *valuepool, uint32_t pool_size, uint32_t value_size)
+{
+    TK_ASSERT(mailbox);
+    TK_ASSERT(valuepool);
+    TK_ASSERT(value_size);
+    if (mailbox == NULL || valuepool == NULL || value_size == 0)
+        return false;
+    if (pool_size / 2 < value_size)
+        return false;
+    _tk_mailbox_setup(mailbox, valuepool, value_size);
+    return true;
+}
+
+/**
+ * @brief ̬䣬ǰȷûжڶȡ
+ * 
+ * @param mailbox Ҫ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_mailbox_detach(struct tk_mailbox *mailbox)
+{
+    TK_ASSERT(mailbox);
+    if (mailbox == NULL)
+        return false;
+    _tk_mailbox_setup(mailbox, NULL, mailbox->value_size);
+    return true;
+}
+
+#ifdef TK_MAILBOX_USING_CREATE
+/**
+ * @brief ̬
+ * 
+ * @param value_size ݴС(λֽ)
+ * @return struct tk_mailbox* NULLΪʧ
+ */
+struct tk_mailbox *tk_mailbox_create(uint32_t value_size)
+{
+    TK_ASSERT(value_size);
+    struct tk_mailbox *mailbox;
+    void *valuepool;
+    if (value_size == 0 || value_size > 0x7FFFFFFFUL)
+        return NULL;
+    if ((mailbox = malloc(sizeof(struct tk_mailbox))) == NULL)
+        return NULL;
+    if ((valuepool = malloc(TK_MAILBOX_POOL_SIZE((size_t)value_size))) == NULL)
+    {
+        free(mailbox);
+        return NULL;
+    }
+    _tk_mailbox_setup(mailbox, valuepool, value_size);
+    return mailbox;
+}
+
+/**
+ * @brief ̬ɾ䣬ɾǰȷûжڶȡ
+ * 
+ * @param mailbox Ҫɾ
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_mailbox_delete(struct tk_mailbox *mailbox)
+{
+    TK_ASSERT(mailbox);
+    if (mailbox == NULL)
+        return false;
+    free(mailbox->value_pool);
+    tk_mailbox_detach(mailbox);
+    free(mailbox);
+    return true;
+}
+#endif /* TK_MAILBOX_USING_CREATE */
+
+/**
+ * @brief дֵһдݣͬһͬʱֻһд
+ * 
+ * @param mailbox 
+ * @param pval 
+ * @return true дɹ
+ * @return false дʧ
+ */
+bool tk_mailbox_write(struct tk_mailbox *mailbox, const void *pval)
+{
+    TK_ASSERT(mailbox);
+    TK_ASSERT(pval);
+    uint32_t version;
+    uint8_t index;
+    if (mailbox == NULL || pval == NULL || mailbox->value_pool == NULL)
+        return false;
+    /* 汾Żʱ00ʾδд */
+    version = __atomic_load_n(&mailbox->version, __ATOMIC_RELAXED) + 1;
+    if (version == 0)
+        version = 1;
+    index = version & 1;
+    __atomic_store_n(&mailbox->seq[index], (version << 1) | 1, __ATOMIC_RELAXED);
+    /* seqΪܿʼ߾ݴ˷ֿе */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy((uint8_t *)mailbox->value_pool + (size_t)index * mailbox->value_size, pval, mailbox->value_size);
+    __atomic_store_n(&mailbox->seq[index], version << 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&mailbox->version, version, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief ȡֵһ¿գ
+ * 
+ * @param mailbox 
+ * @param pval 
+ * @param version ϴζİ汾ţ뵱ǰ汾ͬʱֱӷfalse
+ * ζİ汾ţNULLΪǶȡ
+ * @return true ȡɹ
+ * @return false δд롢δ仯ȡʧ
+ */
+bool tk_mailbox_read(struct tk_mailbox *mailbox, void *pval, uint32_t *version)
+{
+    TK_ASSERT(mailbox);
+    TK_ASSERT(pval);
+    uint32_t curr, seq;
+    uint8_t index;
+    if (mailbox == NULL || pval == NULL || mailbox->value_pool == NULL)
+        return false;
+    for (;;)
+    {
+        curr = __atomic_load_n(&mailbox->version, __ATOMIC_ACQUIRE);
+        if (curr == 0 || (version != NULL && *version == curr))
+            return false;
+        index = curr & 1;
+        seq = __atomic_load_n(&mailbox->seq[index], __ATOMIC_ACQUIRE);
+        /* дѿʼǸû˵һиµİ汾 */
+        if (seq != curr << 1)
+            continue;
+        memcpy(pval, (uint8_t *)mailbox->value_pool + (size_t)index * mailbox->value_size, mailbox->value_size);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&mailbox->seq[index], __ATOMIC_RELAXED) == seq)
+            break;
+    }
+    if (version != NULL)
+        *version = curr;
+    return true;
+}
+
+/**
+ * @brief ȡǰ汾ţ߿ɾݴжǷ仯
+ * 
+ * @param mailbox 
+ * @return uint32_t 汾(д)0Ϊδд
+ */
+uint32_t tk_mailbox_version(struct tk_mailbox *mailbox)
+{
+    TK_ASSERT(mailbox);
+    if (mailbox == NULL)
+        return 0;
+    return __atomic_load_n(&mailbox->version, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief ȡݴС
+ * 
+ * @param mailbox 
+ * @return uint32_t ݴС(λֽ)
+ */
+uint32_t tk_mailbox_size(struct tk_mailbox *mailbox)
+{
+    TK_ASSERT(mailbox);
+    if (mailbox == NULL)
+        return 0;
+    return mailbox->value_size;
+}
+#endif /* TOOLKIT_USING_MAILBOX */
@@ -0,0 +1,569 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     cpu relax in spins, no spin on one cpu, wake producer at half space
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* _GNU_SOURCE */
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_PIPELINE
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TK_PIPELINE_CACHE_LINE 64
+#define TK_PIPELINE_LINK_MASK (TK_PIPELINE_LINK_SIZE - 1)
+/* ߵ·ճһűѣÿͷһͻѡһ */
+#define TK_PIPELINE_WAKE_SPACE (TK_PIPELINE_LINK_SIZE / 2)
+
+/* ȴʱ͹ģóˮԴͬһϵһ߳ */
+#if defined(__x86_64__) || defined(__i386__)
+#define TK_PIPELINE_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define TK_PIPELINE_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define TK_PIPELINE_CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+#endif
+
+/*
+ * ÿ׶һ̣߳ڽ׶֮ǵߵߵн绷·
+ * ֻдtailֻдheadλڲͬУҪ
+ * ߻λãʣ()ʱ¶ȡheadͬtail
+ * ·ΪջʱTK_PIPELINE_SPIN(ֻһCPUʱ)֮futexߣ
+ * ɶԶ˻ѣݼѣ·ճһűѡ
+ */
+struct tk_pipeline_link
+{
+    /* ߲ */
+    uint32_t tail __attribute__((aligned(TK_PIPELINE_CACHE_LINE)));
+    uint32_t head_cache;
+    uint32_t prod_waiting;
+    uint32_t prod_futex;
+    uint32_t prod_spin;
+    /* ߲ */
+    uint32_t head __attribute__((aligned(TK_PIPELINE_CACHE_LINE)));
+    uint32_t tail_cache;
+    uint32_t cons_waiting;
+    uint32_t cons_futex;
+    uint32_t cons_spin;
+    bool closed;
+    uint16_t elem_size;
+    uint8_t *pool;
+};
+
+struct tk_pipeline_stage
+{
+    struct tk_pipeline_stats stats;
+    tk_pipeline_stage_fn fn;
+    void *user_data;
+    int cpu;
+    pthread_t thread;
+    struct tk_pipeline_link *in;
+    struct tk_pipeline_link *out;
+} __attribute__((aligned(TK_PIPELINE_CACHE_LINE)));
+
+struct tk_pipeline
+{
+    struct tk_pipeline_link links[TK_PIPELINE_MAX_STAGES + 1];
+    struct tk_pipeline_stage stages[TK_PIPELINE_MAX_STAGES];
+    uint16_t stage_num;
+    uint16_t out_size;
+    bool running;
+    bool stopped;
+};
+
+/**
+ * @brief futexߣֱֵ仯򱻻(ڲ)
+ * 
+ * @param addr futexַ
+ * @param val ֵ
+ */
+static void _tk_pipeline_futex_wait(uint32_t *addr, uint32_t val)
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+/**
+ * @brief ޸futexֵߵ߳(ڲ)
+ * 
+ * @param addr futexַ
+ */
+static void _tk_pipeline_futex_wake(uint32_t *addr)
+{
+    __atomic_add_fetch(addr, 1, __ATOMIC_RELEASE);
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+/**
+ * @brief ȡ̿õCPUtaskset׺(ڲ)
+ * 
+ * @return long CPU
+ */
+static long _tk_pipeline_cpu_num(void)
+{
+    cpu_set_t cpuset;
+    long cpu_num;
+    CPU_ZERO(&cpuset);
+    if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0 && CPU_COUNT(&cpuset) > 0)
+        return CPU_COUNT(&cpuset);
+    cpu_num = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cpu_num > 0) ? cpu_num : 1;
+}
+
+/**
+ * @brief ʼ·(ڲ)
+ * ֻһCPUʱԶ˲ͬʱУֻ˷ʱƬֱ
+ * 
+ * @param link ·
+ * @param elem_size ԪشС
+ * @return true ɹ
+ * @return false ڴʧ
+ */
+static bool _tk_pipeline_link_init(struct tk_pipeline_link *link, uint16_t elem_size)
+{
+    uint32_t spin = (_tk_pipeline_cpu_num() > 1) ? TK_PIPELINE_SPIN : 0;
+    memset(link, 0, sizeof(struct tk_pipeline_link));
+    link->prod_spin = spin;
+    link->cons_spin = spin;
+    link->pool = aligned_alloc(TK_PIPELINE_CACHE_LINE,
+                               ((size_t)elem_size * TK_PIPELINE_LINK_SIZE + TK_PIPELINE_CACHE_LINE - 1) &
+                                   ~(size_t)(TK_PIPELINE_CACHE_LINE - 1));
+    if (link->pool == NULL)
+        return false;
+    link->elem_size = elem_size;
+    return true;
+}
+
+/**
+ * @brief ߵȴдռ䣬ռ䲻ʱ(ڲ)
+ * 
+ * @param link ·
+ * @param want ϣдԪظ
+ * @param blocked ߴΪNULL
+ * @return uint32_t дԪظ1~want
+ */
+static uint32_t _tk_pipeline_link_writable(struct tk_pipeline_link *link, uint32_t want, uint64_t *blocked)
+{
+    uint32_t tail = link->tail;
+    uint32_t spin = 0;
+    uint32_t space = TK_PIPELINE_LINK_SIZE - (tail - link->head_cache);
+    while (space < want)
+    {
+        link->head_cache = __atomic_load_n(&link->head, __ATOMIC_ACQUIRE);
+        space = TK_PIPELINE_LINK_SIZE - (tail - link->head_cache);
+        if (space > 0)
+            break;
+        if (spin++ < link->prod_spin)
+        {
+            TK_PIPELINE_CPU_RELAX();
+            continue;
+        }
+        /* ͷſռļԣⶪʧ */
+        uint32_t seq = __atomic_load_n(&link->prod_futex, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&link->prod_waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&link->head, __ATOMIC_RELAXED) == link->head_cache)
+        {
+            _tk_pipeline_futex_wait(&link->prod_futex, seq);
+            if (blocked != NULL)
+                __atomic_store_n(blocked, *blocked + 1, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&link->prod_waiting, 0, __ATOMIC_RELAXED);
+        spin = 0;
+    }
+    if (space > want)
+        space = want;
+    if (space > TK_PIPELINE_LINK_SIZE - (tail & TK_PIPELINE_LINK_MASK))
+        space = TK_PIPELINE_LINK_SIZE - (tail & TK_PIPELINE_LINK_MASK);
+    return space;
+}
+
+/**
+ * @brief ߷дԪأʱ(ڲ)
+ * 
+ * @param link ·
+ * @param num Ԫظ
+ */
+static void _tk_pipeline_link_publish(struct tk_pipeline_link *link, uint32_t num)
+{
+    __atomic_store_n(&link->tail, link->tail + num, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&link->cons_waiting, __ATOMIC_RELAXED))
+        _tk_pipeline_futex_wake(&link->cons_futex);
+}
+
+/**
+ * @brief ߹ر·߶պ˳(ڲ)
+ * 
+ * @param link ·
+ */
+static void _tk_pipeline_link_close(struct tk_pipeline_link *link)
+{
+    __atomic_store_n(&link->closed, true, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&link->cons_waiting, __ATOMIC_RELAXED))
+        _tk_pipeline_futex_wake(&link->cons_futex);
+}
+
+/**
+ * @brief ߵȴݣ·Ϊʱ(ڲ)
+ * 
+ * @param link ·
+ * @param starved ߴ
+ * @return uint32_t ·еԪظ0Ϊ·ѹرѶ
+ */
+static uint32_t _tk_pipeline_link_readable(struct tk_pipeline_link *link, uint64_t *starved)
+{
+    uint32_t head = link->head;
+    uint32_t spin = 0;
+    if (link->tail_cache != head)
+        return link->tail_cache - head;
+    while (1)
+    {
+        link->tail_cache = __atomic_load_n(&link->tail, __ATOMIC_ACQUIRE);
+        if (link->tail_cache != head)
+            return link->tail_cache - head;
+        if (__atomic_load_n(&link->closed, __ATOMIC_ACQUIRE))
+        {
+            /* رǰԪشʱһɼ */
+            link->tail_cache = __atomic_load_n(&link->tail, __ATOMIC_ACQUIRE);
+            return link->tail_cache - head;
+        }
+        if (spin++ < link->cons_spin)
+        {
+            TK_PIPELINE_CPU_RELAX();
+            continue;
+        }
+        uint32_t seq = __atomic_load_n(&link->cons_futex, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&link->cons_waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&link->tail, __ATOMIC_RELAXED) == head &&
+            __atomic_load_n(&link->closed, __ATOMIC_RELAXED) == false)
+        {
+            _tk_pipeline_futex_wait(&link->cons_futex, seq);
+            __atomic_store_n(starved, *starved + 1, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&link->cons_waiting, 0, __ATOMIC_RELAXED);
+        spin = 0;
+    }
+}
+
+/**
+ * @brief ͷѴԪأ·ѿճһʱ(ڲ)
+ * ֻ·ʱߣ߶ǰпռȻﵽһ룬ᶪʧ
+ * 
+ * @param link ·
+ * @param num Ԫظ
+ */
+static void _tk_pipeline_link_consume(struct tk_pipeline_link *link, uint32_t num)
+{
+    uint32_t head = link->head + num;
+    __atomic_store_n(&link->head, head, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&link->prod_waiting, __ATOMIC_RELAXED) &&
+        TK_PIPELINE_LINK_SIZE - (__atomic_load_n(&link->tail, __ATOMIC_RELAXED) - head) >= TK_PIPELINE_WAKE_SPACE)
+        _tk_pipeline_futex_wake(&link->prod_futex);
+}
+
+/**
+ * @brief ȡʱ(λns)(ڲ)
+ * 
+ * @return uint64_t ǰʱ
+ */
+static uint64_t _tk_pipeline_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief ׶߳ȡ롢ý׶κرҶպر(ڲ)
+ * 
+ * @param param ׶
+ * @return void* NULL
+ */
+static void *_tk_pipeline_stage_entry(void *param)
+{
+    struct tk_pipeline_stage *stage = param;
+    struct tk_pipeline_link *in = stage->in;
+    struct tk_pipeline_link *out = stage->out;
+    struct tk_pipeline_stats *stats = &stage->stats;
+    uint32_t avail, num, done;
+    uint64_t begin;
+    if (stage->cpu >= 0)
+    {
+        cpu_set_t cpuset;
+        long cpu_num = sysconf(_SC_NPROCESSORS_ONLN);
+        CPU_ZERO(&cpuset);
+        CPU_SET(stage->cpu % (cpu_num > 0 ? cpu_num : 1), &cpuset);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    }
+    while ((avail = _tk_pipeline_link_readable(in, &stats->starved)) != 0)
+    {
+        uint32_t head = in->head;
+        num = avail;
+        if (num > TK_PIPELINE_BATCH_SIZE)
+            num = TK_PIPELINE_BATCH_SIZE;
+        if (num > TK_PIPELINE_LINK_SIZE - (head & TK_PIPELINE_LINK_MASK))
+            num = TK_PIPELINE_LINK_SIZE - (head & TK_PIPELINE_LINK_MASK);
+        if (out != NULL)
+            num = _tk_pipeline_link_writable(out, num, &stats->blocked);
+        begin = _tk_pipeline_now_ns();
+        done = stage->fn(stage->user_data,
+                         in->pool + (size_t)(head & TK_PIPELINE_LINK_MASK) * in->elem_size,
+                         (out != NULL) ? out->pool + (size_t)(out->tail & TK_PIPELINE_LINK_MASK) * out->elem_size : NULL,
+                         num);
+        __atomic_store_n(&stats->busy_ns, stats->busy_ns + (_tk_pipeline_now_ns() - begin), __ATOMIC_RELAXED);
+        if (out != NULL && done > 0)
+        {
+            if (done > num)
+                done = num;
+            _tk_pipeline_link_publish(out, done);
+            __atomic_store_n(&stats->out_num, stats->out_num + done, __ATOMIC_RELAXED);
+        }
+        _tk_pipeline_link_consume(in, num);
+        __atomic_store_n(&stats->in_num, stats->in_num + num, __ATOMIC_RELAXED);
+        __atomic_store_n(&stats->batches, stats->batches + 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&stats->occupancy, stats->occupancy + avail, __ATOMIC_RELAXED);
+    }
+    if (out != NULL)
+        _tk_pipeline_link_close(out);
+    return NULL;
+}
+
+/**
+ * @brief ̬ˮߣ֮ӽ׶β
+ * 
+ * @param in_size Ԫ(tk_pipeline_pushѹԪ)С
+ * @return struct tk_pipeline* ˮ߶NULLΪʧ
+ */
+struct tk_pipeline *tk_pipeline_create(uint16_t in_size)
+{
+    struct tk_pipeline *pipeline;
+    if (in_size == 0)
+        return NULL;
+    pipeline = aligned_alloc(TK_PIPELINE_CACHE_LINE, sizeof(struct tk_pipeline));
+    if (pipeline == NULL)
+        return NULL;
+    memset(pipeline, 0, sizeof(struct tk_pipeline));
+    pipeline->out_size = in_size;
+    return pipeline;
+}
+
+/**
+ * @brief ɾˮߣʱֹͣ
+ * 
+ * @param pipeline Ҫɾˮ߶
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_pipeline_delete(struct tk_pipeline *pipeline)
+{
+    TK_ASSERT(pipeline);
+    uint16_t i;
+    if (pipeline == NULL)
+        return false;
+    if (pipeline->running)
+        tk_pipeline_stop(pipeline);
+    for (i = 0; i < pipeline->stage_num; i++)
+        free(pipeline->links[i].pool);
+    free(pipeline);
+    return true;
+}
+
+/**
+ * @brief ˮĩβһ׶Σÿ׶ɶִ߳
+ * 
+ * @param pipeline ˮ߶
+ * @param fn ׶κÿTK_PIPELINE_BATCH_SIZEԪ
+ * @param user_data ׶κû
+ * @param out_size ԪشСһ׶Ϊ0
+ * @param cpu ׶̰߳󶨵CPUˣ-1Ϊ
+ * @return true ӳɹ
+ * @return false ʧ(׶һ׶ûڴʧ)
+ */
+bool tk_pipeline_add_stage(struct tk_pipeline *pipeline, tk_pipeline_stage_fn fn, void *user_data,
+                           uint16_t out_size, int cpu)
+{
+    TK_ASSERT(pipeline);
+    TK_ASSERT(fn);
+    struct tk_pipeline_stage *stage;
+    if (pipeline == NULL || fn == NULL)
+        return false;
+    if (pipeline->running || pipeline->stopped || pipeline->stage_num >= TK_PIPELINE_MAX_STAGES ||
+        pipeline->out_size == 0)
+        return false;
+    if (_tk_pipeline_link_init(&pipeline->links[pipeline->stage_num], pipeline->out_size) == false)
+        return false;
+    stage = &pipeline->stages[pipeline->stage_num];
+    memset(stage, 0, sizeof(struct tk_pipeline_stage));
+    stage->fn = fn;
+    stage->user_data = user_data;
+    stage->cpu = cpu;
+    stage->in = &pipeline->links[pipeline->stage_num];
+    pipeline->stage_num++;
+    pipeline->out_size = out_size;
+    return true;
+}
+
+/**
+ * @brief ȫ׶߳
+ * 
+ * @param pipeline ˮ߶
+ * @return true ɹ
+ * @return false ʧ(ûн׶Ρһ׶ֹͣ)
+ */
+bool tk_pipeline_start(struct tk_pipeline *pipeline)
+{
+    TK_ASSERT(pipeline);
+    uint16_t i;
+    if (pipeline == NULL)
+        return false;
+    if (pipeline->stage_num == 0 || pipeline->out_size != 0 || pipeline->running || pipeline->stopped)
+        return false;
+    for (i = 0; i + 1 < pipeline->stage_num; i++)
+        pipeline->stages[i].out = &pipeline->links[i + 1];
+    for (i = 0; i < pipeline->stage_num; i++)
+    {
+        if (pthread_create(&pipeline->stages[i].thread, NULL, _tk_pipeline_stage_entry,
+                           &pipeline->stages[i]) != 0)
+        {
+            /* ر룬Ľ׶ζպ˳ */
+            _tk_pipeline_link_close(&pipeline->links[0]);
+            while (i > 0)
+                pthread_join(pipeline->stages[--i].thread, NULL);
+            pipeline->stopped = true;
+            return false;
+        }
+    }
+    pipeline->running = true;
+    return true;
+}
+
+/**
+ * @brief ֹͣˮߣѹԪȫ׶δ󷵻أֹͣ
+ * 
+ * @param pipeline ˮ߶
+ * @return true ֹͣɹ
+ * @return false ֹͣʧ(δ)
+ */
+bool tk_pipeline_stop(struct tk_pipeline *pipeline)
+{
+    TK_ASSERT(pipeline);
+    uint16_t i;
+    if (pipeline == NULL || pipeline->running == false)
+        return false;
+    _tk_pipeline_link_close(&pipeline->links[0]);
+    for (i = 0; i < pipeline->stage_num; i++)
+        pthread_join(pipeline->stages[i].thread, NULL);
+    pipeline->running = false;
+    pipeline->stopped = true;
+    return true;
+}
+
+/**
+ * @brief ˮѹ1Ԫأһ׶ε·ʱߵȴ(ѹ)
+ * ͬһˮֻһ߳ѹ
+ * 
+ * @param pipeline ˮ߶
+ * @param pval Ԫָ
+ * @return true ѹɹ
+ * @return false ѹʧ(δ)
+ */
+bool tk_pipeline_push(struct tk_pipeline *pipeline, const void *pval)
+{
+    return tk_pipeline_push_multi(pipeline, pval, 1) == 1;
+}
+
+/**
+ * @brief ˮѹԪأռ·ʱߵȴ(ѹ)
+ * ͬһˮֻһ߳ѹ
+ * 
+ * @param pipeline ˮ߶
+ * @param pval Ԫ
+ * @param num Ԫظ
+ * @return uint32_t ѹԪظδʱΪ0
+ */
+uint32_t tk_pipeline_push_multi(struct tk_pipeline *pipeline, const void *pval, uint32_t num)
+{
+    TK_ASSERT(pipeline);
+    TK_ASSERT(pval);
+    struct tk_pipeline_link *link;
+    const uint8_t *src = pval;
+    uint32_t done = 0, len;
+    if (pipeline == NULL || pval == NULL || pipeline->running == false)
+        return 0;
+    link = &pipeline->links[0];
+    while (done < num)
+    {
+        len = _tk_pipeline_link_writable(link, num - done, NULL);
+        memcpy(link->pool + (size_t)(link->tail & TK_PIPELINE_LINK_MASK) * link->elem_size,
+               src + (size_t)done * link->elem_size, (size_t)len * link->elem_size);
+        _tk_pipeline_link_publish(link, len);
+        done += len;
+    }
+    return done;
+}
+
+/**
+ * @brief ȡ׶εͳƣ̵߳
+ * Ϊin_numʱ䣬Ϊbusy_nsʱ䣬ƽѹΪoccupancybatches
+ * 
+ * @param pipeline ˮ߶
+ * @param stage ׶αţ0ʼ
+ * @param stats ͳ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_pipeline_get_stats(struct tk_pipeline *pipeline, uint16_t stage, struct tk_pipeline_stats *stats)
+{
+    TK_ASSERT(pipeline);
+    TK_ASSERT(stats);
+    struct tk_pipeline_stats *src;
+    struct tk_pipeline_link *link;
+    if (pipeline == NULL || stats == NULL || stage >= pipeline->stage_num)
+        return false;
+    src = &pipeline->stages[stage].stats;
+    link = &pipeline->links[stage];
+    stats->in_num = __atomic_load_n(&src->in_num, __ATOMIC_RELAXED);
+    stats->out_num = __atomic_load_n(&src->out_num, __ATOMIC_RELAXED);
+    stats->batches = __atomic_load_n(&src->batches, __ATOMIC_RELAXED);
+    stats->occupancy = __atomic_load_n(&src->occupancy, __ATOMIC_RELAXED);
+    stats->starved = __atomic_load_n(&src->starved, __ATOMIC_RELAXED);
+    stats->blocked = __atomic_load_n(&src->blocked, __ATOMIC_RELAXED);
+    stats->busy_ns = __atomic_load_n(&src->busy_ns, __ATOMIC_RELAXED);
+    stats->link_len = __atomic_load_n(&link->tail, __ATOMIC_RELAXED) -
+                      __atomic_load_n(&link->head, __ATOMIC_RELAXED);
+    return true;
+}
+
+#endif /* TOOLKIT_USING_PIPELINE */
@@ -0,0 +1,591 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_PQUEUE
+
+/* 4ѣ4ӽڵ㹲32ֽڣλͬһ */
+#define TK_PQUEUE_HEAP_D 4
+
+/**
+ * @brief жϽڵaǷӦڽڵb(ڲ)
+ * ȼֵСȳӣȼͬʱѹȳ
+ * 
+ * @param a ڵa
+ * @param b ڵb
+ * @return true aȳ
+ * @return false bȳ
+ */
+static bool _tk_pqueue_before(const struct tk_pqueue_node *a, const struct tk_pqueue_node *b)
+{
+    if (a->prio != b->prio)
+        return a->prio < b->prio;
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/**
+ * @brief ڵϸ(ڲ)
+ * 
+ * @param queue ȼж
+ * @param index ڵ±
+ * @param node ҪĽڵ
+ */
+static void _tk_pqueue_sift_up(struct tk_pqueue *queue, uint16_t index, struct tk_pqueue_node node)
+{
+    struct tk_pqueue_node *heap = queue->heap;
+    while (index > 0)
+    {
+        uint16_t parent = (index - 1) / TK_PQUEUE_HEAP_D;
+        if (_tk_pqueue_before(&node, &heap[parent]) == false)
+            break;
+        heap[index] = heap[parent];
+        index = parent;
+    }
+    heap[index] = node;
+}
+
+/**
+ * @brief ڵ³(ڲ)
+ * 
+ * @param queue ȼж
+ * @param index ڵ±
+ * @param node ҪĽڵ
+ */
+static void _tk_pqueue_sift_down(struct tk_pqueue *queue, uint16_t index, struct tk_pqueue_node node)
+{
+    struct tk_pqueue_node *heap = queue->heap;
+    uint16_t len = queue->len;
+    while (1)
+    {
+        uint32_t child = (uint32_t)index * TK_PQUEUE_HEAP_D + 1;
+        uint32_t last = child + TK_PQUEUE_HEAP_D;
+        uint32_t best;
+        if (child >= len)
+            break;
+        if (last > len)
+            last = len;
+        best = child;
+        for (child++; child < last; child++)
+        {
+            if (_tk_pqueue_before(&heap[child], &heap[best]))
+                best = child;
+        }
+        if (_tk_pqueue_before(&heap[best], &node) == false)
+            break;
+        heap[index] = heap[best];
+        index = (uint16_t)best;
+    }
+    heap[index] = node;
+}
+
+/**
+ * @brief ֶѡвۺԪն(ڲ)
+ * 
+ * @param queue ȼж
+ * @param queuepool л
+ * @param max_queues Ԫظ
+ * @param queue_size ԪشС(λֽ)
+ */
+static void _tk_pqueue_setup(struct tk_pqueue *queue, void *queuepool, uint16_t max_queues, uint16_t queue_size)
+{
+    queue->heap = (struct tk_pqueue_node *)queuepool;
+    queue->free_slots = (uint16_t *)(queue->heap + max_queues);
+    queue->queue_pool = (uint8_t *)(queue->free_slots + max_queues);
+    queue->queue_size = queue_size;
+    queue->max_queues = max_queues;
+    tk_pqueue_clean(queue);
+}
+
+/**
+ * @brief ̬ʼȼ
+ * ѽڵ㡢вۼԪСTK_PQUEUE_POOL_SIZE
+ * 
+ * @param queue ȼж
+ * @param queuepool л谴4ֽڶ
+ * @param pool_size С(λֽ)
+ * @param queue_size ԪشС(λֽ)
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_pqueue_init(struct tk_pqueue *queue, void *queuepool, uint32_t pool_size, uint16_t queue_size)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queuepool);
+    TK_ASSERT(queue_size);
+    uint32_t max_queues;
+    if (queue == NULL || queuepool == NULL || queue_size == 0)
+        return false;
+    max_queues = pool_size / TK_PQUEUE_POOL_SIZE(queue_size, 1);
+    if (max_queues == 0)
+        return false;
+    if (max_queues > UINT16_MAX)
+        max_queues = UINT16_MAX;
+    _tk_pqueue_setup(queue, queuepool, (uint16_t)max_queues, queue_size);
+    return true;
+}
+
+/**
+ * @brief ̬ȼ
+ * 
+ * @param queue Ҫȼж
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_pqueue_detach(struct tk_pqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    queue->heap = NULL;
+    queue->free_slots = NULL;
+    queue->queue_pool = NULL;
+    queue->len = 0;
+    return true;
+}
+
+#ifdef TK_PQUEUE_USING_CREATE
+/**
+ * @brief ̬ȼ
+ * 
+ * @param queue_size ԪشС(λֽ)
+ * @param max_queues Ԫظ
+ * @return struct tk_pqueue* ȼжNULLΪʧ
+ */
+struct tk_pqueue *tk_pqueue_create(uint16_t queue_size, uint16_t max_queues)
+{
+    TK_ASSERT(queue_size);
+    TK_ASSERT(max_queues);
+    struct tk_pqueue *queue;
+    void *queuepool;
+    if (queue_size == 0 || max_queues == 0)
+        return NULL;
+    if ((queue = malloc(sizeof(struct tk_pqueue))) == NULL)
+        return NULL;
+    if ((queuepool = malloc(TK_PQUEUE_POOL_SIZE(queue_size, max_queues))) == NULL)
+    {
+        free(queue);
+        return NULL;
+    }
+    _tk_pqueue_setup(queue, queuepool, max_queues, queue_size);
+    return queue;
+}
+
+/**
+ * @brief ̬ɾȼ
+ * 
+ * @param queue Ҫɾȼж
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_pqueue_delete(struct tk_pqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    free(queue->heap);
+    free(queue);
+    return true;
+}
+#endif /* TK_PQUEUE_USING_CREATE */
+
+/**
+ * @brief ȼ
+ * 
+ * @param queue Ҫյȼж
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_pqueue_clean(struct tk_pqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL || queue->free_slots == NULL)
+        return false;
+    for (uint16_t i = 0; i < queue->max_queues; i++)
+        queue->free_slots[i] = i;
+    queue->len = 0;
+    queue->seq = 0;
+    return true;
+}
+
+/**
+ * @brief жȼǷΪ
+ * 
+ * @param queue Ҫѯȼж
+ * @return true 
+ * @return false Ϊ
+ */
+bool tk_pqueue_empty(struct tk_pqueue *queue)
+{
+    TK_ASSERT(queue);
+    return queue->len == 0;
+}
+
+/**
+ * @brief жȼǷ
+ * 
+ * @param queue Ҫѯȼж
+ * @return true 
+ * @return false Ϊ
+ */
+bool tk_pqueue_full(struct tk_pqueue *queue)
+{
+    TK_ASSERT(queue);
+    return queue->len >= queue->max_queues;
+}
+
+/**
+ * @brief ѯȼеǰݳ
+ * 
+ * @param queue Ҫѯȼж
+ * @return uint16_t ǰԪظ
+ */
+uint16_t tk_pqueue_curr_len(struct tk_pqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return 0;
+    return queue->len;
+}
+
+/**
+ * @brief ȼѹ1Ԫ
+ * 
+ * @param queue Ҫѹȼж
+ * @param pval ѹֵ
+ * @param prio ȼֵԽСԽȳӣͬȼȽȳ
+ * @return true ɹ
+ * @return false ʧ()
+ */
+bool tk_pqueue_push(struct tk_pqueue *queue, void *pval, uint16_t prio)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->heap);
+    struct tk_pqueue_node node;
+    if (queue->len >= queue->max_queues)
+        return false;
+    node.prio = prio;
+    node.slot = queue->free_slots[queue->max_queues - 1 - queue->len];
+    node.seq = queue->seq++;
+    memcpy(queue->queue_pool + (uint32_t)node.slot * queue->queue_size, pval, queue->queue_size);
+    queue->len++;
+    _tk_pqueue_sift_up(queue, queue->len - 1, node);
+    return true;
+}
+
+/**
+ * @brief ȼеȼߵ1Ԫ
+ * 
+ * @param queue Ҫȼж
+ * @param pval ֵ
+ * @return true ɹ
+ * @return false ʧ(Ϊ)
+ */
+bool tk_pqueue_pop(struct tk_pqueue *queue, void *pval)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->heap);
+    uint16_t slot;
+    if (queue->len == 0)
+        return false;
+    slot = queue->heap[0].slot;
+    memcpy(pval, queue->queue_pool + (uint32_t)slot * queue->queue_size, queue->queue_size);
+    queue->len--;
+    queue->free_slots[queue->max_queues - 1 - queue->len] = slot;
+    if (queue->len > 0)
+        _tk_pqueue_sift_down(queue, 0, queue->heap[queue->len]);
+    return true;
+}
+
+/**
+ * @brief ȡȼߵ1Ԫ(Ӷɾ)
+ * 
+ * @param queue Ҫȡȼж
+ * @param pval ȡֵ
+ * @param prio ԪصȼҪΪNULL
+ * @return true ɹ
+ * @return false ʧ(Ϊ)
+ */
+bool tk_pqueue_peep(struct tk_pqueue *queue, void *pval, uint16_t *prio)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->heap);
+    if (queue->len == 0)
+        return false;
+    memcpy(pval, queue->queue_pool + (uint32_t)queue->heap[0].slot * queue->queue_size, queue->queue_size);
+    if (prio != NULL)
+        *prio = queue->heap[0].prio;
+    return true;
+}
+
+/**
+ * @brief ȡλͼȼ(λ)ķǿȼ(ڲ)
+ * 
+ * @param bitmap ǿȼλͼΪ0
+ * @return uint8_t ȼ
+ */
+static uint8_t _tk_mlqueue_first(uint32_t bitmap)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctz(bitmap);
+#else
+    uint8_t index = 0;
+    while ((bitmap & 1) == 0)
+    {
+        bitmap >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief ̬ʼ༶
+ * ÿȼһȽȳУƽȼ
+ * 
+ * @param queue ༶ж
+ * @param queuepool л
+ * @param pool_size С(λֽ)
+ * @param queue_size ԪشС(λֽ)
+ * @param band_num ȼTK_PQUEUE_MAX_BANDS
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_mlqueue_init(struct tk_mlqueue *queue, void *queuepool, uint32_t pool_size,
+                     uint16_t queue_size, uint8_t band_num)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queuepool);
+    TK_ASSERT(queue_size);
+    TK_ASSERT(band_num && band_num <= TK_PQUEUE_MAX_BANDS);
+    uint32_t band_size;
+    if (queue == NULL || queuepool == NULL || queue_size == 0 ||
+        band_num == 0 || band_num > TK_PQUEUE_MAX_BANDS)
+        return false;
+    band_size = pool_size / queue_size / band_num;
+    if (band_size == 0)
+        return false;
+    queue->queue_pool = (uint8_t *)queuepool;
+    queue->queue_size = queue_size;
+    queue->band_size = (band_size > UINT16_MAX) ? UINT16_MAX : (uint16_t)band_size;
+    queue->band_num = band_num;
+    return tk_mlqueue_clean(queue);
+}
+
+/**
+ * @brief ̬༶
+ * 
+ * @param queue ҪĶ༶ж
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_mlqueue_detach(struct tk_mlqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    queue->queue_pool = NULL;
+    queue->bitmap = 0;
+    return true;
+}
+
+#ifdef TK_PQUEUE_USING_CREATE
+/**
+ * @brief ̬༶
+ * 
+ * @param queue_size ԪشС(λֽ)
+ * @param band_size ÿȼԪظ
+ * @param band_num ȼTK_PQUEUE_MAX_BANDS
+ * @return struct tk_mlqueue* Ķ༶жNULLΪʧ
+ */
+struct tk_mlqueue *tk_mlqueue_create(uint16_t queue_size, uint16_t band_size, uint8_t band_num)
+{
+    TK_ASSERT(queue_size);
+    TK_ASSERT(band_size);
+    struct tk_mlqueue *queue;
+    uint32_t pool_size = (uint32_t)queue_size * band_size * band_num;
+    void *queuepool;
+    if ((queue = malloc(sizeof(struct tk_mlqueue))) == NULL)
+        return NULL;
+    if (pool_size == 0 || (queuepool = malloc(pool_size)) == NULL)
+    {
+        free(queue);
+        return NULL;
+    }
+    if (tk_mlqueue_init(queue, queuepool, pool_size, queue_size, band_num) == false)
+    {
+        free(queuepool);
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+/**
+ * @brief ̬ɾ༶
+ * 
+ * @param queue ҪɾĶ༶ж
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_mlqueue_delete(struct tk_mlqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    free(queue->queue_pool);
+    free(queue);
+    return true;
+}
+#endif /* TK_PQUEUE_USING_CREATE */
+
+/**
+ * @brief ն༶
+ * 
+ * @param queue ҪյĶ༶ж
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_mlqueue_clean(struct tk_mlqueue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    memset(queue->front, 0, sizeof(queue->front));
+    memset(queue->len, 0, sizeof(queue->len));
+    queue->bitmap = 0;
+    return true;
+}
+
+/**
+ * @brief ж϶༶ǷΪ
+ * 
+ * @param queue ҪѯĶ༶ж
+ * @return true 
+ * @return false Ϊ
+ */
+bool tk_mlqueue_empty(struct tk_mlqueue *queue)
+{
+    TK_ASSERT(queue);
+    return queue->bitmap == 0;
+}
+
+/**
+ * @brief ѯ༶еǰݳ
+ * 
+ * @param queue ҪѯĶ༶ж
+ * @return uint16_t ȼԪظ֮
+ */
+uint16_t tk_mlqueue_curr_len(struct tk_mlqueue *queue)
+{
+    TK_ASSERT(queue);
+    uint32_t len = 0;
+    if (queue == NULL)
+        return 0;
+    for (uint8_t i = 0; i < queue->band_num; i++)
+        len += queue->len[i];
+    return (len > UINT16_MAX) ? UINT16_MAX : (uint16_t)len;
+}
+
+/**
+ * @brief ༶ѹ1Ԫ
+ * 
+ * @param queue ҪѹĶ༶ж
+ * @param pval ѹֵ
+ * @param prio ȼ0ߣΧʱȼ
+ * @return true ɹ
+ * @return false ʧ(ȼ)
+ */
+bool tk_mlqueue_push(struct tk_mlqueue *queue, void *pval, uint8_t prio)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->queue_pool);
+    uint32_t rear;
+    if (prio >= queue->band_num)
+        prio = queue->band_num - 1;
+    if (queue->len[prio] >= queue->band_size)
+        return false;
+    rear = (uint32_t)queue->front[prio] + queue->len[prio];
+    if (rear >= queue->band_size)
+        rear -= queue->band_size;
+    memcpy(queue->queue_pool + ((uint32_t)prio * queue->band_size + rear) * queue->queue_size,
+           pval, queue->queue_size);
+    queue->len[prio]++;
+    queue->bitmap |= (1u << prio);
+    return true;
+}
+
+/**
+ * @brief Ӷ༶еȼߵ1Ԫ
+ * 
+ * @param queue ҪĶ༶ж
+ * @param pval ֵ
+ * @return true ɹ
+ * @return false ʧ(Ϊ)
+ */
+bool tk_mlqueue_pop(struct tk_mlqueue *queue, void *pval)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->queue_pool);
+    uint8_t prio;
+    if (queue->bitmap == 0)
+        return false;
+    prio = _tk_mlqueue_first(queue->bitmap);
+    memcpy(pval, queue->queue_pool + ((uint32_t)prio * queue->band_size + queue->front[prio]) * queue->queue_size,
+           queue->queue_size);
+    if (++queue->front[prio] >= queue->band_size)
+        queue->front[prio] = 0;
+    if (--queue->len[prio] == 0)
+        queue->bitmap &= ~(1u << prio);
+    return true;
+}
+
+/**
+ * @brief ȡȼߵ1Ԫ(Ӷɾ)
+ * 
+ * @param queue ҪȡĶ༶ж
+ * @param pval ȡֵ
+ * @param prio ԪصȼҪΪNULL
+ * @return true ɹ
+ * @return false ʧ(Ϊ)
+ */
+bool tk_mlqueue_peep(struct tk_mlqueue *queue, void *pval, uint8_t *prio)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->queue_pool);
+    uint8_t band;
+    if (queue->bitmap == 0)
+        return false;
+    band = _tk_mlqueue_first(queue->bitmap);
+    memcpy(pval, queue->queue_pool + ((uint32_t)band * queue->band_size + queue->front[band]) * queue->queue_size,
+           queue->queue_size);
+    if (prio != NULL)
+        *prio = band;
+    return true;
+}
+
+#endif /* TOOLKIT_USING_PQUEUE */
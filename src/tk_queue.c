@@ -30,10 +30,280 @@
 * 2020-03-04     zhangran     add queue clean code
 * 2020-06-04     zhangran     support any type
 * 2020-11-28     zhangran     add queue peep&remove code
+* 2026-10-19     zhangran     add eventfd bridge for epoll
+* 2026-10-19     zhangran     wake up waiting coroutines
+* 2026-10-19     zhangran     add queue stats
+* 2026-10-19     zhangran     add persistent journal mode
+* 2026-10-19     zhangran     add per-element ttl
+* 2026-10-19     zhangran     add adaptive batch signalling
+* 2026-10-19     zhangran     run wake hooks on keep_fresh overwrite
 */
 
 #include "toolkit.h"
 #ifdef TOOLKIT_USING_QUEUE
+#ifdef TK_QUEUE_USING_FD
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/**
+ * @brief ʹeventfdɶ֪ͨ(ڲ)
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_fd_signal(struct tk_queue *queue)
+{
+    uint64_t value = 1;
+    if (write(queue->queue_fd, &value, sizeof(value)) == sizeof(value))
+        queue->fd_signaled = true;
+}
+
+#ifdef TK_QUEUE_USING_BATCH
+/**
+ * @brief жǷģʽ֪ͨʱ(ڲ)
+ * 
+ * @param queue ж
+ * @return true ģʽ
+ * @return false ǿռ֪ͨ
+ */
+static bool _tk_queue_batch_enabled(struct tk_queue *queue)
+{
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return false;
+#endif /* TK_QUEUE_USING_JOURNAL */
+    return queue->batch_timer != NULL;
+}
+#endif /* TK_QUEUE_USING_BATCH */
+
+/**
+ * @brief ݶǷΪͬeventfdɶ״̬(ڲ)
+ * ֻڿ/ǿлʱһϵͳãѹ벻ظд
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_fd_update(struct tk_queue *queue)
+{
+    uint64_t value = 1;
+    if (queue->fd_enabled == false)
+        return;
+    if (queue->len != 0 && queue->fd_signaled == false)
+    {
+#ifdef TK_QUEUE_USING_BATCH
+        /* ģʽѹͳʱʱʱ֪ͨ */
+        if (_tk_queue_batch_enabled(queue))
+            return;
+#endif /* TK_QUEUE_USING_BATCH */
+        _tk_queue_fd_signal(queue);
+    }
+    else if (queue->len == 0 && queue->fd_signaled == true)
+    {
+        if (read(queue->queue_fd, &value, sizeof(value)) == sizeof(value))
+            queue->fd_signaled = false;
+    }
+}
+
+/**
+ * @brief رնжӦeventfd(ڲ)
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_fd_close(struct tk_queue *queue)
+{
+    if (queue->fd_enabled == true)
+        close(queue->queue_fd);
+    queue->queue_fd = -1;
+    queue->fd_enabled = false;
+    queue->fd_signaled = false;
+}
+#endif /* TK_QUEUE_USING_FD */
+
+#ifdef TK_QUEUE_USING_BATCH
+/**
+ * @brief ȴʱ֪ͨȡ߲һԪ(ڲ)
+ * 
+ * @param timer ʱ
+ */
+static void _tk_queue_batch_timeout(struct tk_timer *timer)
+{
+    struct tk_queue *queue = (struct tk_queue *)timer->user_data;
+    if (queue->len != 0 && queue->fd_signaled == false)
+        _tk_queue_fd_signal(queue);
+}
+
+/**
+ * @brief ѹͳƵʲǷ֪ͨ(ڲ)
+ * ÿtickʱ1/4ȨظÿtickѹĻƽСȡTK_QUEUE_BATCH_WAKES_PER_TICKȡ
+ * ͸ʱ˻Ϊÿѹ붼֪ͨ߸ʱÿtickԼ֪ͨTK_QUEUE_BATCH_WAKES_PER_TICKΣδһʱʱȴ
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_batch_push(struct tk_queue *queue)
+{
+    uint32_t now, elapsed, rate;
+    if (_tk_queue_batch_enabled(queue) == false)
+        return;
+    now = tk_timer_get_curr_tick();
+    elapsed = now - queue->batch_tick;
+    if (elapsed != 0)
+    {
+        rate = (queue->batch_count << 8) / elapsed;
+        queue->batch_rate = queue->batch_rate - queue->batch_rate / 4 + rate / 4;
+        rate = (queue->batch_rate + (256 * TK_QUEUE_BATCH_WAKES_PER_TICK - 1)) / (256 * TK_QUEUE_BATCH_WAKES_PER_TICK);
+        if (rate < 1)
+            rate = 1;
+        queue->batch = rate > queue->batch_max ? queue->batch_max : (uint16_t)rate;
+        queue->batch_tick = now;
+        queue->batch_count = 0;
+    }
+    if (queue->batch_count < 0xFFFFFF)
+        queue->batch_count++;
+    if (queue->fd_signaled == true)
+        return;
+    if (queue->len >= queue->batch)
+        _tk_queue_fd_signal(queue);
+    else if (tk_timer_get_state(queue->batch_timer) != TIMER_STATE_RUNNING)
+        tk_timer_start(queue->batch_timer, TIMER_MODE_SINGLE, queue->batch_wait);
+}
+
+/**
+ * @brief رģʽͷŶ̬Ķʱ(ڲ)
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_batch_free(struct tk_queue *queue)
+{
+    if (queue->batch_timer != NULL)
+    {
+#ifdef TK_TIMER_USING_CREATE
+        if (queue->batch_timer_alloc == true)
+            tk_timer_delete(queue->batch_timer);
+        else
+#endif /* TK_TIMER_USING_CREATE */
+            tk_timer_detach(queue->batch_timer);
+    }
+    queue->batch_timer = NULL;
+    queue->batch_timer_alloc = false;
+    queue->batch = 0;
+}
+#endif /* TK_QUEUE_USING_BATCH */
+
+#ifdef TK_QUEUE_USING_JOURNAL
+/**
+ * @brief ־ģʽѹ1Ԫ(ڲ)
+ * 
+ * @param queue ж
+ * @param val ѹֵ
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_queue_journal_push(struct tk_queue *queue, void *val)
+{
+    if (tk_journal_append(queue->journal, val) == false)
+    {
+#ifdef TOOLKIT_USING_STATS
+        TK_STATS_ADD(queue->stats.push_fail, 1);
+#endif /* TOOLKIT_USING_STATS */
+        return false;
+    }
+    tk_queue_journal_len(queue);
+#ifdef TOOLKIT_USING_STATS
+    TK_STATS_ADD(queue->stats.push, 1);
+    TK_STATS_MAX(queue->stats.high_water, queue->len);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TOOLKIT_USING_COROUTINE
+    if (queue->co_wait_list != NULL)
+        tk_co_notify_queue(queue);
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
+    return true;
+}
+
+/**
+ * @brief ־ģʽµƳ1Ԫ(ڲ)
+ * 
+ * @param queue ж
+ * @param pval ֵNULLΪֻƳ
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_queue_journal_pop(struct tk_queue *queue, void *pval)
+{
+    if ((pval != NULL && tk_journal_peep(queue->journal, pval) == false) ||
+        tk_journal_consume(queue->journal) == false)
+    {
+#ifdef TOOLKIT_USING_STATS
+        TK_STATS_ADD(queue->stats.pop_fail, 1);
+#endif /* TOOLKIT_USING_STATS */
+        return false;
+    }
+    tk_queue_journal_len(queue);
+#ifdef TOOLKIT_USING_STATS
+    TK_STATS_ADD(queue->stats.pop, 1);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
+    return true;
+}
+#endif /* TK_QUEUE_USING_JOURNAL */
+
+#ifdef TK_QUEUE_USING_TTL
+/**
+ * @brief ¼дrearԪصѹtick(ڲ)
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_ttl_stamp(struct tk_queue *queue)
+{
+    if (queue->stamp != NULL)
+        queue->stamp[queue->rear] = tk_timer_get_curr_tick();
+}
+
+/**
+ * @brief ͷŶ̬ʱ(ڲ)
+ * 
+ * @param queue ж
+ */
+static void _tk_queue_ttl_free(struct tk_queue *queue)
+{
+#ifdef TK_QUEUE_USING_CREATE
+    if (queue->stamp_alloc == true)
+        free(queue->stamp);
+#endif /* TK_QUEUE_USING_CREATE */
+    queue->stamp = NULL;
+    queue->stamp_alloc = false;
+    queue->ttl = 0;
+}
+
+/**
+ * @brief ѹڵԪظ(ڲ)
+ * Ԫذѹ˳УѹtickӶ׵βѹڵԪضڶףֲҷֽ
+ * 
+ * @param queue ж
+ * @param now ǰtick
+ * @return uint16_t ѹڵԪظ
+ */
+static uint16_t _tk_queue_ttl_count(struct tk_queue *queue, uint32_t now)
+{
+    uint16_t low = 0;
+    uint16_t high = queue->len;
+    /* δʱңȡֻһαȽ */
+    if (high == 0 || now - queue->stamp[queue->front] < queue->ttl)
+        return 0;
+    while (low < high)
+    {
+        uint16_t mid = low + (high - low) / 2;
+        uint16_t index = (uint16_t)((queue->front + mid) % queue->max_queues);
+        if (now - queue->stamp[index] >= queue->ttl)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+#endif /* TK_QUEUE_USING_TTL */
 
 /**
  * @brief ̬ʼ
@@ -62,6 +332,32 @@ bool tk_queue_init(struct tk_queue *queue, void *queuepool, uint16_t pool_size,
     queue->front = 0;
     queue->rear = 0;
     queue->len = 0;
+#ifdef TOOLKIT_USING_COROUTINE
+    queue->co_wait_list = NULL;
+    queue->co_wait_tail = NULL;
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TOOLKIT_USING_STATS
+    memset(&queue->stats, 0, sizeof(queue->stats));
+    queue->stats_entry.object = NULL;
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_FD
+    queue->fd_enabled = false;
+    queue->fd_signaled = false;
+#endif /* TK_QUEUE_USING_FD */
+#ifdef TK_QUEUE_USING_JOURNAL
+    queue->journal = NULL;
+#endif /* TK_QUEUE_USING_JOURNAL */
+#ifdef TK_QUEUE_USING_TTL
+    queue->stamp = NULL;
+    queue->stamp_alloc = false;
+    queue->ttl = 0;
+    queue->expired = 0;
+#endif /* TK_QUEUE_USING_TTL */
+#ifdef TK_QUEUE_USING_BATCH
+    queue->batch_timer = NULL;
+    queue->batch_timer_alloc = false;
+    queue->batch = 0;
+#endif /* TK_QUEUE_USING_BATCH */
     return true;
 }
 
@@ -78,10 +374,26 @@ bool tk_queue_detach(struct tk_queue *queue)
     TK_ASSERT(queue);
     if (queue == NULL)
         return false;
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        tk_queue_journal_close(queue);
+#endif /* TK_QUEUE_USING_JOURNAL */
     queue->queue_pool = NULL;
     queue->front = 0;
     queue->rear = 0;
     queue->len = 0;
+#ifdef TOOLKIT_USING_STATS
+    tk_stats_unregister(&queue->stats_entry);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_BATCH
+    _tk_queue_batch_free(queue);
+#endif /* TK_QUEUE_USING_BATCH */
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_close(queue);
+#endif /* TK_QUEUE_USING_FD */
+#ifdef TK_QUEUE_USING_TTL
+    _tk_queue_ttl_free(queue);
+#endif /* TK_QUEUE_USING_TTL */
     return true;
 }
 
@@ -113,6 +425,32 @@ struct tk_queue *tk_queue_create(uint16_t queue_size, uint16_t max_queues,
     queue->front = 0;
     queue->rear = 0;
     queue->len = 0;
+#ifdef TOOLKIT_USING_COROUTINE
+    queue->co_wait_list = NULL;
+    queue->co_wait_tail = NULL;
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TOOLKIT_USING_STATS
+    memset(&queue->stats, 0, sizeof(queue->stats));
+    queue->stats_entry.object = NULL;
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_FD
+    queue->fd_enabled = false;
+    queue->fd_signaled = false;
+#endif /* TK_QUEUE_USING_FD */
+#ifdef TK_QUEUE_USING_JOURNAL
+    queue->journal = NULL;
+#endif /* TK_QUEUE_USING_JOURNAL */
+#ifdef TK_QUEUE_USING_TTL
+    queue->stamp = NULL;
+    queue->stamp_alloc = false;
+    queue->ttl = 0;
+    queue->expired = 0;
+#endif /* TK_QUEUE_USING_TTL */
+#ifdef TK_QUEUE_USING_BATCH
+    queue->batch_timer = NULL;
+    queue->batch_timer_alloc = false;
+    queue->batch = 0;
+#endif /* TK_QUEUE_USING_BATCH */
     return queue;
 }
 
@@ -128,6 +466,22 @@ bool tk_queue_delete(struct tk_queue *queue)
     TK_ASSERT(queue);
     if (queue == NULL)
         return false;
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        tk_queue_journal_close(queue);
+#endif /* TK_QUEUE_USING_JOURNAL */
+#ifdef TOOLKIT_USING_STATS
+    tk_stats_unregister(&queue->stats_entry);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_BATCH
+    _tk_queue_batch_free(queue);
+#endif /* TK_QUEUE_USING_BATCH */
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_close(queue);
+#endif /* TK_QUEUE_USING_FD */
+#ifdef TK_QUEUE_USING_TTL
+    _tk_queue_ttl_free(queue);
+#endif /* TK_QUEUE_USING_TTL */
     free(queue->queue_pool);
     free(queue);
     return true;
@@ -146,9 +500,16 @@ bool tk_queue_clean(struct tk_queue *queue)
     TK_ASSERT(queue);
     if (queue == NULL)
         return false;
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        tk_journal_reset(queue->journal);
+#endif /* TK_QUEUE_USING_JOURNAL */
     queue->front = 0;
     queue->rear = 0;
     queue->len = 0;
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
     return true;
 }
 
@@ -191,6 +552,10 @@ bool tk_queue_empty(struct tk_queue *queue)
 bool tk_queue_full(struct tk_queue *queue)
 {
     TK_ASSERT(queue);
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return false;
+#endif /* TK_QUEUE_USING_JOURNAL */
     if (queue->len >= queue->max_queues)
         return true;
     return false;
@@ -208,28 +573,52 @@ bool tk_queue_push(struct tk_queue *queue, void *val)
 {
     TK_ASSERT(queue);
     TK_ASSERT(queue->queue_pool);
-    if (tk_queue_full(queue))
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return _tk_queue_journal_push(queue, val);
+#endif /* TK_QUEUE_USING_JOURNAL */
+    bool overwrite = tk_queue_full(queue);
+    if (overwrite && queue->keep_fresh == false)
     {
-        if (queue->keep_fresh == true)
-        {
-            memcpy((uint8_t *)queue->queue_pool + (queue->rear * queue->queue_size),
-                   (uint8_t *)val, queue->queue_size);
-
-            queue->rear = (queue->rear + 1) % queue->max_queues;
-            queue->front = (queue->front + 1) % queue->max_queues;
-            queue->len = queue->max_queues;
-            return true;
-        }
+#ifdef TOOLKIT_USING_STATS
+        TK_STATS_ADD(queue->stats.push_fail, 1);
+#endif /* TOOLKIT_USING_STATS */
         return false;
     }
+#ifdef TK_QUEUE_USING_TTL
+    _tk_queue_ttl_stamp(queue);
+#endif /* TK_QUEUE_USING_TTL */
+    memcpy((uint8_t *)queue->queue_pool + (queue->rear * queue->queue_size),
+           (uint8_t *)val, queue->queue_size);
+
+    queue->rear = (queue->rear + 1) % queue->max_queues;
+    if (overwrite)
+    {
+        /* keep_freshɵԪأִ֮ͬл֪ͨ */
+        queue->front = (queue->front + 1) % queue->max_queues;
+        queue->len = queue->max_queues;
+#ifdef TOOLKIT_USING_STATS
+        TK_STATS_ADD(queue->stats.overwrite, 1);
+#endif /* TOOLKIT_USING_STATS */
+    }
     else
     {
-        memcpy((uint8_t *)queue->queue_pool + (queue->rear * queue->queue_size),
-               (uint8_t *)val, queue->queue_size);
-
-        queue->rear = (queue->rear + 1) % queue->max_queues;
         queue->len++;
     }
+#ifdef TOOLKIT_USING_STATS
+    TK_STATS_ADD(queue->stats.push, 1);
+    TK_STATS_MAX(queue->stats.high_water, queue->len);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TOOLKIT_USING_COROUTINE
+    if (queue->co_wait_list != NULL)
+        tk_co_notify_queue(queue);
+#endif /* TOOLKIT_USING_COROUTINE */
+#ifdef TK_QUEUE_USING_BATCH
+    _tk_queue_batch_push(queue);
+#endif /* TK_QUEUE_USING_BATCH */
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
     return true;
 }
 
@@ -245,8 +634,15 @@ bool tk_queue_pop(struct tk_queue *queue, void *pval)
 {
     TK_ASSERT(queue);
     TK_ASSERT(queue->queue_pool);
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return _tk_queue_journal_pop(queue, pval);
+#endif /* TK_QUEUE_USING_JOURNAL */
     if (tk_queue_empty(queue))
     {
+#ifdef TOOLKIT_USING_STATS
+        TK_STATS_ADD(queue->stats.pop_fail, 1);
+#endif /* TOOLKIT_USING_STATS */
         return false;
     }
     else
@@ -257,6 +653,12 @@ bool tk_queue_pop(struct tk_queue *queue, void *pval)
 
         queue->front = (queue->front + 1) % queue->max_queues;
         queue->len--;
+#ifdef TOOLKIT_USING_STATS
+        TK_STATS_ADD(queue->stats.pop, 1);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_FD
+        _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
     }
     return true;
 }
@@ -320,6 +722,10 @@ bool tk_queue_peep(struct tk_queue *queue, void *pval)
 {
     TK_ASSERT(queue);
     TK_ASSERT(queue->queue_pool);
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return tk_journal_peep(queue->journal, pval);
+#endif /* TK_QUEUE_USING_JOURNAL */
     if (tk_queue_empty(queue))
     {
         return false;
@@ -342,13 +748,220 @@ bool tk_queue_peep(struct tk_queue *queue, void *pval)
  */
 bool tk_queue_remove(struct tk_queue *queue)
 {
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return (tk_journal_len(queue->journal) == 0) ? true : _tk_queue_journal_pop(queue, NULL);
+#endif /* TK_QUEUE_USING_JOURNAL */
     if (tk_queue_empty(queue))
     {
         return true;
     }
     queue->front = (queue->front + 1) % queue->max_queues;
     queue->len--;
+#ifdef TOOLKIT_USING_STATS
+    TK_STATS_ADD(queue->stats.pop, 1);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
+
+    return true;
+}
 
+#ifdef TK_QUEUE_USING_TTL
+/**
+ * @brief ԪЧڣѹʱ¼tick(tk_timer_func_initõtickȡһ)
+ * ЧڵԪtk_queue_pop_freshtk_queue_drop_expired־ģʽЧ
+ * 
+ * @param queue ж
+ * @param ttl_tick Ч(λtick)0Ϊر
+ * @param stamp_pool ʱmax_queuesuint32_tNULLΪ̬(TK_QUEUE_USING_CREATE)
+ * õĻʱԪشӵǰtickʼʱ
+ * @return true óɹ
+ * @return false ʧ
+ */
+bool tk_queue_set_ttl(struct tk_queue *queue, uint32_t ttl_tick, uint32_t *stamp_pool)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    if (ttl_tick == 0)
+    {
+        _tk_queue_ttl_free(queue);
+        return true;
+    }
+    if (stamp_pool != NULL || queue->stamp == NULL)
+    {
+        uint32_t now = tk_timer_get_curr_tick();
+        uint32_t *stamp = stamp_pool;
+#ifdef TK_QUEUE_USING_CREATE
+        if (stamp == NULL && (stamp = malloc(sizeof(uint32_t) * queue->max_queues)) == NULL)
+            return false;
+#else
+        if (stamp == NULL)
+            return false;
+#endif /* TK_QUEUE_USING_CREATE */
+        _tk_queue_ttl_free(queue);
+        queue->stamp = stamp;
+        queue->stamp_alloc = (stamp_pool == NULL);
+        for (uint16_t i = 0; i < queue->len; i++)
+            queue->stamp[(queue->front + i) % queue->max_queues] = now;
+    }
+    queue->ttl = ttl_tick;
     return true;
 }
+
+/**
+ * @brief ѹڵԪأֲҺһƶfrontO(log n)
+ * 
+ * @param queue ж
+ * @return uint16_t Ԫظ
+ */
+uint16_t tk_queue_drop_expired(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    uint16_t num;
+    if (queue == NULL || queue->ttl == 0 || queue->len == 0)
+        return 0;
+#ifdef TK_QUEUE_USING_JOURNAL
+    if (queue->journal != NULL)
+        return 0;
+#endif /* TK_QUEUE_USING_JOURNAL */
+    num = _tk_queue_ttl_count(queue, tk_timer_get_curr_tick());
+    if (num == 0)
+        return 0;
+    queue->front = (uint16_t)((queue->front + num) % queue->max_queues);
+    queue->len -= num;
+    queue->expired += num;
+#ifdef TK_QUEUE_USING_FD
+    _tk_queue_fd_update(queue);
+#endif /* TK_QUEUE_USING_FD */
+    return num;
+}
+
+/**
+ * @brief ѹڵԪغ󵯳1Ԫ
+ * 
+ * @param queue ҪĶж
+ * @param pval ֵ
+ * @return true ɹ
+ * @return false ʧܣΪջȫѹ
+ */
+bool tk_queue_pop_fresh(struct tk_queue *queue, void *pval)
+{
+    TK_ASSERT(queue);
+    TK_ASSERT(queue->queue_pool);
+    tk_queue_drop_expired(queue);
+    return tk_queue_pop(queue, pval);
+}
+
+/**
+ * @brief ȡڱԪۼƸ
+ * 
+ * @param queue ж
+ * @return uint32_t ۼƶ
+ */
+uint32_t tk_queue_get_expired(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return 0;
+    return queue->expired;
+}
+#endif /* TK_QUEUE_USING_TTL */
+
+#ifdef TK_QUEUE_USING_FD
+/**
+ * @brief ȡжӦeventfdepollȶ·
+ * зǿʱfdɶбȡպfdɶ
+ * 
+ * @param queue ж
+ * @return int ļ-1Ϊȡʧ
+ */
+int tk_queue_get_fd(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return -1;
+    if (queue->fd_enabled == false)
+    {
+        queue->queue_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (queue->queue_fd < 0)
+            return -1;
+        queue->fd_enabled = true;
+        queue->fd_signaled = false;
+    }
+    _tk_queue_fd_update(queue);
+    return queue->queue_fd;
+}
+#endif /* TK_QUEUE_USING_FD */
+
+#ifdef TK_QUEUE_USING_BATCH
+/**
+ * @brief ֪ͨeventfdڻѹﵽСԪصȴwait_tickűΪɶ
+ * Сÿtickѹ1~batch_max֮Զ־ģʽЧ
+ * ѹtk_timer_loop_handlerͬһ̣߳ͬһ
+ * 
+ * @param queue ж
+ * @param timer ڵȴʱĶʱNULLΪ̬(TK_TIMER_USING_CREATE)õĶʱ
+ * @param batch_max С0Ϊر
+ * @param wait_tick Ԫȴʱ(λtick)
+ * @return true óɹ
+ * @return false ʧ
+ */
+bool tk_queue_set_batch(struct tk_queue *queue, struct tk_timer *timer, uint16_t batch_max, uint32_t wait_tick)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return false;
+    if (batch_max == 0)
+    {
+        _tk_queue_batch_free(queue);
+        _tk_queue_fd_update(queue);
+        return true;
+    }
+    if (wait_tick == 0 || tk_queue_get_fd(queue) < 0)
+        return false;
+    if (queue->batch_timer == NULL || (timer != NULL && timer != queue->batch_timer))
+    {
+        struct tk_timer *batch_timer = timer;
+#ifdef TK_TIMER_USING_CREATE
+        if (batch_timer == NULL && (batch_timer = tk_timer_create(_tk_queue_batch_timeout)) == NULL)
+            return false;
+#else
+        if (batch_timer == NULL)
+            return false;
+#endif /* TK_TIMER_USING_CREATE */
+        if (timer != NULL && tk_timer_init(timer, _tk_queue_batch_timeout) == false)
+            return false;
+        _tk_queue_batch_free(queue);
+        batch_timer->user_data = queue;
+        queue->batch_timer = batch_timer;
+        queue->batch_timer_alloc = (timer == NULL);
+        queue->batch = 1;
+        queue->batch_tick = tk_timer_get_curr_tick();
+        queue->batch_count = 0;
+        queue->batch_rate = 0;
+    }
+    queue->batch_max = batch_max;
+    queue->batch_wait = wait_tick;
+    if (queue->batch > batch_max)
+        queue->batch = batch_max;
+    return true;
+}
+
+/**
+ * @brief ȡǰС
+ * 
+ * @param queue ж
+ * @return uint16_t С0Ϊδ֪ͨ
+ */
+uint16_t tk_queue_get_batch(struct tk_queue *queue)
+{
+    TK_ASSERT(queue);
+    if (queue == NULL)
+        return 0;
+    return queue->batch;
+}
+#endif /* TK_QUEUE_USING_BATCH */
 #endif /* TOOLKIT_USING_QUEUE */
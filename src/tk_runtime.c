@@ -0,0 +1,577 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     unwind started workers on failure, free timer list at exit
+* 2026-10-19     zhangran     atomic running flag
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* _GNU_SOURCE */
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_RUNTIME
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TK_RUNTIME_CACHE_LINE 64
+
+struct tk_runtime_task
+{
+    void (*fn)(void *arg);
+    void *arg;
+};
+
+struct tk_runtime_worker
+{
+    /* ˫˶(Chase-Lev)̴߳bottomѹ뵯̴߳topȡ */
+    int64_t top __attribute__((aligned(TK_RUNTIME_CACHE_LINE)));
+    int64_t bottom __attribute__((aligned(TK_RUNTIME_CACHE_LINE)));
+    struct tk_runtime_task *deque;
+    /* ύ */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct tk_queue inbox;
+    bool wake_pending;
+    bool sleeping;
+    uint16_t id;
+    uint32_t seed;
+    pthread_t thread;
+    struct tk_runtime *runtime;
+} __attribute__((aligned(TK_RUNTIME_CACHE_LINE)));
+
+struct tk_runtime
+{
+    bool running; /* ֹͣʱreleaseд룬߳acquireȡ */
+    uint16_t worker_num;
+    uint32_t submit_index;
+    uint32_t idle_num;
+    uint32_t (*get_tick)(void);
+    struct tk_runtime_worker *workers;
+    struct tk_runtime_task *deque_pool;
+    struct tk_runtime_task *inbox_pool;
+};
+
+static __thread struct tk_runtime_worker *tk_runtime_curr_worker = NULL;
+static struct tk_runtime *tk_runtime_default = NULL;
+
+/**
+ * @brief ˫˶ѹ񣬽̵߳(ڲ)
+ * 
+ * @param worker ߳
+ * @param task 
+ * @return true ɹ
+ * @return false 
+ */
+static bool _tk_runtime_deque_push(struct tk_runtime_worker *worker, struct tk_runtime_task *task)
+{
+    int64_t b = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED);
+    int64_t t = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+    struct tk_runtime_task *slot;
+    if (b - t >= TK_RUNTIME_DEQUE_SIZE)
+        return false;
+    slot = &worker->deque[b & (TK_RUNTIME_DEQUE_SIZE - 1)];
+    __atomic_store_n(&slot->fn, task->fn, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->arg, task->arg, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&worker->bottom, b + 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @brief ˫˶е񣬽̵߳(ڲ)
+ * 
+ * @param worker ߳
+ * @param task 
+ * @return true ɹ
+ * @return false Ϊ
+ */
+static bool _tk_runtime_deque_pop(struct tk_runtime_worker *worker, struct tk_runtime_task *task)
+{
+    int64_t b = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED) - 1;
+    int64_t t;
+    bool result = true;
+    __atomic_store_n(&worker->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    t = __atomic_load_n(&worker->top, __ATOMIC_RELAXED);
+    if (t > b)
+    {
+        __atomic_store_n(&worker->bottom, b + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    *task = worker->deque[b & (TK_RUNTIME_DEQUE_SIZE - 1)];
+    if (t == b)
+    {
+        /* һȡ߾ */
+        if (!__atomic_compare_exchange_n(&worker->top, &t, t + 1, false,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            result = false;
+        __atomic_store_n(&worker->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return result;
+}
+
+/**
+ * @brief ̵߳˫˶ȡ(ڲ)
+ * 
+ * @param victim ȡĹ߳
+ * @param task ȡ
+ * @return true ɹ
+ * @return false Ϊջʧ
+ */
+static bool _tk_runtime_deque_steal(struct tk_runtime_worker *victim, struct tk_runtime_task *task)
+{
+    int64_t t = __atomic_load_n(&victim->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t b = __atomic_load_n(&victim->bottom, __ATOMIC_ACQUIRE);
+    struct tk_runtime_task *slot;
+    if (t >= b)
+        return false;
+    slot = &victim->deque[t & (TK_RUNTIME_DEQUE_SIZE - 1)];
+    task->fn = __atomic_load_n(&slot->fn, __ATOMIC_RELAXED);
+    task->arg = __atomic_load_n(&slot->arg, __ATOMIC_RELAXED);
+    return __atomic_compare_exchange_n(&victim->top, &t, t + 1, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief ѹ߳(ڲ)
+ * 
+ * @param worker ߳
+ */
+static void _tk_runtime_wake(struct tk_runtime_worker *worker)
+{
+    pthread_mutex_lock(&worker->lock);
+    worker->wake_pending = true;
+    if (worker->sleeping)
+        pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+/**
+ * @brief п߳ʱһȡ(ڲ)
+ * 
+ * @param runtime ʱ
+ * @param self ǰ߳
+ */
+static void _tk_runtime_wake_idle(struct tk_runtime *runtime, struct tk_runtime_worker *self)
+{
+    uint16_t i;
+    /* _tk_runtime_parkеļԣⶪʧ */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&runtime->idle_num, __ATOMIC_RELAXED) == 0)
+        return;
+    for (i = 1; i < runtime->worker_num; i++)
+    {
+        struct tk_runtime_worker *worker = &runtime->workers[(self->id + i) % runtime->worker_num];
+        if (__atomic_load_n(&worker->sleeping, __ATOMIC_RELAXED))
+        {
+            _tk_runtime_wake(worker);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief ύеת뱾˫˶(ڲ)
+ * 
+ * @param worker ߳
+ * @return uint16_t ת
+ */
+static uint16_t _tk_runtime_drain_inbox(struct tk_runtime_worker *worker)
+{
+    struct tk_runtime_task tasks[TK_RUNTIME_BATCH_SIZE];
+    uint16_t i, len;
+    pthread_mutex_lock(&worker->lock);
+    len = tk_queue_pop_multi(&worker->inbox, tasks, TK_RUNTIME_BATCH_SIZE);
+    pthread_mutex_unlock(&worker->lock);
+    for (i = 0; i < len; i++)
+    {
+        if (_tk_runtime_deque_push(worker, &tasks[i]) == false)
+            tasks[i].fn(tasks[i].arg);
+    }
+    return len;
+}
+
+/**
+ * @brief ȡһִ񣺱ضСύСȡ(ڲ)
+ * 
+ * @param worker ߳
+ * @param task ȡ
+ * @return true ɹ
+ * @return false 
+ */
+static bool _tk_runtime_find_task(struct tk_runtime_worker *worker, struct tk_runtime_task *task)
+{
+    struct tk_runtime *runtime = worker->runtime;
+    uint16_t i, start;
+    if (_tk_runtime_deque_pop(worker, task))
+        return true;
+    if (_tk_runtime_drain_inbox(worker) && _tk_runtime_deque_pop(worker, task))
+        return true;
+    if (runtime->worker_num < 2)
+        return false;
+    worker->seed = worker->seed * 1103515245 + 12345;
+    start = (worker->seed >> 16) % runtime->worker_num;
+    for (i = 0; i < runtime->worker_num; i++)
+    {
+        struct tk_runtime_worker *victim = &runtime->workers[(start + i) % runtime->worker_num];
+        if (victim != worker && _tk_runtime_deque_steal(victim, task))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief жǷпȡ(ڲ)
+ * 
+ * @param runtime ʱ
+ * @return true 
+ * @return false 
+ */
+static bool _tk_runtime_has_work(struct tk_runtime *runtime)
+{
+    uint16_t i;
+    for (i = 0; i < runtime->worker_num; i++)
+    {
+        struct tk_runtime_worker *worker = &runtime->workers[i];
+        if (__atomic_load_n(&worker->top, __ATOMIC_RELAXED) <
+            __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief ߣֱѡضʱʱгʱ(ڲ)
+ * 
+ * @param worker ߳
+ */
+static void _tk_runtime_park(struct tk_runtime_worker *worker)
+{
+    struct tk_runtime *runtime = worker->runtime;
+    uint32_t wait_tick = TK_RUNTIME_IDLE_MS * TK_TIMER_TICK_PER_SECOND / 1000;
+    struct timespec ts;
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS)
+    uint32_t next_tick;
+    if (tk_timer_get_next_tick(&next_tick))
+    {
+        uint32_t delta = next_tick - runtime->get_tick();
+        if (delta > (UINT32_MAX / 2))
+            return;
+        if (delta < wait_tick)
+            wait_tick = delta;
+    }
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS) */
+    uint64_t ns = (uint64_t)wait_tick * 1000000000ULL / TK_TIMER_TICK_PER_SECOND;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += ns / 1000000000ULL;
+    ts.tv_nsec += ns % 1000000000ULL;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    pthread_mutex_lock(&worker->lock);
+    if (worker->wake_pending == false && tk_queue_empty(&worker->inbox) &&
+        __atomic_load_n(&runtime->running, __ATOMIC_ACQUIRE))
+    {
+        __atomic_store_n(&worker->sleeping, true, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&runtime->idle_num, 1, __ATOMIC_SEQ_CST);
+        if (_tk_runtime_has_work(runtime) == false)
+            pthread_cond_timedwait(&worker->cond, &worker->lock, &ts);
+        __atomic_fetch_sub(&runtime->idle_num, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&worker->sleeping, false, __ATOMIC_RELAXED);
+    }
+    worker->wake_pending = false;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+/**
+ * @brief ߳(ڲ)
+ * 
+ * @param param ߳
+ * @return void* NULL
+ */
+static void *_tk_runtime_worker_entry(void *param)
+{
+    struct tk_runtime_worker *worker = param;
+    struct tk_runtime *runtime = worker->runtime;
+    struct tk_runtime_task task;
+#ifdef TK_RUNTIME_USING_AFFINITY
+    cpu_set_t cpuset;
+    long cpu_num = sysconf(_SC_NPROCESSORS_ONLN);
+    CPU_ZERO(&cpuset);
+    CPU_SET(worker->id % (cpu_num > 0 ? cpu_num : 1), &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#endif /* TK_RUNTIME_USING_AFFINITY */
+    tk_runtime_curr_worker = worker;
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS)
+    tk_timer_func_init(runtime->get_tick);
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS) */
+    while (__atomic_load_n(&runtime->running, __ATOMIC_ACQUIRE))
+    {
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS)
+        uint32_t next_tick;
+        if (tk_timer_get_next_tick(&next_tick) &&
+            (runtime->get_tick() - next_tick) < (UINT32_MAX / 2))
+            tk_timer_loop_handler();
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS) */
+        if (_tk_runtime_find_task(worker, &task))
+            task.fn(task.arg);
+        else
+            _tk_runtime_park(worker);
+    }
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS)
+    tk_timer_func_deinit();
+#endif /* defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TLS) */
+    tk_runtime_curr_worker = NULL;
+    return NULL;
+}
+
+/**
+ * @brief Ĭtickȡλ 1/TK_TIMER_TICK_PER_SECOND (ڲ)
+ * 
+ * @return uint32_t ǰtick
+ */
+static uint32_t _tk_runtime_get_tick(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * TK_TIMER_TICK_PER_SECOND +
+                      (uint64_t)ts.tv_nsec * TK_TIMER_TICK_PER_SECOND / 1000000000ULL);
+}
+
+/**
+ * @brief ֹͣḶ́߳ͷʱ(ڲ)
+ * 
+ * @param runtime ʱworker_numΪĹ̸߳
+ * @param init_num ѳʼͬύеĹ̸߳
+ */
+static void _tk_runtime_destroy(struct tk_runtime *runtime, uint16_t init_num)
+{
+    uint16_t i;
+    /* ڻд룬ǰworker->lockڼ飬ֹͣ */
+    __atomic_store_n(&runtime->running, false, __ATOMIC_RELEASE);
+    for (i = 0; i < runtime->worker_num; i++)
+        _tk_runtime_wake(&runtime->workers[i]);
+    for (i = 0; i < runtime->worker_num; i++)
+        pthread_join(runtime->workers[i].thread, NULL);
+    for (i = 0; i < init_num; i++)
+    {
+        struct tk_runtime_worker *worker = &runtime->workers[i];
+        tk_queue_detach(&worker->inbox);
+        pthread_mutex_destroy(&worker->lock);
+        pthread_cond_destroy(&worker->cond);
+    }
+    if (tk_runtime_default == runtime)
+        tk_runtime_default = NULL;
+    free(runtime->workers);
+    free(runtime->deque_pool);
+    free(runtime->inbox_pool);
+    free(runtime);
+}
+
+/**
+ * @brief ̬ʱ߳
+ * TK_TIMER_USING_TLSÿ߳ӵжĶʱڹ߳дĶʱɸ̴߳
+ * 
+ * @param worker_num ̸߳0ΪCPU
+ * @param get_tick_func ȡϵͳtickص(λ 1/TK_TIMER_TICK_PER_SECOND )NULLʹCLOCK_MONOTONIC
+ * @return struct tk_runtime* ʱNULLΪʧ
+ */
+struct tk_runtime *tk_runtime_create(uint16_t worker_num, uint32_t (*get_tick_func)(void))
+{
+    struct tk_runtime *runtime;
+    pthread_condattr_t attr;
+    uint16_t i;
+    if (worker_num == 0)
+    {
+        long cpu_num = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_num = (cpu_num > 0) ? (uint16_t)cpu_num : 1;
+    }
+    if ((runtime = malloc(sizeof(struct tk_runtime))) == NULL)
+        return NULL;
+    runtime->workers = aligned_alloc(TK_RUNTIME_CACHE_LINE,
+                                     sizeof(struct tk_runtime_worker) * worker_num);
+    runtime->deque_pool = malloc(sizeof(struct tk_runtime_task) * TK_RUNTIME_DEQUE_SIZE * worker_num);
+    runtime->inbox_pool = malloc(sizeof(struct tk_runtime_task) * TK_RUNTIME_INBOX_SIZE * worker_num);
+    if (runtime->workers == NULL || runtime->deque_pool == NULL || runtime->inbox_pool == NULL)
+    {
+        free(runtime->workers);
+        free(runtime->deque_pool);
+        free(runtime->inbox_pool);
+        free(runtime);
+        return NULL;
+    }
+    runtime->running = true;
+    runtime->worker_num = worker_num;
+    runtime->submit_index = 0;
+    runtime->idle_num = 0;
+    runtime->get_tick = (get_tick_func != NULL) ? get_tick_func : _tk_runtime_get_tick;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    for (i = 0; i < worker_num; i++)
+    {
+        struct tk_runtime_worker *worker = &runtime->workers[i];
+        worker->top = 0;
+        worker->bottom = 0;
+        worker->deque = runtime->deque_pool + (size_t)i * TK_RUNTIME_DEQUE_SIZE;
+        pthread_mutex_init(&worker->lock, NULL);
+        pthread_cond_init(&worker->cond, &attr);
+        tk_queue_init(&worker->inbox, runtime->inbox_pool + (size_t)i * TK_RUNTIME_INBOX_SIZE,
+                      sizeof(struct tk_runtime_task) * TK_RUNTIME_INBOX_SIZE,
+                      sizeof(struct tk_runtime_task), false);
+        worker->wake_pending = false;
+        worker->sleeping = false;
+        worker->id = i;
+        worker->seed = i + 1;
+        worker->runtime = runtime;
+    }
+    pthread_condattr_destroy(&attr);
+    for (i = 0; i < worker_num; i++)
+    {
+        if (pthread_create(&runtime->workers[i].thread, NULL, _tk_runtime_worker_entry,
+                           &runtime->workers[i]) != 0)
+        {
+            /* ֻĹ߳ */
+            runtime->worker_num = i;
+            _tk_runtime_destroy(runtime, worker_num);
+            return NULL;
+        }
+    }
+    tk_runtime_default = runtime;
+    return runtime;
+}
+
+/**
+ * @brief ֹ̲ͣ߳ɾʱδִе񽫱
+ * 
+ * @param runtime Ҫɾʱ
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_runtime_delete(struct tk_runtime *runtime)
+{
+    TK_ASSERT(runtime);
+    if (runtime == NULL)
+        return false;
+    _tk_runtime_destroy(runtime, runtime->worker_num);
+    return true;
+}
+
+/**
+ * @brief ָ߳ύ(ύ)
+ * 
+ * @param runtime ʱ
+ * @param worker_id Ŀ깤̱߳
+ * @param fn 
+ * @param arg 
+ * @return true ύɹ
+ * @return false ύʧ(Ŀύ)
+ */
+bool tk_runtime_submit(struct tk_runtime *runtime, uint16_t worker_id, void (*fn)(void *arg), void *arg)
+{
+    TK_ASSERT(runtime);
+    TK_ASSERT(fn);
+    struct tk_runtime_worker *worker;
+    struct tk_runtime_task task;
+    bool result, sleeping;
+    if (runtime == NULL || worker_id >= runtime->worker_num)
+        return false;
+    worker = &runtime->workers[worker_id];
+    task.fn = fn;
+    task.arg = arg;
+    pthread_mutex_lock(&worker->lock);
+    result = tk_queue_push(&worker->inbox, &task);
+    worker->wake_pending = true;
+    sleeping = worker->sleeping;
+    if (sleeping)
+        pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+    return result;
+}
+
+/**
+ * @brief 
+ * ڹ߳еʱѹ뱾̵߳ıضУ߳̿ȡ
+ * ߳еʱύʱĸ߳
+ * 
+ * @param fn 
+ * @param arg 
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_spawn(void (*fn)(void *arg), void *arg)
+{
+    TK_ASSERT(fn);
+    struct tk_runtime_worker *worker = tk_runtime_curr_worker;
+    struct tk_runtime_task task;
+    if (worker != NULL)
+    {
+        task.fn = fn;
+        task.arg = arg;
+        if (_tk_runtime_deque_push(worker, &task) == false)
+        {
+            /* ضֱִ */
+            fn(arg);
+            return true;
+        }
+        _tk_runtime_wake_idle(worker->runtime, worker);
+        return true;
+    }
+    if (tk_runtime_default == NULL)
+        return false;
+    uint32_t index = __atomic_fetch_add(&tk_runtime_default->submit_index, 1, __ATOMIC_RELAXED);
+    return tk_runtime_submit(tk_runtime_default, index % tk_runtime_default->worker_num, fn, arg);
+}
+
+/**
+ * @brief ȡǰ̱߳
+ * 
+ * @return int ̱߳ţ-1Ϊǹ߳
+ */
+int tk_runtime_worker_id(void)
+{
+    if (tk_runtime_curr_worker == NULL)
+        return -1;
+    return tk_runtime_curr_worker->id;
+}
+
+/**
+ * @brief ȡʱĹ̸߳
+ * 
+ * @param runtime ʱ
+ * @return uint16_t ̸߳
+ */
+uint16_t tk_runtime_worker_num(struct tk_runtime *runtime)
+{
+    TK_ASSERT(runtime);
+    return runtime->worker_num;
+}
+
+#endif /* TOOLKIT_USING_RUNTIME */
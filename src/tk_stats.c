@@ -0,0 +1,236 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     O(1) unregister
+*/
+
+#include "toolkit.h"
+#ifdef TOOLKIT_USING_STATS
+
+static struct tk_stats_entry *tk_stats_head = NULL;
+static uint32_t (*tk_stats_time_func)(void) = NULL;
+
+/**
+ * @brief עͳƶעͨtk_stats_dump
+ * עע̰߳ȫģӦڳʼ׶ε
+ * 
+ * @param entry ڵͳƽڵ㣬&queue->stats_entry
+ * @param type 
+ * @param object 
+ * @param name 
+ * @return true עɹ
+ * @return false עʧ
+ */
+bool tk_stats_register(struct tk_stats_entry *entry, tk_stats_type type, void *object, const char *name)
+{
+    TK_ASSERT(entry);
+    TK_ASSERT(object);
+    if (entry == NULL || object == NULL)
+        return false;
+    if (entry->object != NULL)
+        return false;
+    entry->type = type;
+    entry->name = name;
+    entry->object = object;
+    entry->prev = NULL;
+    entry->next = tk_stats_head;
+    if (tk_stats_head != NULL)
+        tk_stats_head->prev = entry;
+    tk_stats_head = entry;
+    return true;
+}
+
+/**
+ * @brief עͳƶ󣬶ɾʱԶãO(1)
+ * 
+ * @param entry ڵͳƽڵ
+ * @return true עɹ
+ * @return false δע
+ */
+bool tk_stats_unregister(struct tk_stats_entry *entry)
+{
+    TK_ASSERT(entry);
+    if (entry == NULL || entry->object == NULL)
+        return false;
+    if (entry->prev != NULL)
+        entry->prev->next = entry->next;
+    else
+        tk_stats_head = entry->next;
+    if (entry->next != NULL)
+        entry->next->prev = entry->prev;
+    entry->object = NULL;
+    entry->prev = NULL;
+    entry->next = NULL;
+    return true;
+}
+
+/**
+ * @brief ûصʱͳʹõʱȡδʱʹöʱtick
+ * 
+ * @param time_func ʱȡ緵CPU
+ */
+void tk_stats_set_time_func(uint32_t (*time_func)(void))
+{
+    tk_stats_time_func = time_func;
+}
+
+/**
+ * @brief ȡصʱͳʹõʱ
+ * 
+ * @return uint32_t ǰʱ
+ */
+uint32_t tk_stats_get_time(void)
+{
+    if (tk_stats_time_func != NULL)
+        return tk_stats_time_func();
+#ifdef TOOLKIT_USING_TIMER
+    return tk_timer_get_curr_tick();
+#else
+    return 0;
+#endif /* TOOLKIT_USING_TIMER */
+}
+
+/**
+ * @brief ֱͼ±꣬±iӦ[2^(i-1), 2^i)±0Ӧ0
+ * 
+ * @param value ͳֵ
+ * @return uint8_t ֱͼ±
+ */
+uint8_t tk_stats_hist_index(uint32_t value)
+{
+    uint8_t index = 0;
+    while (value != 0 && index < (TK_STATS_HIST_SIZE - 1))
+    {
+        value >>= 1;
+        index++;
+    }
+    return index;
+}
+
+/**
+ * @brief עͳ
+ * 
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_stats_reset(void)
+{
+    struct tk_stats_entry *entry;
+    for (entry = tk_stats_head; entry != NULL; entry = entry->next)
+    {
+        switch (entry->type)
+        {
+#ifdef TOOLKIT_USING_QUEUE
+        case TK_STATS_TYPE_QUEUE:
+            memset(&((struct tk_queue *)entry->object)->stats, 0, sizeof(struct tk_queue_stats));
+            break;
+#endif /* TOOLKIT_USING_QUEUE */
+#ifdef TOOLKIT_USING_TIMER
+        case TK_STATS_TYPE_TIMER:
+            memset(&((struct tk_timer *)entry->object)->stats, 0, sizeof(struct tk_timer_stats));
+            break;
+#endif /* TOOLKIT_USING_TIMER */
+#ifdef TOOLKIT_USING_EVENT
+        case TK_STATS_TYPE_EVENT:
+            memset(&((struct tk_event *)entry->object)->stats, 0, sizeof(struct tk_event_stats));
+            break;
+#endif /* TOOLKIT_USING_EVENT */
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief ıʽעͳƣÿһ
+ * 
+ * @param fp ļstdout
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_stats_dump(FILE *fp)
+{
+    TK_ASSERT(fp);
+    struct tk_stats_entry *entry;
+    if (fp == NULL)
+        return false;
+    for (entry = tk_stats_head; entry != NULL; entry = entry->next)
+    {
+        const char *name = (entry->name != NULL) ? entry->name : "-";
+        switch (entry->type)
+        {
+#ifdef TOOLKIT_USING_QUEUE
+        case TK_STATS_TYPE_QUEUE:
+        {
+            struct tk_queue *queue = entry->object;
+            fprintf(fp, "queue %s push=%u pop=%u push_fail=%u pop_fail=%u overwrite=%u high_water=%u/%u\n",
+                    name,
+                    (unsigned)TK_STATS_LOAD(queue->stats.push),
+                    (unsigned)TK_STATS_LOAD(queue->stats.pop),
+                    (unsigned)TK_STATS_LOAD(queue->stats.push_fail),
+                    (unsigned)TK_STATS_LOAD(queue->stats.pop_fail),
+                    (unsigned)TK_STATS_LOAD(queue->stats.overwrite),
+                    (unsigned)TK_STATS_LOAD(queue->stats.high_water),
+                    (unsigned)queue->max_queues);
+            break;
+        }
+#endif /* TOOLKIT_USING_QUEUE */
+#ifdef TOOLKIT_USING_TIMER
+        case TK_STATS_TYPE_TIMER:
+        {
+            struct tk_timer *timer = entry->object;
+            uint32_t fire = TK_STATS_LOAD(timer->stats.fire);
+            uint8_t i;
+            fprintf(fp, "timer %s fire=%u late_max=%u late_hist=", name,
+                    (unsigned)fire, (unsigned)TK_STATS_LOAD(timer->stats.late_max));
+            for (i = 0; i < TK_STATS_HIST_SIZE; i++)
+                fprintf(fp, (i == 0) ? "%u" : ",%u", (unsigned)TK_STATS_LOAD(timer->stats.late_hist[i]));
+            fprintf(fp, " callback_max=%u callback_avg=%u\n",
+                    (unsigned)TK_STATS_LOAD(timer->stats.callback_max),
+                    (unsigned)(fire ? TK_STATS_LOAD(timer->stats.callback_total) / fire : 0));
+            break;
+        }
+#endif /* TOOLKIT_USING_TIMER */
+#ifdef TOOLKIT_USING_EVENT
+        case TK_STATS_TYPE_EVENT:
+        {
+            struct tk_event *event = entry->object;
+            fprintf(fp, "event %s send=%u recv=%u hit=%u\n", name,
+                    (unsigned)TK_STATS_LOAD(event->stats.send),
+                    (unsigned)TK_STATS_LOAD(event->stats.recv),
+                    (unsigned)TK_STATS_LOAD(event->stats.hit));
+            break;
+        }
+#endif /* TOOLKIT_USING_EVENT */
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+#endif /* TOOLKIT_USING_STATS */
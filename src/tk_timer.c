@@ -27,37 +27,455 @@
 * 2020-01-29     zhangran     add assert for developer
 * 2020-06-04     zhangran     modify delay_tick type
 * 2020-11-30     zhangran     fix bug when ticks overflow
+* 2026-10-19     zhangran     track the earliest deadline, add timerfd driver
+* 2026-10-19     zhangran     add tk_timer_func_deinit
+* 2026-10-19     zhangran     add thread local timer list
+* 2026-10-19     zhangran     add timer stats
+* 2026-10-19     zhangran     add firing latency tracer
+* 2026-10-19     zhangran     keep a tail pointer, insert in O(1)
+* 2026-10-19     zhangran     add virtual clock simulation hooks
+* 2026-10-19     zhangran     add batch callback
+* 2026-10-19     zhangran     add timer group
+* 2026-10-19     zhangran     defer deletes during dispatch, add cross-thread delete
+* 2026-10-19     zhangran     sample traced passes, one trace clock read per expiry
+* 2026-10-19     zhangran     skip batched timers whose group stopped before the flush
+* 2026-10-19     zhangran     detach instead of free static timers of a deleted group
 */
 
 #include "toolkit.h"
 #ifdef TOOLKIT_USING_TIMER
+#ifdef TK_TIMER_USING_FD
+#include <sys/timerfd.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#endif /* TK_TIMER_USING_FD */
+/* ÿ߳ӵжĶʱ */
+#ifdef TK_TIMER_USING_TLS
+#define TK_TIMER_LOCAL __thread
+#else
+#define TK_TIMER_LOCAL
+#endif /* TK_TIMER_USING_TLS */
+
 typedef uint32_t (*tk_timer_get_tick_callback)(void);
-static tk_timer_get_tick_callback tk_timer_get_tick = NULL;
+static TK_TIMER_LOCAL tk_timer_get_tick_callback tk_timer_get_tick = NULL;
 
 #ifndef TK_TIMER_USING_CREATE
-static struct tk_timer tk_timer_node;
+static TK_TIMER_LOCAL struct tk_timer tk_timer_node;
+#endif /* TK_TIMER_USING_CREATE */
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_head_node = NULL;
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_tail_node = NULL;
+
+/* 糬ʱʱֻ̣ڻʵ糬ʱʱ */
+static TK_TIMER_LOCAL bool tk_timer_next_valid = false;
+static TK_TIMER_LOCAL uint32_t tk_timer_next_tick = 0;
+static TK_TIMER_LOCAL bool tk_timer_dispatching = false;
+/* һҪʵĶʱƳʱͬƣصпɾⶨʱ */
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_cursor = NULL;
+#ifdef TK_TIMER_USING_CREATE
+/* صɾĶʱƳnextӣֽʱȫͷ */
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_reclaim_list = NULL;
+/* ɾʱĶʱƳnextӣÿֽʱͷ */
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_reclaim_group_list = NULL;
+#ifdef TK_TIMER_USING_TLS
+/* ߳ɾı̶߳ʱУremote_nextӣһִʼʱͷ */
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_remote_list = NULL;
+#endif /* TK_TIMER_USING_TLS */
 #endif /* TK_TIMER_USING_CREATE */
-static struct tk_timer *tk_timer_head_node = NULL;
+
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+/* ֱѳʱʹصĶʱ */
+struct tk_timer_batch_entry
+{
+    tk_timer_batch_callback callback;
+    struct tk_timer *timer;
+    uint32_t deadline;
+};
+static TK_TIMER_LOCAL struct tk_timer_batch_entry tk_timer_batch_entries[TK_TIMER_BATCH_SIZE];
+static TK_TIMER_LOCAL struct tk_timer *tk_timer_batch_timers[TK_TIMER_BATCH_SIZE];
+#ifdef TK_TIMER_USING_TRACE
+static TK_TIMER_LOCAL uint32_t tk_timer_batch_deadlines[TK_TIMER_BATCH_SIZE];
+#endif /* TK_TIMER_USING_TRACE */
+static TK_TIMER_LOCAL uint32_t tk_timer_batch_num = 0;
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+
+#ifdef TK_TIMER_USING_FD
+static TK_TIMER_LOCAL int tk_timer_fd = -1;
+static TK_TIMER_LOCAL bool tk_timer_armed_valid = false;
+static TK_TIMER_LOCAL uint32_t tk_timer_armed_tick = 0;
+#endif /* TK_TIMER_USING_FD */
+
+#ifdef TK_TIMER_USING_TRACE
+/* ÿ߳һ׷ٻֻɱ߳д룬߳̿ȡ */
+struct tk_timer_trace_ring
+{
+    struct tk_timer_trace_record records[TK_TIMER_TRACE_SIZE];
+    uint32_t head;
+    uint32_t thread;
+    uint32_t hist_count[2][TK_TIMER_TRACE_HIST_SIZE];
+    uint32_t max[2];
+    struct tk_timer_trace_ring *next;
+};
+#ifndef TK_TIMER_USING_TLS
+static struct tk_timer_trace_ring tk_timer_trace_static_ring;
+#endif /* TK_TIMER_USING_TLS */
+static struct tk_timer_trace_ring *tk_timer_trace_rings = NULL;
+static uint32_t tk_timer_trace_thread_num = 0;
+static uint32_t (*tk_timer_trace_time)(void) = NULL;
+static uint32_t tk_timer_trace_units = TK_TIMER_TICK_PER_SECOND;
+static bool tk_timer_trace_enabled = true;
+static TK_TIMER_LOCAL struct tk_timer_trace_ring *tk_timer_trace_local = NULL;
+/* ִ׷״̬׸ʱʱʱžǷ׷ٲȡʱ */
+static TK_TIMER_LOCAL uint32_t tk_timer_trace_pass_num = 0;
+static TK_TIMER_LOCAL bool tk_timer_trace_pass_on = false;
+static TK_TIMER_LOCAL uint32_t tk_timer_trace_pass_tick = 0;
+static TK_TIMER_LOCAL uint32_t tk_timer_trace_pass_begin = 0;
+static TK_TIMER_LOCAL uint32_t tk_timer_trace_last = 0;
+#endif /* TK_TIMER_USING_TRACE */
+
+/**
+ * @brief жtick aǷtick b(ڲ)
+ * 
+ * @param a tick a
+ * @param b tick b
+ * @return true ab
+ * @return false ab
+ */
+static bool _tk_timer_tick_before(uint32_t a, uint32_t b)
+{
+    return ((uint32_t)(a - b) > (UINT32_MAX / 2));
+}
+
+/**
+ * @brief 糬ʱʱ(ڲ)
+ * 
+ * @param tick µĳʱʱ
+ */
+static void _tk_timer_next_update(uint32_t tick)
+{
+    if (tk_timer_next_valid == false || _tk_timer_tick_before(tick, tk_timer_next_tick))
+    {
+        tk_timer_next_tick = tick;
+        tk_timer_next_valid = true;
+    }
+}
+
+#ifdef TK_TIMER_USING_GROUP
+/**
+ * @brief ͬʱƽֹͣڶʱ(ڲ)
+ * 
+ * @param timer ĳʱĶʱ
+ * @return true ʱɾʱͷ
+ * @return false ʱЧ
+ */
+static bool _tk_timer_group_sync(struct tk_timer *timer)
+{
+    struct tk_timer_group *group = timer->group;
+    if (timer->group_shift != group->shift)
+    {
+        timer->timer_tick_timeout += group->shift - timer->group_shift;
+        timer->group_shift = group->shift;
+    }
+    if (timer->enable && timer->group_gen != group->gen)
+    {
+        timer->enable = false;
+        timer->state = TIMER_STATE_STOP;
+    }
+    return group->dead;
+}
+
+/**
+ * @brief ж϶ʱǷδʱֹͣ(ڲ)
+ * 
+ * @param timer ʱ
+ * @return true ڶʱδʱֹͣ
+ * @return false ѱʱֹͣɾ
+ */
+static bool _tk_timer_group_live(struct tk_timer *timer)
+{
+    return timer->group == NULL || timer->group_gen == timer->group->gen;
+}
+
+/**
+ * @brief ¼ʱʱʱĴƽ(ڲ)
+ * 
+ * @param timer ʱ
+ */
+static void _tk_timer_group_join(struct tk_timer *timer)
+{
+    if (timer->group == NULL)
+        return;
+    timer->group_gen = timer->group->gen;
+    timer->group_shift = timer->group->shift;
+}
+#endif /* TK_TIMER_USING_GROUP */
+
+#ifdef TK_TIMER_USING_TRACE
+/**
+ * @brief ȡ׷ʱ䣬δ׷ʱ亯ʱʹtick(ڲ)
+ * 
+ * @return uint32_t ǰ׷ʱ
+ */
+static uint32_t _tk_timer_trace_now(void)
+{
+    if (tk_timer_trace_time != NULL)
+        return tk_timer_trace_time();
+    return tk_timer_get_tick();
+}
+
+/**
+ * @brief ȡ̵߳׷ٻ״εʱȫ(ڲ)
+ * TK_TIMER_USING_TLSʱ̬룬߳˳ͷţԱ֮ȡ
+ * 
+ * @return struct tk_timer_trace_ring* ׷ٻNULLΪʧ
+ */
+static struct tk_timer_trace_ring *_tk_timer_trace_ring(void)
+{
+    struct tk_timer_trace_ring *ring = tk_timer_trace_local;
+    if (ring != NULL)
+        return ring;
+#ifdef TK_TIMER_USING_TLS
+    ring = (struct tk_timer_trace_ring *)calloc(1, sizeof(struct tk_timer_trace_ring));
+    if (ring == NULL)
+        return NULL;
+#else
+    ring = &tk_timer_trace_static_ring;
+#endif /* TK_TIMER_USING_TLS */
+    ring->thread = __atomic_add_fetch(&tk_timer_trace_thread_num, 1, __ATOMIC_RELAXED);
+    ring->next = __atomic_load_n(&tk_timer_trace_rings, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&tk_timer_trace_rings, &ring->next, ring, true,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+    tk_timer_trace_local = ring;
+    return ring;
+}
+
+/**
+ * @brief ֵӦֱͼ±(ڲ)
+ * С8ֵռһ±֮꣬ÿ2ԻΪ8
+ * 
+ * @param value ֵ
+ * @return uint16_t ֱͼ±
+ */
+static uint16_t _tk_timer_trace_hist_index(uint32_t value)
+{
+    uint8_t exp;
+    if (value < (1u << TK_TIMER_TRACE_HIST_SUB_BITS))
+        return (uint16_t)value;
+    exp = 31 - __builtin_clz(value);
+    return (uint16_t)(((exp - TK_TIMER_TRACE_HIST_SUB_BITS + 1) << TK_TIMER_TRACE_HIST_SUB_BITS) +
+                      ((value >> (exp - TK_TIMER_TRACE_HIST_SUB_BITS)) & ((1u << TK_TIMER_TRACE_HIST_SUB_BITS) - 1)));
+}
+
+/**
+ * @brief ȡֱͼ±ӦϽ(ڲ)
+ * 
+ * @param index ֱͼ±
+ * @return uint32_t ڵֵ
+ */
+static uint32_t _tk_timer_trace_hist_value(uint16_t index)
+{
+    uint8_t shift;
+    uint64_t lower;
+    if (index < (1u << TK_TIMER_TRACE_HIST_SUB_BITS))
+        return index;
+    shift = (index >> TK_TIMER_TRACE_HIST_SUB_BITS) - 1;
+    lower = (uint64_t)((1u << TK_TIMER_TRACE_HIST_SUB_BITS) + (index & ((1u << TK_TIMER_TRACE_HIST_SUB_BITS) - 1))) << shift;
+    return (uint32_t)(lower + (1ULL << shift) - 1);
+}
+
+/**
+ * @brief ֱͼֵֻ߳д(ڲ)
+ * 
+ * @param ring ׷ٻ
+ * @param hist ֱͼ
+ * @param value ֵ
+ */
+static void _tk_timer_trace_hist_add(struct tk_timer_trace_ring *ring, tk_timer_trace_hist hist, uint32_t value)
+{
+    uint32_t *count = &ring->hist_count[hist][_tk_timer_trace_hist_index(value)];
+    __atomic_store_n(count, *count + 1, __ATOMIC_RELAXED);
+    if (value > ring->max[hist])
+        __atomic_store_n(&ring->max[hist], value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief ִ״γʱʱжǷ׷٣ÿTK_TIMER_TRACE_SAMPLEгʱĴ׷һ(ڲ)
+ * ׷ʱŶȡtick׷ʱ䣬ûгʱĴ׷ٿ
+ * 
+ * @return true ׷ٱִ
+ * @return false ׷
+ */
+static bool _tk_timer_trace_pass(void)
+{
+    tk_timer_trace_pass_on = tk_timer_trace_enabled &&
+                             (++tk_timer_trace_pass_num & (TK_TIMER_TRACE_SAMPLE - 1)) == 0;
+    if (tk_timer_trace_pass_on)
+    {
+        tk_timer_trace_pass_tick = tk_timer_get_tick();
+        tk_timer_trace_pass_begin = _tk_timer_trace_now();
+        tk_timer_trace_last = tk_timer_trace_pass_begin;
+    }
+    return tk_timer_trace_pass_on;
+}
+
+/**
+ * @brief ȡصʱ䣬ͬʱΪһصĿʼʱ䣬ÿγʱֻȡһʱ(ڲ)
+ * 
+ * @return uint32_t صʱ
+ */
+static uint32_t _tk_timer_trace_end(void)
+{
+    tk_timer_trace_last = _tk_timer_trace_now();
+    return tk_timer_trace_last;
+}
+
+/**
+ * @brief ¼һγʱд뱾̵߳׷ٻֱͼ(ڲ)
+ * 
+ * @param timer ʱĶʱ
+ * @param deadline ʱtick
+ * @param dispatch صʼʱ䣬һصĽʱ䣬γʱ֮ıʱ
+ * @param end صʱ
+ */
+static void _tk_timer_trace_record(struct tk_timer *timer, uint32_t deadline, uint32_t dispatch, uint32_t end)
+{
+    uint32_t duration = end - dispatch;
+    uint32_t tick = tk_timer_trace_pass_tick;
+    uint32_t pass_begin = tk_timer_trace_pass_begin;
+    uint32_t late_tick = tick - deadline;
+    struct tk_timer_trace_ring *ring = _tk_timer_trace_ring();
+    struct tk_timer_trace_record *record;
+    if (ring == NULL)
+        return;
+    record = &ring->records[ring->head & (TK_TIMER_TRACE_SIZE - 1)];
+    /* ʱʱڱ״γʱ֮ */
+    if (late_tick > (UINT32_MAX / 2))
+        late_tick = 0;
+    /* seqдݣдseqȡݴ˶деļ¼ */
+    __atomic_store_n(&record->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    record->thread = ring->thread;
+    record->timer = (uint64_t)(uintptr_t)timer;
+    record->deadline = deadline;
+    record->tick = tick;
+    record->pass_begin = pass_begin;
+    record->dispatch = dispatch;
+    record->duration = duration;
+    record->reserved = 0;
+    __atomic_store_n(&record->seq, ring->head + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+    _tk_timer_trace_hist_add(ring, TK_TIMER_TRACE_LATENESS,
+                             (uint32_t)((uint64_t)late_tick * tk_timer_trace_units / TK_TIMER_TICK_PER_SECOND) +
+                                 (dispatch - pass_begin));
+    _tk_timer_trace_hist_add(ring, TK_TIMER_TRACE_CALLBACK, duration);
+}
 
 /**
- * @brief Ҷʱβڵ(ڲ)
+ * @brief ȡ׷ٻָλõļ¼(ڲ)
  * 
- * @param tk_timer_start_node ʼҵ׽ڵ
- * @return struct tk_timer* βڵַ
+ * @param ring ׷ٻ
+ * @param pos ¼λ
+ * @param record ļ¼
+ * @return true ȡɹ
+ * @return false ¼ѱǻд
  */
-static struct tk_timer *_tk_timer_find_node_tail(struct tk_timer *tk_timer_start_node)
+static bool _tk_timer_trace_load(struct tk_timer_trace_ring *ring, uint32_t pos, struct tk_timer_trace_record *record)
 {
-    TK_ASSERT(tk_timer_start_node);
-    struct tk_timer *node_curr = tk_timer_start_node;
-    struct tk_timer *node_next = tk_timer_start_node;
-    do
+    struct tk_timer_trace_record *slot = &ring->records[pos & (TK_TIMER_TRACE_SIZE - 1)];
+    uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    if (seq != pos + 1)
+        return false;
+    memcpy(record, slot, sizeof(struct tk_timer_trace_record));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq;
+}
+
+/**
+ * @brief ȡ׷ٻЧĵһ¼λ(ڲ)
+ * 
+ * @param ring ׷ٻ
+ * @param head дλ
+ * @return uint32_t һ¼λ
+ */
+static uint32_t _tk_timer_trace_first(struct tk_timer_trace_ring *ring, uint32_t *head)
+{
+    *head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    return (*head < TK_TIMER_TRACE_SIZE) ? 0 : *head - TK_TIMER_TRACE_SIZE;
+}
+#endif /* TK_TIMER_USING_TRACE */
+
+#ifdef TK_TIMER_USING_FD
+/**
+ * @brief 糬ʱʱtimerfdʱδ仯ʱϵͳ(ڲ)
+ */
+static void _tk_timer_fd_arm(void)
+{
+    struct itimerspec its;
+    if (tk_timer_fd < 0 || tk_timer_dispatching == true)
+        return;
+    if (tk_timer_next_valid == tk_timer_armed_valid &&
+        (tk_timer_next_valid == false || tk_timer_next_tick == tk_timer_armed_tick))
+        return;
+    memset(&its, 0, sizeof(its));
+    if (tk_timer_next_valid == true)
     {
-        node_curr = node_next;
-        node_next = node_curr->next;
-    } while (node_next != NULL);
-    return node_curr;
+        uint32_t delta = tk_timer_next_tick - tk_timer_get_tick();
+        if (delta == 0 || delta > (UINT32_MAX / 2))
+        {
+            /* ѳʱ */
+            its.it_value.tv_nsec = 1;
+        }
+        else
+        {
+            uint64_t ns = (uint64_t)delta * 1000000000ULL / TK_TIMER_TICK_PER_SECOND;
+            its.it_value.tv_sec = ns / 1000000000ULL;
+            its.it_value.tv_nsec = ns % 1000000000ULL;
+            if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0)
+                its.it_value.tv_nsec = 1;
+        }
+    }
+    if (timerfd_settime(tk_timer_fd, 0, &its, NULL) == 0)
+    {
+        tk_timer_armed_valid = tk_timer_next_valid;
+        tk_timer_armed_tick = tk_timer_next_tick;
+    }
 }
 
+/**
+ * @brief ɨ糬ʱʱ̲timerfd(ڲ)
+ */
+static void _tk_timer_fd_rescan(void)
+{
+    struct tk_timer *timer = tk_timer_head_node->next;
+    tk_timer_next_valid = false;
+    while (timer != NULL)
+    {
+#ifdef TK_TIMER_USING_GROUP
+        if (timer->group != NULL)
+            _tk_timer_group_sync(timer);
+#endif /* TK_TIMER_USING_GROUP */
+        if (timer->enable)
+            _tk_timer_next_update(timer->timer_tick_timeout);
+        timer = timer->next;
+    }
+    _tk_timer_fd_arm();
+}
+
+/**
+ * @brief ʱֹͣΪ糬ʱĶʱtimerfd(ڲ)
+ * 
+ * @param timer ֹͣĶʱ
+ */
+static void _tk_timer_fd_cancel(struct tk_timer *timer)
+{
+    if (tk_timer_fd < 0 || tk_timer_dispatching == true)
+        return;
+    if (tk_timer_next_valid && timer->timer_tick_timeout == tk_timer_next_tick)
+        _tk_timer_fd_rescan();
+}
+#endif /* TK_TIMER_USING_FD */
+
 /**
  * @brief 붨ʱ(ڲ)
  * 
@@ -68,12 +486,130 @@ static struct tk_timer *_tk_timer_find_node_tail(struct tk_timer *tk_timer_start
 static bool _tk_timer_insert_node_to_list(struct tk_timer *tk_timer_node)
 {
     TK_ASSERT(tk_timer_node);
-    struct tk_timer *node_tail = _tk_timer_find_node_tail(tk_timer_head_node);
+    struct tk_timer *node_tail = tk_timer_tail_node;
     node_tail->next = tk_timer_node;
     tk_timer_node->prev = node_tail;
+    tk_timer_tail_node = tk_timer_node;
+    /* м뵽ĩβĶʱͬᱻ */
+    if (tk_timer_dispatching == true && tk_timer_cursor == NULL)
+        tk_timer_cursor = tk_timer_node;
     return true;
 }
 
+/**
+ * @brief Ƴʱ(ڲ)
+ * 
+ * @param timer ʱ
+ */
+static void _tk_timer_unlink(struct tk_timer *timer)
+{
+    if (tk_timer_cursor == timer)
+        tk_timer_cursor = timer->next;
+    timer->prev->next = timer->next;
+    if (timer->next != NULL)
+        timer->next->prev = timer->prev;
+    else
+        tk_timer_tail_node = timer->prev;
+    timer->prev = NULL;
+    timer->next = NULL;
+}
+
+/**
+ * @brief ж϶ʱǷδɾ(ڲ)
+ * 
+ * @param timer ʱ
+ * @return true δɾ
+ * @return false ɾȴͷ
+ */
+static bool _tk_timer_alive(struct tk_timer *timer)
+{
+    return timer->prev != NULL && __atomic_load_n(&timer->dead, __ATOMIC_ACQUIRE) == false;
+}
+
+#ifdef TK_TIMER_USING_GROUP
+/**
+ * @brief ʱ뿪ʱ飬ɾĶʱһʱ뿪ʱͷ(ڲ)
+ * 
+ * @param timer ʱ
+ */
+static void _tk_timer_group_release(struct tk_timer *timer)
+{
+    struct tk_timer_group *group = timer->group;
+    if (group == NULL)
+        return;
+    timer->group = NULL;
+    group->num--;
+#ifdef TK_TIMER_USING_CREATE
+    if (group->dead && group->num == 0)
+        free(group);
+#endif /* TK_TIMER_USING_CREATE */
+}
+
+#endif /* TK_TIMER_USING_GROUP */
+
+#ifdef TK_TIMER_USING_CREATE
+/**
+ * @brief ѱɾĶʱͷ(ڲ)
+ * 
+ * @param list ͷͷַָ
+ * @param timer ѱɾĶʱ
+ */
+static void _tk_timer_reclaim_push(struct tk_timer **list, struct tk_timer *timer)
+{
+    tk_timer_detach(timer);
+    timer->enable = false;
+    timer->next = *list;
+    *list = timer;
+}
+
+/**
+ * @brief ͷŴͷlimitʱ(ڲ)
+ * 
+ * @param list ͷͷַָ
+ * @param limit ͷŸ
+ */
+static void _tk_timer_reclaim_free(struct tk_timer **list, uint32_t limit)
+{
+    while (*list != NULL && limit-- > 0)
+    {
+        struct tk_timer *timer = *list;
+        *list = timer->next;
+        free(timer);
+    }
+}
+
+/**
+ * @brief ͷŴɾĶʱ(ڲ)
+ * صɾȫͷţɾʱĶʱÿͷTK_TIMER_RECLAIM_BATCH
+ */
+static void _tk_timer_reclaim(void)
+{
+    _tk_timer_reclaim_free(&tk_timer_reclaim_list, UINT32_MAX);
+    _tk_timer_reclaim_free(&tk_timer_reclaim_group_list, TK_TIMER_RECLAIM_BATCH);
+    /* ʣһtick */
+    if (tk_timer_reclaim_group_list != NULL)
+        _tk_timer_next_update(tk_timer_get_tick() + 1);
+}
+
+#ifdef TK_TIMER_USING_TLS
+/**
+ * @brief ͷ߳ɾĶʱ(ڲ)
+ * ֻڴʼǰãʱ̲߳ٳһֵκζʱָ룬൱ڿѹ
+ */
+static void _tk_timer_remote_reclaim(void)
+{
+    struct tk_timer *timer = __atomic_exchange_n(&tk_timer_remote_list, NULL, __ATOMIC_ACQUIRE);
+    while (timer != NULL)
+    {
+        struct tk_timer *next = timer->remote_next;
+        tk_timer_detach(timer);
+        free(timer);
+        timer = next;
+    }
+}
+#endif /* TK_TIMER_USING_TLS */
+#endif /* TK_TIMER_USING_CREATE */
+
 /**
  * @brief ʱܳʼ
  * 
@@ -95,7 +631,46 @@ bool tk_timer_func_init(uint32_t (*get_tick_func)(void))
 #endif /* TK_TIMER_USING_CREATE */
     tk_timer_head_node->prev = NULL;
     tk_timer_head_node->next = NULL;
+    tk_timer_tail_node = tk_timer_head_node;
     tk_timer_get_tick = get_tick_func;
+    tk_timer_next_valid = false;
+    return true;
+}
+
+/**
+ * @brief ʱܷʼͷű̵߳Ķʱͷ
+ * TK_TIMER_USING_TLSʱ߳˳ǰɸ̵߳ãеĶʱ뵫ͷţ
+ * ɾͷŵĶʱȫͷţ֮µtk_timer_func_initʹöʱ
+ * 
+ * @return true ʼɹ
+ * @return false ʼʧܣδʼе
+ */
+bool tk_timer_func_deinit(void)
+{
+    if (tk_timer_head_node == NULL || tk_timer_dispatching == true)
+        return false;
+#ifdef TK_TIMER_USING_CREATE
+#ifdef TK_TIMER_USING_TLS
+    _tk_timer_remote_reclaim();
+#endif /* TK_TIMER_USING_TLS */
+    _tk_timer_reclaim_free(&tk_timer_reclaim_list, UINT32_MAX);
+    _tk_timer_reclaim_free(&tk_timer_reclaim_group_list, UINT32_MAX);
+#endif /* TK_TIMER_USING_CREATE */
+    while (tk_timer_head_node->next != NULL)
+    {
+        tk_timer_head_node->next->enable = false;
+        tk_timer_detach(tk_timer_head_node->next);
+    }
+#ifdef TK_TIMER_USING_FD
+    tk_timer_release_fd();
+#endif /* TK_TIMER_USING_FD */
+#ifdef TK_TIMER_USING_CREATE
+    free(tk_timer_head_node);
+#endif /* TK_TIMER_USING_CREATE */
+    tk_timer_head_node = NULL;
+    tk_timer_tail_node = NULL;
+    tk_timer_get_tick = NULL;
+    tk_timer_next_valid = false;
     return true;
 }
 
@@ -115,6 +690,7 @@ bool tk_timer_init(struct tk_timer *timer, void (*timeout_callback)(struct tk_ti
     if (tk_timer_head_node == NULL || tk_timer_get_tick == NULL)
         return false;
     timer->enable = false;
+    timer->dead = false;
     timer->mode = TIMER_MODE_LOOP;
     timer->state = TIMER_STATE_STOP;
     timer->delay_tick = 0;
@@ -124,24 +700,52 @@ bool tk_timer_init(struct tk_timer *timer, void (*timeout_callback)(struct tk_ti
 #ifdef TK_TIMER_USING_TIMEOUT_CALLBACK
     timer->timeout_callback = timeout_callback;
 #endif /* TK_TIMER_USING_TIMEOUT_CALLBACK */
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+    timer->batch_callback = NULL;
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+#ifdef TK_TIMER_USING_GROUP
+    timer->group = NULL;
+    timer->group_gen = 0;
+    timer->group_shift = 0;
+#endif /* TK_TIMER_USING_GROUP */
+#ifdef TK_TIMER_USING_CREATE
+    timer->created = false;
+#endif /* TK_TIMER_USING_CREATE */
+#if defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS)
+    timer->owner = &tk_timer_remote_list;
+    timer->remote_next = NULL;
+#endif /* defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS) */
+#ifdef TOOLKIT_USING_STATS
+    memset(&timer->stats, 0, sizeof(timer->stats));
+    timer->stats_entry.object = NULL;
+#endif /* TOOLKIT_USING_STATS */
     bool result = _tk_timer_insert_node_to_list(timer);
     return result;
 }
 
 /**
- * @brief ̬붨ʱ
+ * @brief ̬붨ʱڳʱصⶨʱ()
  * 
  * @param timer ҪĶʱ
  * @return true ɹ
- * @return false ʧ
+ * @return false ʧܣ
  */
 bool tk_timer_detach(struct tk_timer *timer)
 {
     TK_ASSERT(tk_timer_head_node);
     TK_ASSERT(timer);
-    timer->prev->next = timer->next;
-    if (timer->next != NULL)
-        timer->next->prev = timer->prev;
+    if (timer == NULL || timer->prev == NULL)
+        return false;
+    _tk_timer_unlink(timer);
+#ifdef TK_TIMER_USING_GROUP
+    _tk_timer_group_release(timer);
+#endif /* TK_TIMER_USING_GROUP */
+#ifdef TOOLKIT_USING_STATS
+    tk_stats_unregister(&timer->stats_entry);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_TIMER_USING_FD
+    _tk_timer_fd_cancel(timer);
+#endif /* TK_TIMER_USING_FD */
     return true;
 }
 
@@ -162,6 +766,7 @@ struct tk_timer *tk_timer_create(void (*timeout_callback)(struct tk_timer *timer
     if ((timer = malloc(sizeof(struct tk_timer))) == NULL)
         return NULL;
     timer->enable = false;
+    timer->dead = false;
     timer->mode = TIMER_MODE_LOOP;
     timer->state = TIMER_STATE_STOP;
     timer->delay_tick = 0;
@@ -171,26 +776,63 @@ struct tk_timer *tk_timer_create(void (*timeout_callback)(struct tk_timer *timer
 #ifdef TK_TIMER_USING_TIMEOUT_CALLBACK
     timer->timeout_callback = timeout_callback;
 #endif /* TK_TIMER_USING_TIMEOUT_CALLBACK */
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+    timer->batch_callback = NULL;
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+#ifdef TK_TIMER_USING_GROUP
+    timer->group = NULL;
+    timer->group_gen = 0;
+    timer->group_shift = 0;
+#endif /* TK_TIMER_USING_GROUP */
+    timer->created = true;
+#if defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS)
+    timer->owner = &tk_timer_remote_list;
+    timer->remote_next = NULL;
+#endif /* defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS) */
+#ifdef TOOLKIT_USING_STATS
+    memset(&timer->stats, 0, sizeof(timer->stats));
+    timer->stats_entry.object = NULL;
+#endif /* TOOLKIT_USING_STATS */
     _tk_timer_insert_node_to_list(timer);
     return timer;
 }
 
 /**
- * @brief ̬ɾʱ
+ * @brief ̬ɾʱO(1)
+ * (ʱص)ɾʱƳִͷţɾⶨʱ()
+ * TK_TIMER_USING_TLSʱ߳ɾֻɾ߳һִʼʱͷţ
+ * ̴߳ʱִиöʱĻصصǰͷ
  * 
  * @param timer ҪɾĶʱ
  * @return true ɾɹ
- * @return false ɾʧ
+ * @return false ɾʧܣɾ
  */
 bool tk_timer_delete(struct tk_timer *timer)
 {
     TK_ASSERT(timer);
-    if (tk_timer_detach(timer) == true)
+    if (timer == NULL || __atomic_exchange_n(&timer->dead, true, __ATOMIC_ACQ_REL) == true)
+        return false;
+#ifdef TK_TIMER_USING_TLS
+    if (timer->owner != &tk_timer_remote_list)
     {
-        free(timer);
+        /* ޸enable߳һִʼʱͷţٳʱ */
+        struct tk_timer *head = __atomic_load_n(timer->owner, __ATOMIC_RELAXED);
+        do
+        {
+            timer->remote_next = head;
+        } while (__atomic_compare_exchange_n(timer->owner, &head, timer, true,
+                                             __ATOMIC_RELEASE, __ATOMIC_RELAXED) == false);
         return true;
     }
-    return false;
+#endif /* TK_TIMER_USING_TLS */
+    if (tk_timer_dispatching == true)
+    {
+        _tk_timer_reclaim_push(&tk_timer_reclaim_list, timer);
+        return true;
+    }
+    tk_timer_detach(timer);
+    free(timer);
+    return true;
 }
 #endif /* TK_TIMER_USING_CREATE */
 
@@ -209,6 +851,13 @@ static bool _tk_timer_set_start_param(struct tk_timer *timer)
     timer->timer_tick_timeout = tk_timer_get_tick() + timer->delay_tick;
     timer->enable = true;
     timer->state = TIMER_STATE_RUNNING;
+#ifdef TK_TIMER_USING_GROUP
+    _tk_timer_group_join(timer);
+#endif /* TK_TIMER_USING_GROUP */
+    _tk_timer_next_update(timer->timer_tick_timeout);
+#ifdef TK_TIMER_USING_FD
+    _tk_timer_fd_arm();
+#endif /* TK_TIMER_USING_FD */
     return true;
 }
 
@@ -243,6 +892,9 @@ bool tk_timer_stop(struct tk_timer *timer)
     TK_ASSERT(timer);
     timer->enable = false;
     timer->state = TIMER_STATE_STOP;
+#ifdef TK_TIMER_USING_FD
+    _tk_timer_fd_cancel(timer);
+#endif /* TK_TIMER_USING_FD */
     return true;
 }
 
@@ -256,8 +908,18 @@ bool tk_timer_stop(struct tk_timer *timer)
 bool tk_timer_continue(struct tk_timer *timer)
 {
     TK_ASSERT(timer);
+#ifdef TK_TIMER_USING_GROUP
+    /* Ȳֹͣڼƽƣټ뵱ǰ */
+    if (timer->group != NULL)
+        _tk_timer_group_sync(timer);
+    _tk_timer_group_join(timer);
+#endif /* TK_TIMER_USING_GROUP */
     timer->enable = true;
     timer->state = TIMER_STATE_RUNNING;
+    _tk_timer_next_update(timer->timer_tick_timeout);
+#ifdef TK_TIMER_USING_FD
+    _tk_timer_fd_arm();
+#endif /* TK_TIMER_USING_FD */
     return true;
 }
 
@@ -297,9 +959,285 @@ tk_timer_mode tk_timer_get_mode(struct tk_timer *timer)
 tk_timer_state tk_timer_get_state(struct tk_timer *timer)
 {
     TK_ASSERT(timer);
+#ifdef TK_TIMER_USING_GROUP
+    /* ʱֹͣĶʱһִǰΪRUNNING */
+    if (timer->state == TIMER_STATE_RUNNING && _tk_timer_group_live(timer) == false)
+        return TIMER_STATE_STOP;
+#endif /* TK_TIMER_USING_GROUP */
     return timer->state;
 }
 
+#ifdef TK_TIMER_USING_GROUP
+/**
+ * @brief ̬ʼʱ
+ * 
+ * @param group ҪʼĶʱ
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_timer_group_init(struct tk_timer_group *group)
+{
+    TK_ASSERT(group);
+    if (group == NULL)
+        return false;
+    group->gen = 0;
+    group->shift = 0;
+    group->num = 0;
+    group->dead = false;
+    return true;
+}
+
+/**
+ * @brief ̬붨ʱ飬޶ʱ
+ * 
+ * @param group ҪĶʱ
+ * @return true ɹ
+ * @return false ʧܣжʱ
+ */
+bool tk_timer_group_detach(struct tk_timer_group *group)
+{
+    TK_ASSERT(group);
+    if (group == NULL || group->num != 0)
+        return false;
+    group->dead = true;
+    return true;
+}
+
+#ifdef TK_TIMER_USING_CREATE
+/**
+ * @brief ̬ʱ
+ * 
+ * @return struct tk_timer_group* ĶʱNULLΪʧ
+ */
+struct tk_timer_group *tk_timer_group_create(void)
+{
+    struct tk_timer_group *group;
+    if ((group = malloc(sizeof(struct tk_timer_group))) == NULL)
+        return NULL;
+    tk_timer_group_init(group);
+    return group;
+}
+
+/**
+ * @brief ̬ɾʱ鼰ȫʱO(1)
+ * ڶʱֹͣһtk_timer_loop_handlerƳÿͷTK_TIMER_RECLAIM_BATCH
+ * ȫͷźʱһͷštk_timer_createڶʱɾ󲻿ٷʣ
+ * tk_timer_init̬ʼڶʱֻ벻ͷţ֮³ʼʹ
+ * 
+ * @param group ҪɾĶʱ
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_timer_group_delete(struct tk_timer_group *group)
+{
+    TK_ASSERT(group);
+    if (group == NULL || group->dead)
+        return false;
+    if (group->num == 0)
+    {
+        free(group);
+        return true;
+    }
+    group->gen++;
+    group->dead = true;
+    /* 찲һִͷڶʱ */
+    if (tk_timer_get_tick != NULL)
+        _tk_timer_next_update(tk_timer_get_tick());
+#ifdef TK_TIMER_USING_FD
+    _tk_timer_fd_arm();
+#endif /* TK_TIMER_USING_FD */
+    return true;
+}
+#endif /* TK_TIMER_USING_CREATE */
+
+/**
+ * @brief ʱ붨ʱ飬ʱƳ״ֲ̬
+ * 
+ * @param group ʱ
+ * @param timer ʱ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_group_add(struct tk_timer_group *group, struct tk_timer *timer)
+{
+    TK_ASSERT(group);
+    TK_ASSERT(timer);
+    if (group == NULL || timer == NULL || group->dead)
+        return false;
+    if (timer->group == group)
+        return true;
+    if (timer->group != NULL && tk_timer_group_remove(timer) == false)
+        return false;
+    timer->group = group;
+    timer->group_gen = group->gen;
+    timer->group_shift = group->shift;
+    group->num++;
+    return true;
+}
+
+/**
+ * @brief ʱƳʱ飬ƳǰֹͣƽȻЧ
+ * 
+ * @param timer ʱ
+ * @return true Ƴɹ
+ * @return false Ƴʧܣκɾ
+ */
+bool tk_timer_group_remove(struct tk_timer *timer)
+{
+    TK_ASSERT(timer);
+    if (timer == NULL || timer->group == NULL || timer->group->dead)
+        return false;
+    _tk_timer_group_sync(timer);
+    timer->group->num--;
+    timer->group = NULL;
+    return true;
+}
+
+/**
+ * @brief ֹͣʱȫʱO(1)
+ * ڶʱһִʱΪֹͣtk_timer_get_stateTIMER_STATE_STOP
+ * 
+ * @param group ʱ
+ * @return true ֹͣɹ
+ * @return false ֹͣʧ
+ */
+bool tk_timer_group_stop(struct tk_timer_group *group)
+{
+    TK_ASSERT(group);
+    if (group == NULL || group->dead)
+        return false;
+    group->gen++;
+    return true;
+}
+
+/**
+ * @brief ƽƶʱȫʱĳʱʱ̣O(1)ֹͣĶʱ
+ * 
+ * @param group ʱ
+ * @param delta_tick ƽ(λtick)Ƴ٣ǰ
+ * @return true ƽƳɹ
+ * @return false ƽʧ
+ */
+bool tk_timer_group_shift(struct tk_timer_group *group, int32_t delta_tick)
+{
+    TK_ASSERT(group);
+    if (group == NULL || group->dead)
+        return false;
+    group->shift += (uint32_t)delta_tick;
+    /* Ƴٲʹ糬ʱʱ̱ͳʧЧǰʱڵǰtickͳ */
+    if (delta_tick < 0 && tk_timer_get_tick != NULL)
+    {
+        _tk_timer_next_update(tk_timer_get_tick());
+#ifdef TK_TIMER_USING_FD
+        _tk_timer_fd_arm();
+#endif /* TK_TIMER_USING_FD */
+    }
+    return true;
+}
+#endif /* TK_TIMER_USING_GROUP */
+
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+/**
+ * @brief صձʱ(ڲ)
+ * ص״γֵ˳飬ڱ˳ÿһλص
+ */
+static void _tk_timer_batch_flush(void)
+{
+    uint32_t num = tk_timer_batch_num;
+#ifdef TK_TIMER_USING_TRACE
+    /* ռʱѾǷ׷ */
+    bool trace = tk_timer_trace_pass_on;
+#endif /* TK_TIMER_USING_TRACE */
+    tk_timer_batch_num = 0;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        tk_timer_batch_callback callback = tk_timer_batch_entries[i].callback;
+        uint32_t count = 0;
+        if (callback == NULL)
+            continue;
+        for (uint32_t j = i; j < num; j++)
+        {
+            if (tk_timer_batch_entries[j].callback != callback)
+                continue;
+            tk_timer_batch_entries[j].callback = NULL;
+            /* ռɾĶʱٻص */
+            if (_tk_timer_alive(tk_timer_batch_entries[j].timer) == false)
+                continue;
+#ifdef TK_TIMER_USING_GROUP
+            /* ռʱ鱻ֹͣɾĶʱͬٻصδʱڶʱһ */
+            if (_tk_timer_group_live(tk_timer_batch_entries[j].timer) == false)
+            {
+                tk_timer_batch_entries[j].timer->enable = false;
+                tk_timer_batch_entries[j].timer->state = TIMER_STATE_STOP;
+                continue;
+            }
+#endif /* TK_TIMER_USING_GROUP */
+#ifdef TK_TIMER_USING_TRACE
+            tk_timer_batch_deadlines[count] = tk_timer_batch_entries[j].deadline;
+#endif /* TK_TIMER_USING_TRACE */
+            tk_timer_batch_timers[count++] = tk_timer_batch_entries[j].timer;
+        }
+        if (count == 0)
+            continue;
+#ifdef TK_TIMER_USING_TRACE
+        uint32_t trace_dispatch = trace ? tk_timer_trace_last : 0;
+#endif /* TK_TIMER_USING_TRACE */
+#ifdef TOOLKIT_USING_STATS
+        uint32_t begin = tk_stats_get_time();
+        callback(tk_timer_batch_timers, count);
+        uint32_t cost = (tk_stats_get_time() - begin) / count;
+        for (uint32_t k = 0; k < count; k++)
+        {
+            TK_STATS_ADD(tk_timer_batch_timers[k]->stats.callback_total, cost);
+            TK_STATS_MAX(tk_timer_batch_timers[k]->stats.callback_max, cost);
+        }
+#else
+        callback(tk_timer_batch_timers, count);
+#endif /* TOOLKIT_USING_STATS */
+#ifdef TK_TIMER_USING_TRACE
+        /* صʱΪʱ */
+        if (trace)
+        {
+            uint32_t trace_end = _tk_timer_trace_end();
+            for (uint32_t k = 0; k < count; k++)
+                _tk_timer_trace_record(tk_timer_batch_timers[k], tk_timer_batch_deadlines[k], trace_dispatch, trace_end);
+        }
+#endif /* TK_TIMER_USING_TRACE */
+#ifdef TK_TIMER_USING_INTERVAL
+        /* صֹͣĶʱ */
+        for (uint32_t k = 0; k < count; k++)
+        {
+            struct tk_timer *timer = tk_timer_batch_timers[k];
+#ifdef TK_TIMER_USING_GROUP
+            if (_tk_timer_group_live(timer) == false)
+                continue;
+#endif /* TK_TIMER_USING_GROUP */
+            if (_tk_timer_alive(timer) && timer->mode == TIMER_MODE_LOOP && timer->state == TIMER_STATE_TIMEOUT)
+                tk_timer_restart(timer);
+        }
+#endif /* TK_TIMER_USING_INTERVAL */
+    }
+}
+
+/**
+ * @brief صúʱʱٵtimeout_callback
+ * ڱֱ(ռTK_TIMER_BATCH_SIZE)ʹͬһصĶʱһص
+ * 
+ * @param timer ʱ
+ * @param batch_callback صNULLΪָʹtimeout_callback
+ * @return true óɹ
+ * @return false ʧ
+ */
+bool tk_timer_set_batch_callback(struct tk_timer *timer, tk_timer_batch_callback batch_callback)
+{
+    TK_ASSERT(timer);
+    if (timer == NULL)
+        return false;
+    timer->batch_callback = batch_callback;
+    return true;
+}
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+
 /**
  * @brief ʱ
  * 
@@ -310,34 +1248,484 @@ bool tk_timer_loop_handler(void)
 {
     struct tk_timer *timer = NULL;
 
+#if defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS)
+    _tk_timer_remote_reclaim();
+#endif /* defined(TK_TIMER_USING_CREATE) && defined(TK_TIMER_USING_TLS) */
     if (tk_timer_head_node != NULL)
         timer = tk_timer_head_node->next;
     else
         return false;
 
+#ifdef TK_TIMER_USING_TRACE
+    int8_t trace_pass = -1; /* ״γʱʱǷ׷ */
+#endif /* TK_TIMER_USING_TRACE */
+
+    /* ͳ糬ʱʱ̣صĶʱͬᱻͳ */
+    tk_timer_next_valid = false;
+    tk_timer_dispatching = true;
+#ifdef TK_TIMER_USING_SIM
+    uint32_t sim_index = 0;
+#endif /* TK_TIMER_USING_SIM */
     while (timer != NULL)
     {
-        if (timer->enable && (tk_timer_get_tick() - timer->timer_tick_timeout) < (UINT32_MAX / 2))
+        tk_timer_cursor = timer->next;
+#ifdef TK_TIMER_USING_GROUP
+        if (timer->group != NULL && _tk_timer_group_sync(timer))
         {
+            /* ʱɾƳֽͷţһͷŹ */
+#ifdef TK_TIMER_USING_CREATE
+            if (timer->created == false)
+            {
+                /* ̬ʼĶʱǶ̬ģֻ벻ͷ */
+                timer->enable = false;
+                tk_timer_detach(timer);
+            }
+            else if (__atomic_exchange_n(&timer->dead, true, __ATOMIC_ACQ_REL) == false)
+                _tk_timer_reclaim_push(&tk_timer_reclaim_group_list, timer);
+#endif /* TK_TIMER_USING_CREATE */
+            timer = tk_timer_cursor;
+#ifdef TK_TIMER_USING_SIM
+            sim_index++;
+#endif /* TK_TIMER_USING_SIM */
+            continue;
+        }
+#endif /* TK_TIMER_USING_GROUP */
+        /* ߳ɾĶʱУһִʼʱͷţٳʱ */
+        bool dead = __atomic_load_n(&timer->dead, __ATOMIC_ACQUIRE);
+        if (dead == false && timer->enable &&
+            (tk_timer_get_tick() - timer->timer_tick_timeout) < (UINT32_MAX / 2))
+        {
+#ifdef TK_TIMER_USING_SIM
+            tk_timer_sim_expire(timer, NULL, sim_index, timer->timer_tick_timeout);
+#endif /* TK_TIMER_USING_SIM */
+#ifdef TK_TIMER_USING_TRACE
+            if (trace_pass < 0)
+                trace_pass = _tk_timer_trace_pass();
+            bool trace = trace_pass > 0;
+            uint32_t trace_deadline = timer->timer_tick_timeout;
+            uint32_t trace_dispatch = trace ? tk_timer_trace_last : 0;
+#endif /* TK_TIMER_USING_TRACE */
+#ifdef TOOLKIT_USING_STATS
+            uint32_t late = tk_timer_get_tick() - timer->timer_tick_timeout;
+            TK_STATS_ADD(timer->stats.fire, 1);
+            TK_STATS_ADD(timer->stats.late_hist[tk_stats_hist_index(late)], 1);
+            TK_STATS_MAX(timer->stats.late_max, late);
+#endif /* TOOLKIT_USING_STATS */
             timer->enable = false;
             timer->state = TIMER_STATE_TIMEOUT;
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+            bool batched = timer->batch_callback != NULL;
+            if (batched)
+            {
+                tk_timer_batch_entries[tk_timer_batch_num].callback = timer->batch_callback;
+                tk_timer_batch_entries[tk_timer_batch_num].timer = timer;
+                tk_timer_batch_entries[tk_timer_batch_num].deadline = timer->timer_tick_timeout;
+                tk_timer_batch_num++;
+            }
+#else
+            const bool batched = false;
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+            (void)batched;
 #ifndef TK_TIMER_USING_INTERVAL
-            if (timer->mode == TIMER_MODE_LOOP)
+            if (timer->mode == TIMER_MODE_LOOP && _tk_timer_alive(timer))
                 tk_timer_restart(timer);
 #endif /* TK_TIMER_USING_INTERVAL */
 #ifdef TK_TIMER_USING_TIMEOUT_CALLBACK
-            if (timer->timeout_callback != NULL)
+            if (batched == false && timer->timeout_callback != NULL)
+            {
+#ifdef TOOLKIT_USING_STATS
+                uint32_t begin = tk_stats_get_time();
+                timer->timeout_callback(timer);
+                uint32_t cost = tk_stats_get_time() - begin;
+                TK_STATS_ADD(timer->stats.callback_total, cost);
+                TK_STATS_MAX(timer->stats.callback_max, cost);
+#else
                 timer->timeout_callback(timer);
+#endif /* TOOLKIT_USING_STATS */
+            }
 #endif /* TK_TIMER_USING_TIMEOUT_CALLBACK */
+#ifdef TK_TIMER_USING_TRACE
+            if (trace && batched == false)
+                _tk_timer_trace_record(timer, trace_deadline, trace_dispatch, _tk_timer_trace_end());
+#endif /* TK_TIMER_USING_TRACE */
 #ifdef TK_TIMER_USING_INTERVAL
-            if (timer->mode == TIMER_MODE_LOOP)
+#ifdef TK_TIMER_USING_GROUP
+            /* ص롢ɾ˶ʱֹͣɾʱʱ */
+            if (batched == false && timer->mode == TIMER_MODE_LOOP && _tk_timer_alive(timer) &&
+                _tk_timer_group_live(timer))
+#else
+            /* صɾ˶ʱʱ */
+            if (batched == false && timer->mode == TIMER_MODE_LOOP && _tk_timer_alive(timer))
+#endif /* TK_TIMER_USING_GROUP */
                 tk_timer_restart(timer);
 #endif /* TK_TIMER_USING_INTERVAL */
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+            if (tk_timer_batch_num == TK_TIMER_BATCH_SIZE)
+                _tk_timer_batch_flush();
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+        }
+        else if (dead == false && timer->enable)
+        {
+            _tk_timer_next_update(timer->timer_tick_timeout);
+        }
+        timer = tk_timer_cursor;
+#ifdef TK_TIMER_USING_SIM
+        sim_index++;
+#endif /* TK_TIMER_USING_SIM */
+    }
+#ifdef TK_TIMER_USING_BATCH_CALLBACK
+    if (tk_timer_batch_num > 0)
+        _tk_timer_batch_flush();
+#endif /* TK_TIMER_USING_BATCH_CALLBACK */
+    tk_timer_cursor = NULL;
+#ifdef TK_TIMER_USING_CREATE
+    _tk_timer_reclaim();
+#endif /* TK_TIMER_USING_CREATE */
+    tk_timer_dispatching = false;
+#ifdef TK_TIMER_USING_FD
+    _tk_timer_fd_arm();
+#endif /* TK_TIMER_USING_FD */
+
+    return true;
+}
+
+/**
+ * @brief ȡ糬ʱʱ
+ * ֹͣĶʱͳƳ˻ȡֵֻڻʵ糬ʱʱ
+ * 
+ * @param tick 糬ʱʱ
+ * @return true ȡɹ
+ * @return false еĶʱ
+ */
+bool tk_timer_get_next_tick(uint32_t *tick)
+{
+    TK_ASSERT(tick);
+    if (tk_timer_next_valid == false)
+        return false;
+    *tick = tk_timer_next_tick;
+    return true;
+}
+
+/**
+ * @brief ȡǰticktk_timer_func_initõtickȡһ
+ * 
+ * @return uint32_t ǰtickδʼʱΪ0
+ */
+uint32_t tk_timer_get_curr_tick(void)
+{
+    TK_ASSERT(tk_timer_get_tick);
+    if (tk_timer_get_tick == NULL)
+        return 0;
+    return tk_timer_get_tick();
+}
+
+#ifdef TK_TIMER_USING_SIM
+/**
+ * @brief tickȡʱֲ䣬ʱʹ(ڲ)
+ * 
+ * @param get_tick_func µtickȡԭtickȡ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_sim_swap_tick(uint32_t (**get_tick_func)(void))
+{
+    TK_ASSERT(get_tick_func);
+    tk_timer_get_tick_callback old;
+    if (get_tick_func == NULL)
+        return false;
+    old = tk_timer_get_tick;
+    tk_timer_get_tick = *get_tick_func;
+    *get_tick_func = old;
+    return true;
+}
+#endif /* TK_TIMER_USING_SIM */
+
+#ifdef TK_TIMER_USING_TRACE
+/**
+ * @brief ׷ʱȡӦtickִӳصʱ
+ * 
+ * @param time_func ׷ʱȡNULLΪʹtick
+ * @param units_per_second ׷ʱÿĵλ΢Ϊ1000000
+ */
+void tk_timer_trace_set_time_func(uint32_t (*time_func)(void), uint32_t units_per_second)
+{
+    tk_timer_trace_time = time_func;
+    tk_timer_trace_units = (time_func != NULL && units_per_second != 0) ? units_per_second : TK_TIMER_TICK_PER_SECOND;
+}
+
+/**
+ * @brief 򿪻ر׷٣Ĭϴ
+ * 
+ * @param enable true; falseر
+ */
+void tk_timer_trace_enable(bool enable)
+{
+    tk_timer_trace_enabled = enable;
+}
+
+/**
+ * @brief ̵߳׷ټ¼ֱͼӦûжʱʱ
+ * 
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_trace_reset(void)
+{
+    struct tk_timer_trace_ring *ring = __atomic_load_n(&tk_timer_trace_rings, __ATOMIC_ACQUIRE);
+    for (; ring != NULL; ring = ring->next)
+    {
+        for (uint32_t i = 0; i < TK_TIMER_TRACE_SIZE; i++)
+            ring->records[i].seq = 0;
+        memset(ring->hist_count, 0, sizeof(ring->hist_count));
+        memset(ring->max, 0, sizeof(ring->max));
+        __atomic_store_n(&ring->head, 0, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+/**
+ * @brief ȡ׷ټ¼߳е
+ * ̷߳飬ͬһ̵߳ļ¼ʱȺ
+ * 
+ * @param records ¼
+ * @param num ɵļ¼
+ * @return uint32_t ʵʶȡļ¼
+ */
+uint32_t tk_timer_trace_read(struct tk_timer_trace_record *records, uint32_t num)
+{
+    TK_ASSERT(records);
+    struct tk_timer_trace_ring *ring = __atomic_load_n(&tk_timer_trace_rings, __ATOMIC_ACQUIRE);
+    uint32_t count = 0;
+    uint32_t head;
+    if (records == NULL)
+        return 0;
+    for (; ring != NULL && count < num; ring = ring->next)
+    {
+        for (uint32_t pos = _tk_timer_trace_first(ring, &head); pos != head && count < num; pos++)
+        {
+            if (_tk_timer_trace_load(ring, pos, &records[count]))
+                count++;
         }
-        timer = timer->next;
     }
+    return count;
+}
 
+/**
+ * @brief ȡֱ̻߳ܺͼİٷλ
+ * 
+ * @param hist ֱͼ: ʱӳTK_TIMER_TRACE_LATENESS; صʱTK_TIMER_TRACE_CALLBACK
+ * @param permille ǧλ990Ϊp99999Ϊp99.9
+ * @return uint32_t ٷλ(λΪ׷ʱ)12.5%޼¼ʱΪ0
+ */
+uint32_t tk_timer_trace_percentile(tk_timer_trace_hist hist, uint16_t permille)
+{
+    struct tk_timer_trace_ring *rings = __atomic_load_n(&tk_timer_trace_rings, __ATOMIC_ACQUIRE);
+    struct tk_timer_trace_ring *ring;
+    uint64_t total = 0;
+    uint64_t target, sum = 0;
+    uint32_t max = 0;
+    for (ring = rings; ring != NULL; ring = ring->next)
+    {
+        uint32_t value = __atomic_load_n(&ring->max[hist], __ATOMIC_RELAXED);
+        if (value > max)
+            max = value;
+        for (uint16_t i = 0; i < TK_TIMER_TRACE_HIST_SIZE; i++)
+            total += __atomic_load_n(&ring->hist_count[hist][i], __ATOMIC_RELAXED);
+    }
+    if (total == 0)
+        return 0;
+    target = (total * permille + 999) / 1000;
+    if (target == 0)
+        target = 1;
+    for (uint16_t i = 0; i < TK_TIMER_TRACE_HIST_SIZE; i++)
+    {
+        for (ring = rings; ring != NULL; ring = ring->next)
+            sum += __atomic_load_n(&ring->hist_count[hist][i], __ATOMIC_RELAXED);
+        if (sum >= target)
+        {
+            uint32_t value = _tk_timer_trace_hist_value(i);
+            return (value < max) ? value : max;
+        }
+    }
+    return max;
+}
+
+/**
+ * @brief ıʽ׷ֱͼժҪλΪ΢
+ * 
+ * @param fp ļstdout
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_trace_summary(FILE *fp)
+{
+    static const char *names[2] = {"lateness", "callback"};
+    static const uint16_t permilles[4] = {500, 900, 990, 999};
+    struct tk_timer_trace_ring *ring = __atomic_load_n(&tk_timer_trace_rings, __ATOMIC_ACQUIRE);
+    uint64_t total = 0;
+    TK_ASSERT(fp);
+    if (fp == NULL)
+        return false;
+    for (; ring != NULL; ring = ring->next)
+        total += __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    fprintf(fp, "timer trace expiries=%llu unit=%uHz\n", (unsigned long long)total, tk_timer_trace_units);
+    for (uint8_t h = 0; h < 2; h++)
+    {
+        fprintf(fp, "%s", names[h]);
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            uint32_t value = tk_timer_trace_percentile((tk_timer_trace_hist)h, permilles[i]);
+            fprintf(fp, " p%g=%lluus", permilles[i] / 10.0,
+                    (unsigned long long)value * 1000000ULL / tk_timer_trace_units);
+        }
+        fprintf(fp, " max=%lluus\n",
+                (unsigned long long)tk_timer_trace_percentile((tk_timer_trace_hist)h, 1000) * 1000000ULL /
+                    tk_timer_trace_units);
+    }
+    return true;
+}
+
+/**
+ * @brief ԶƸʽ̵߳׷ټ¼tools/tk_trace2jsonתΪChrome trace JSON
+ * 
+ * @param fp ļԶƷʽ
+ * @return true ɹ
+ * @return false дʧ
+ */
+bool tk_timer_trace_dump(FILE *fp)
+{
+    struct tk_timer_trace_header header;
+    struct tk_timer_trace_record record;
+    struct tk_timer_trace_ring *rings = __atomic_load_n(&tk_timer_trace_rings, __ATOMIC_ACQUIRE);
+    struct tk_timer_trace_ring *ring;
+    uint32_t head;
+    long begin;
+    TK_ASSERT(fp);
+    if (fp == NULL)
+        return false;
+    begin = ftell(fp);
+    header.magic = TK_TIMER_TRACE_MAGIC;
+    header.version = TK_TIMER_TRACE_VERSION;
+    header.record_size = sizeof(struct tk_timer_trace_record);
+    header.count = 0;
+    header.total = 0;
+    header.units_per_second = tk_timer_trace_units;
+    header.tick_per_second = TK_TIMER_TICK_PER_SECOND;
+    if (fwrite(&header, sizeof(header), 1, fp) != 1)
+        return false;
+    for (ring = rings; ring != NULL; ring = ring->next)
+    {
+        for (uint32_t pos = _tk_timer_trace_first(ring, &head); pos != head; pos++)
+        {
+            if (_tk_timer_trace_load(ring, pos, &record) == false)
+                continue;
+            if (fwrite(&record, sizeof(record), 1, fp) != 1)
+                return false;
+            header.count++;
+        }
+        header.total += head;
+    }
+    /* дʵʼ¼ */
+    if (begin >= 0 && fseek(fp, begin, SEEK_SET) == 0)
+    {
+        if (fwrite(&header, sizeof(header), 1, fp) != 1)
+            return false;
+        fseek(fp, 0, SEEK_END);
+    }
+    return true;
+}
+#endif /* TK_TIMER_USING_TRACE */
+
+#ifdef TK_TIMER_USING_FD
+/**
+ * @brief CLOCK_MONOTONICtickȡֱӴtk_timer_func_init
+ * 
+ * @return uint32_t ǰtick(λ 1/TK_TIMER_TICK_PER_SECOND )
+ */
+uint32_t tk_timer_fd_get_tick(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * TK_TIMER_TICK_PER_SECOND +
+                      (uint64_t)ts.tv_nsec * TK_TIMER_TICK_PER_SECOND / 1000000000ULL);
+}
+
+/**
+ * @brief ȡʱӦtimerfdepollȶ·
+ * timerfdֻ糬ʱʱһΣfdɶʱtk_timer_fd_handler
+ * 
+ * @return int ļ-1Ϊȡʧ
+ */
+int tk_timer_get_fd(void)
+{
+    TK_ASSERT(tk_timer_head_node);
+    TK_ASSERT(tk_timer_get_tick);
+    if (tk_timer_head_node == NULL || tk_timer_get_tick == NULL)
+        return -1;
+    if (tk_timer_fd < 0)
+    {
+        tk_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (tk_timer_fd < 0)
+            return -1;
+        tk_timer_armed_valid = false;
+        _tk_timer_fd_rescan();
+    }
+    return tk_timer_fd;
+}
+
+/**
+ * @brief timerfdɶʱĶʱѭtk_timer_loop_handler
+ * 
+ * @return true 
+ * @return false 쳣
+ */
+bool tk_timer_fd_handler(void)
+{
+    uint64_t expirations;
+    if (tk_timer_fd < 0)
+        return false;
+    if (read(tk_timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations))
+        tk_timer_armed_valid = false;
+    return tk_timer_loop_handler();
+}
+
+/**
+ * @brief ȴֱĶʱʱȴʱepollʱʹ
+ * еĶʱʱtimerfdʱtimeout_msΪfalse
+ * 
+ * @param timeout_ms ȴʱ(λ ms)Ϊȴʱʱ
+ * @return true 
+ * @return false 쳣еĶʱtimeout_msΪ
+ */
+bool tk_timer_fd_wait(int32_t timeout_ms)
+{
+    struct pollfd pfd;
+    if (tk_timer_get_fd() < 0)
+        return false;
+    if (tk_timer_next_valid == false && timeout_ms < 0)
+        return false;
+    pfd.fd = tk_timer_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeout_ms < 0 ? -1 : timeout_ms) < 0)
+        return false;
+    return tk_timer_fd_handler();
+}
+
+/**
+ * @brief رնʱӦtimerfd
+ * 
+ * @return true رճɹ
+ * @return false رʧ
+ */
+bool tk_timer_release_fd(void)
+{
+    if (tk_timer_fd >= 0)
+        close(tk_timer_fd);
+    tk_timer_fd = -1;
+    tk_timer_armed_valid = false;
     return true;
 }
+#endif /* TK_TIMER_USING_FD */
 
 #endif /* TOOLKIT_USING_TIMER */
@@ -0,0 +1,283 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+#include "toolkit.h"
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_SIM)
+
+/*
+ * ʱ滻ʱtickȡÿֱ糬ʱʱִ̲һ鴦
+ * ʱֻ볬ʱйأtick޹ءͬһʱ̳ʱĶʱ˳id˳
+ * ͬܵõͬĳʱУժҪֵȽηǷһ¡
+ * ״̬Ϊȫֱֻӵжʱ߳ʹá
+ */
+
+#define TK_TIMER_SIM_FNV_OFFSET 0xCBF29CE484222325ULL
+#define TK_TIMER_SIM_FNV_PRIME  0x00000100000001B3ULL
+
+static bool tk_timer_sim_active = false;
+static uint32_t tk_timer_sim_tick = 0;
+static uint32_t (*tk_timer_sim_saved_tick)(void) = NULL;
+static struct tk_timer_sim_result tk_timer_sim_result;
+static struct tk_timer_sim_record *tk_timer_sim_trace = NULL;
+static uint32_t tk_timer_sim_trace_size = 0;
+#ifdef TK_TIMER_USING_TABLE
+static struct tk_timer_table *tk_timer_sim_tables[TK_TIMER_SIM_MAX_TABLES];
+static uint32_t tk_timer_sim_table_num = 0;
+#endif /* TK_TIMER_USING_TABLE */
+
+/**
+ * @brief һֵժҪ(ڲ)
+ * 
+ * @param value Ҫֵ
+ */
+static void _tk_timer_sim_digest(uint64_t value)
+{
+    tk_timer_sim_result.digest ^= value;
+    tk_timer_sim_result.digest *= TK_TIMER_SIM_FNV_PRIME;
+}
+
+/**
+ * @brief ȡʱӵĵǰticktk_timer_sim_beginɶʱģ
+ * 
+ * @return uint32_t ǰtick
+ */
+uint32_t tk_timer_sim_get_tick(void)
+{
+    return tk_timer_sim_tick;
+}
+
+/**
+ * @brief ʼ棬Ѷʱtickȡ滻Ϊʱ
+ * Ӧʱ֮ǰãеĶʱʱʱ԰ԭʱ
+ * 
+ * @param start_tick ʱӵʼtickӽUINT32_MAXʱ֤tick
+ * @return true ʼɹ
+ * @return false ڷ
+ */
+bool tk_timer_sim_begin(uint32_t start_tick)
+{
+    uint32_t (*get_tick_func)(void) = tk_timer_sim_get_tick;
+    if (tk_timer_sim_active)
+        return false;
+    tk_timer_sim_tick = start_tick;
+    if (tk_timer_sim_swap_tick(&get_tick_func) == false)
+        return false;
+    tk_timer_sim_saved_tick = get_tick_func;
+    memset(&tk_timer_sim_result, 0, sizeof(tk_timer_sim_result));
+    tk_timer_sim_result.digest = TK_TIMER_SIM_FNV_OFFSET;
+#ifdef TK_TIMER_USING_TABLE
+    tk_timer_sim_table_num = 0;
+#endif /* TK_TIMER_USING_TABLE */
+    tk_timer_sim_active = true;
+    return true;
+}
+
+/**
+ * @brief 棬ָԭtickȡ
+ * 
+ * @return true ɹ
+ * @return false ڷ
+ */
+bool tk_timer_sim_end(void)
+{
+    if (tk_timer_sim_active == false)
+        return false;
+    tk_timer_sim_swap_tick(&tk_timer_sim_saved_tick);
+    tk_timer_sim_saved_tick = NULL;
+    tk_timer_sim_trace = NULL;
+    tk_timer_sim_trace_size = 0;
+    tk_timer_sim_active = false;
+    return true;
+}
+
+#ifdef TK_TIMER_USING_TABLE
+/**
+ * @brief ÷ͬʱһʱĴ˳˳һ
+ * 
+ * @param table ʱ
+ * @return true ӳɹ
+ * @return false ڷлѴTK_TIMER_SIM_MAX_TABLES
+ */
+bool tk_timer_sim_add_table(struct tk_timer_table *table)
+{
+    TK_ASSERT(table);
+    if (table == NULL || tk_timer_sim_active == false || tk_timer_sim_table_num >= TK_TIMER_SIM_MAX_TABLES)
+        return false;
+    tk_timer_sim_tables[tk_timer_sim_table_num++] = table;
+    return true;
+}
+#endif /* TK_TIMER_USING_TABLE */
+
+/**
+ * @brief óʱ¼θǱsize¼
+ * nγʱ(0ʼ)дrecords[n % size]ܴtk_timer_sim_result.expired
+ * 
+ * @param records ¼NULLΪ¼
+ * @param size ¼
+ */
+void tk_timer_sim_set_trace(struct tk_timer_sim_record *records, uint32_t size)
+{
+    tk_timer_sim_trace = size != 0 ? records : NULL;
+    tk_timer_sim_trace_size = records != NULL ? size : 0;
+}
+
+/**
+ * @brief ¼һγʱɶʱڻصǰ(ڲ)
+ * 
+ * @param timer ʱʱΪNULL
+ * @param table ʱʱΪNULL
+ * @param index еλûid
+ * @param deadline ʱʱ
+ */
+void tk_timer_sim_expire(struct tk_timer *timer, struct tk_timer_table *table, uint32_t index, uint32_t deadline)
+{
+    uint32_t source = 0;
+    if (tk_timer_sim_active == false)
+        return;
+#ifdef TK_TIMER_USING_TABLE
+    for (uint32_t i = 0; table != NULL && i < tk_timer_sim_table_num; i++)
+    {
+        if (tk_timer_sim_tables[i] == table)
+        {
+            source = i + 1;
+            break;
+        }
+    }
+#endif /* TK_TIMER_USING_TABLE */
+    if (tk_timer_sim_trace != NULL)
+    {
+        struct tk_timer_sim_record *record = &tk_timer_sim_trace[tk_timer_sim_result.expired % tk_timer_sim_trace_size];
+        record->time = tk_timer_sim_result.time;
+        record->tick = tk_timer_sim_tick;
+        record->deadline = deadline;
+        record->index = index;
+        record->source = source;
+        record->timer = table != NULL ? (void *)table : (void *)timer;
+    }
+    if (deadline != tk_timer_sim_tick)
+        tk_timer_sim_result.late++;
+    tk_timer_sim_result.expired++;
+    _tk_timer_sim_digest(tk_timer_sim_result.time);
+    _tk_timer_sim_digest(((uint64_t)deadline << 32) | index);
+    _tk_timer_sim_digest(source);
+}
+
+/**
+ * @brief ڵǰʱִһд(ڲ)
+ */
+static void _tk_timer_sim_pass(void)
+{
+    tk_timer_loop_handler();
+#ifdef TK_TIMER_USING_TABLE
+    for (uint32_t i = 0; i < tk_timer_sim_table_num; i++)
+        tk_timer_table_handler(tk_timer_sim_tables[i]);
+#endif /* TK_TIMER_USING_TABLE */
+    tk_timer_sim_result.passes++;
+}
+
+/**
+ * @brief ȡ糬ʱʱ̵tick(ڲ)
+ * 
+ * @param ahead 糬ʱʱ̵tickѳʱİ1
+ * @return true ȡɹ
+ * @return false ûеĶʱ
+ */
+static bool _tk_timer_sim_next(uint32_t *ahead)
+{
+    uint32_t tick;
+    uint32_t min = UINT32_MAX;
+    bool valid = false;
+    if (tk_timer_get_next_tick(&tick))
+    {
+        min = tick - tk_timer_sim_tick;
+        valid = true;
+    }
+#ifdef TK_TIMER_USING_TABLE
+    for (uint32_t i = 0; i < tk_timer_sim_table_num; i++)
+    {
+        if (tk_timer_table_get_next_tick(tk_timer_sim_tables[i], &tick))
+        {
+            uint32_t delta = tick - tk_timer_sim_tick;
+            min = delta < min ? delta : min;
+            valid = true;
+        }
+    }
+#endif /* TK_TIMER_USING_TABLE */
+    /* ӦѳʱĶʱǰ1tick */
+    if (min == 0 || min >= (UINT32_MAX / 2))
+        min = 1;
+    *ahead = min;
+    return valid;
+}
+
+/**
+ * @brief ƽʱӣÿʱʱִ̲д
+ * ʱʱ(ǰʱ, ǰʱ + ticks]ڵĶʱʱͣڵǰʱ + ticks
+ * 
+ * @param ticks ƽtickɳUINT32_MAX֤tick
+ * @return uint64_t ִдĴ
+ */
+uint64_t tk_timer_sim_run(uint64_t ticks)
+{
+    uint64_t passes;
+    uint64_t left = ticks;
+    uint32_t ahead;
+    if (tk_timer_sim_active == false)
+        return 0;
+    passes = tk_timer_sim_result.passes;
+    /* ȴʼǰѵڵĶʱ */
+    _tk_timer_sim_pass();
+    while (_tk_timer_sim_next(&ahead) && ahead <= left)
+    {
+        tk_timer_sim_tick += ahead;
+        tk_timer_sim_result.time += ahead;
+        left -= ahead;
+        _tk_timer_sim_pass();
+    }
+    tk_timer_sim_tick += (uint32_t)left;
+    tk_timer_sim_result.time += left;
+    return tk_timer_sim_result.passes - passes;
+}
+
+/**
+ * @brief ȡ
+ * 
+ * @param result 
+ * @return true ȡɹ
+ * @return false ȡʧ
+ */
+bool tk_timer_sim_get_result(struct tk_timer_sim_result *result)
+{
+    TK_ASSERT(result);
+    if (result == NULL)
+        return false;
+    *result = tk_timer_sim_result;
+    return true;
+}
+
+#endif /* TOOLKIT_USING_TIMER && TK_TIMER_USING_SIM */
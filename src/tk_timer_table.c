@@ -0,0 +1,795 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+* 2026-10-19     zhangran     add sse2/avx2 expiry scan with cpuid dispatch
+* 2026-10-19     zhangran     skip groups by their earliest deadline, add simulation hook
+*/
+
+#include "toolkit.h"
+#if defined(TOOLKIT_USING_TIMER) && defined(TK_TIMER_USING_TABLE)
+#if defined(TK_TIMER_USING_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TK_TIMER_SIMD_X86
+#endif
+
+/*
+ * ʱṹ(SoA)ţʱֻ˳ȡĳʱʱʹλͼ
+ * ÿ32ʱһ飬ʹΪ0ֱÿ鼰ÿTK_TIMER_TABLE_BLOCKʱһ
+ * һ糬ʱʱ̵ֵδʱ̵ֻһּ
+ * ʱʱȡСֵϲֹͣʱ£ɨ赽ʱ¼㣻顢տ鲻ͳơ
+ * ģʽصֻͣͳʱʱʡ
+ * ʱ±(id)ãɾidջá
+ */
+
+/* stateÿֽڵĺ */
+#define TK_TIMER_TABLE_STATE_MASK 0x03
+#define TK_TIMER_TABLE_MODE_LOOP  0x04
+#define TK_TIMER_TABLE_USED       0x80
+
+/* ÿ鶨ʱ32糬ʱʱٻΪһֵ */
+#define TK_TIMER_TABLE_BLOCK 1024
+
+/**
+ * @brief жidǷΪӵĶʱ(ڲ)
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return true Ч
+ * @return false Ч
+ */
+static bool _tk_timer_table_valid(struct tk_timer_table *table, uint32_t id)
+{
+    return id < table->used && (table->state[id] & TK_TIMER_TABLE_USED) != 0;
+}
+
+/**
+ * @brief öʱ״̬ģʽӱ־(ڲ)
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @param state ʱ״̬
+ */
+static void _tk_timer_table_set_state(struct tk_timer_table *table, uint32_t id, tk_timer_state state)
+{
+    table->state[id] = (uint8_t)((table->state[id] & ~TK_TIMER_TABLE_STATE_MASK) | state);
+}
+
+/**
+ * @brief 糬ʱʱ(ڲ)
+ * 
+ * @param table ʱ
+ * @param tick µĳʱʱ
+ */
+static void _tk_timer_table_next_update(struct tk_timer_table *table, uint32_t tick)
+{
+    if (table->next_valid == false || (uint32_t)(tick - table->next_tick) > (UINT32_MAX / 2))
+    {
+        table->next_tick = tick;
+        table->next_valid = true;
+    }
+}
+
+/**
+ * @brief tick*min*min(ڲ)
+ * 
+ * @param min 糬ʱʱ
+ * @param tick µĳʱʱ
+ */
+static void _tk_timer_table_min_merge(uint32_t *min, uint32_t tick)
+{
+    if ((uint32_t)(tick - *min) > (UINT32_MAX / 2))
+        *min = tick;
+}
+
+/**
+ * @brief ϲ糬ʱʱ̣տֱӸ(ڲ)
+ * 
+ * @param table ʱ
+ * @param block 
+ * @param tick µĳʱʱ
+ */
+static void _tk_timer_table_block_merge(struct tk_timer_table *table, uint32_t block, uint32_t tick)
+{
+    uint32_t *empty = &table->block_empty[block / 32];
+    if ((*empty & (1u << (block % 32))) != 0)
+    {
+        table->block_min[block] = tick;
+        *empty &= ~(1u << (block % 32));
+    }
+    else
+    {
+        _tk_timer_table_min_merge(&table->block_min[block], tick);
+    }
+}
+
+/**
+ * @brief ɨһ32ʱʵ(ڲ)
+ * ޷֧ѭбȽȫ32ʱʱ(Զ)ٰѽѹΪλͼ
+ * ȫʹδʱʱСֵֻδʱʹܶʱСֵ
+ * 
+ * @param deadline 鳬ʱʱ
+ * @param enable ʹλ
+ * @param now ǰtick
+ * @param min_ahead δʱʹܶʱо볬ʱtickûʱΪUINT32_MAX
+ * @return uint32_t ѳʱʹܶʱλͼ
+ */
+static uint32_t _tk_timer_table_scan32_scalar(const uint32_t *deadline, uint32_t enable, uint32_t now, uint32_t *min_ahead)
+{
+    uint8_t hit[32];
+    uint32_t expired = 0;
+    uint32_t pending;
+    uint32_t min = UINT32_MAX;
+    for (uint32_t i = 0; i < 32; i++)
+        hit[i] = (uint32_t)(now - deadline[i]) < (UINT32_MAX / 2);
+    for (uint32_t i = 0; i < 32; i++)
+        expired |= (uint32_t)hit[i] << i;
+    pending = enable & ~expired;
+    if (pending == UINT32_MAX)
+    {
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            uint32_t ahead = deadline[i] - now;
+            min = ahead < min ? ahead : min;
+        }
+    }
+    else
+    {
+        while (pending != 0)
+        {
+            uint32_t ahead = deadline[__builtin_ctz(pending)] - now;
+            pending &= pending - 1;
+            min = ahead < min ? ahead : min;
+        }
+    }
+    *min_ahead = min;
+    return expired & enable;
+}
+
+#ifdef TK_TIMER_SIMD_X86
+/**
+ * @brief ɨһ32ʱSSE2ʵ֣ÿαȽ4ʱʱ(ڲ)
+ * SSE2û޷űȽϣnow - deadline[0, INT32_MAX)ڼΪʱ
+ * Сֵͨ(ѳʱδʹ)Ϊȫ1޷Сֵͨ0x80000000зűȽʵ
+ * 
+ * @param deadline 鳬ʱʱ
+ * @param enable ʹλ
+ * @param now ǰtick
+ * @param min_ahead δʱʹܶʱо볬ʱtickûʱΪUINT32_MAX
+ * @return uint32_t ѳʱʹܶʱλͼ
+ */
+__attribute__((target("sse2")))
+static uint32_t _tk_timer_table_scan32_sse2(const uint32_t *deadline, uint32_t enable, uint32_t now, uint32_t *min_ahead)
+{
+    const __m128i vnow = _mm_set1_epi32((int32_t)now);
+    const __m128i vneg = _mm_set1_epi32(-1);
+    const __m128i vmax = _mm_set1_epi32(INT32_MAX);
+    const __m128i vbias = _mm_set1_epi32(INT32_MIN);
+    const __m128i vlane = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i vmin = _mm_set1_epi32(-1);
+    uint32_t expired = 0;
+    uint32_t min[4];
+    for (uint32_t i = 0; i < 32; i += 4)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i *)&deadline[i]);
+        __m128i late = _mm_sub_epi32(vnow, d);
+        __m128i hit = _mm_and_si128(_mm_cmpgt_epi32(late, vneg), _mm_cmpgt_epi32(vmax, late));
+        __m128i bits = _mm_and_si128(_mm_set1_epi32((int32_t)(enable >> i)), vlane);
+        __m128i off = _mm_or_si128(hit, _mm_cmpeq_epi32(bits, _mm_setzero_si128()));
+        __m128i ahead = _mm_or_si128(_mm_sub_epi32(d, vnow), off);
+        __m128i less = _mm_cmpgt_epi32(_mm_xor_si128(vmin, vbias), _mm_xor_si128(ahead, vbias));
+        vmin = _mm_or_si128(_mm_and_si128(less, ahead), _mm_andnot_si128(less, vmin));
+        expired |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(hit)) << i;
+    }
+    _mm_storeu_si128((__m128i *)min, vmin);
+    for (uint32_t i = 1; i < 4; i++)
+        min[0] = min[i] < min[0] ? min[i] : min[0];
+    *min_ahead = min[0];
+    return expired & enable;
+}
+
+/**
+ * @brief ɨһ32ʱAVX2ʵ֣ÿαȽ8ʱʱ(ڲ)
+ * 
+ * @param deadline 鳬ʱʱ
+ * @param enable ʹλ
+ * @param now ǰtick
+ * @param min_ahead δʱʹܶʱо볬ʱtickûʱΪUINT32_MAX
+ * @return uint32_t ѳʱʹܶʱλͼ
+ */
+__attribute__((target("avx2")))
+static uint32_t _tk_timer_table_scan32_avx2(const uint32_t *deadline, uint32_t enable, uint32_t now, uint32_t *min_ahead)
+{
+    const __m256i vnow = _mm256_set1_epi32((int32_t)now);
+    const __m256i vneg = _mm256_set1_epi32(-1);
+    const __m256i vmax = _mm256_set1_epi32(INT32_MAX);
+    const __m256i vlane = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i vmin = _mm256_set1_epi32(-1);
+    __m128i half;
+    uint32_t expired = 0;
+    for (uint32_t i = 0; i < 32; i += 8)
+    {
+        __m256i d = _mm256_loadu_si256((const __m256i *)&deadline[i]);
+        __m256i late = _mm256_sub_epi32(vnow, d);
+        __m256i hit = _mm256_and_si256(_mm256_cmpgt_epi32(late, vneg), _mm256_cmpgt_epi32(vmax, late));
+        __m256i bits = _mm256_and_si256(_mm256_set1_epi32((int32_t)(enable >> i)), vlane);
+        __m256i off = _mm256_or_si256(hit, _mm256_cmpeq_epi32(bits, _mm256_setzero_si256()));
+        vmin = _mm256_min_epu32(vmin, _mm256_or_si256(_mm256_sub_epi32(d, vnow), off));
+        expired |= (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(hit)) << i;
+    }
+    half = _mm_min_epu32(_mm256_castsi256_si128(vmin), _mm256_extracti128_si256(vmin, 1));
+    half = _mm_min_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    *min_ahead = (uint32_t)_mm_cvtsi128_si32(half);
+    return expired & enable;
+}
+#endif /* TK_TIMER_SIMD_X86 */
+
+typedef uint32_t (*tk_timer_table_scan_func)(const uint32_t *deadline, uint32_t enable, uint32_t now, uint32_t *min_ahead);
+static tk_timer_table_scan_func tk_timer_table_scan32 = NULL;
+static tk_timer_scan_isa tk_timer_table_scan_isa = TK_TIMER_SCAN_SCALAR;
+
+/**
+ * @brief жCPUǷָ֧ɨʵ(ڲ)
+ * 
+ * @param isa ɨʵ
+ * @return true ֧
+ * @return false ֻ֧δTK_TIMER_USING_SIMD
+ */
+static bool _tk_timer_table_isa_supported(tk_timer_scan_isa isa)
+{
+    switch (isa)
+    {
+    case TK_TIMER_SCAN_SCALAR:
+        return true;
+#ifdef TK_TIMER_SIMD_X86
+    case TK_TIMER_SCAN_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case TK_TIMER_SCAN_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif /* TK_TIMER_SIMD_X86 */
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief ״ʹʱcpuidѡɨʵ(ڲ)
+ */
+static void _tk_timer_table_scan_select(void)
+{
+    if (tk_timer_table_scan32 != NULL)
+        return;
+#ifdef TK_TIMER_SIMD_X86
+    __builtin_cpu_init();
+#endif /* TK_TIMER_SIMD_X86 */
+    if (tk_timer_table_set_scan(TK_TIMER_SCAN_AVX2) == false &&
+        tk_timer_table_set_scan(TK_TIMER_SCAN_SSE2) == false)
+        tk_timer_table_set_scan(TK_TIMER_SCAN_SCALAR);
+}
+
+/**
+ * @brief (ڲ)
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @param now ǰtick
+ * @return true ɹ
+ * @return false ʧ
+ */
+static bool _tk_timer_table_set_start_param(struct tk_timer_table *table, uint32_t id, uint32_t now)
+{
+    if (table->delay_tick[id] == 0)
+        return false;
+    table->deadline[id] = now + table->delay_tick[id];
+    /* Сֵ壬ֱӸ */
+    if (table->enable[id / 32] == 0)
+        table->group_min[id / 32] = table->deadline[id];
+    else
+        _tk_timer_table_min_merge(&table->group_min[id / 32], table->deadline[id]);
+    _tk_timer_table_block_merge(table, id / TK_TIMER_TABLE_BLOCK, table->deadline[id]);
+    table->enable[id / 32] |= 1u << (id % 32);
+    _tk_timer_table_set_state(table, id, TIMER_STATE_RUNNING);
+    _tk_timer_table_next_update(table, table->deadline[id]);
+    return true;
+}
+
+/**
+ * @brief һѳʱĶʱ(ڲ)
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @param now δʼʱtickѭʱڻصǰԴ
+ */
+static void _tk_timer_table_fire(struct tk_timer_table *table, uint32_t id, uint32_t now)
+{
+    bool loop = (table->state[id] & TK_TIMER_TABLE_MODE_LOOP) != 0;
+    (void)now;
+#ifdef TK_TIMER_USING_SIM
+    tk_timer_sim_expire(NULL, table, id, table->deadline[id]);
+#endif /* TK_TIMER_USING_SIM */
+    table->enable[id / 32] &= ~(1u << (id % 32));
+    _tk_timer_table_set_state(table, id, TIMER_STATE_TIMEOUT);
+#ifndef TK_TIMER_USING_INTERVAL
+    if (loop)
+        _tk_timer_table_set_start_param(table, id, now);
+#endif /* TK_TIMER_USING_INTERVAL */
+    if (table->callback[id] != NULL)
+        table->callback[id](table, id, table->user_data[id]);
+#ifdef TK_TIMER_USING_INTERVAL
+    /* صпɾ˸öʱ */
+    if (loop && _tk_timer_table_valid(table, id) &&
+        (table->state[id] & TK_TIMER_TABLE_STATE_MASK) == TIMER_STATE_TIMEOUT)
+        _tk_timer_table_set_start_param(table, id, tk_timer_get_curr_tick());
+#endif /* TK_TIMER_USING_INTERVAL */
+}
+
+/**
+ * @brief ָ鲢նʱ(ڲ)
+ * 
+ * @param table ʱ
+ * @param pool 
+ * @param capacity ʱ32ı
+ */
+static void _tk_timer_table_setup(struct tk_timer_table *table, void *pool, uint32_t capacity)
+{
+    uint8_t *p = (uint8_t *)pool;
+    table->deadline = (uint32_t *)p;
+    p += (size_t)capacity * sizeof(uint32_t);
+    table->user_data = (void **)p;
+    p += (size_t)capacity * sizeof(void *);
+    table->callback = (tk_timer_table_callback *)p;
+    p += (size_t)capacity * sizeof(tk_timer_table_callback);
+    table->delay_tick = (uint32_t *)p;
+    p += (size_t)capacity * sizeof(uint32_t);
+    table->free_ids = (uint32_t *)p;
+    p += (size_t)capacity * sizeof(uint32_t);
+    table->state = p;
+    p += capacity;
+    table->enable = (uint32_t *)p;
+    p += (size_t)capacity / 32 * sizeof(uint32_t);
+    table->group_min = (uint32_t *)p;
+    p += (size_t)capacity / 32 * sizeof(uint32_t);
+    table->block_min = (uint32_t *)p;
+    p += (size_t)capacity / 32 * sizeof(uint32_t);
+    table->block_empty = (uint32_t *)p;
+    table->capacity = capacity;
+    table->used = 0;
+    table->free_num = 0;
+    table->next_valid = false;
+    table->next_tick = 0;
+    memset(table->deadline, 0, (size_t)capacity * sizeof(uint32_t));
+    memset(table->enable, 0, (size_t)capacity / 32 * sizeof(uint32_t));
+    memset(table->group_min, 0, (size_t)capacity / 32 * sizeof(uint32_t));
+    memset(table->block_min, 0, (size_t)(capacity + TK_TIMER_TABLE_BLOCK - 1) / TK_TIMER_TABLE_BLOCK * sizeof(uint32_t));
+    memset(table->block_empty, 0xFF, (size_t)capacity / 32 * sizeof(uint32_t));
+}
+
+/**
+ * @brief ̬ʼʱ
+ * СTK_TIMER_TABLE_POOL_SIZE㣬谴ָС
+ * 
+ * @param table ʱ
+ * @param pool 
+ * @param pool_size С(λֽ)
+ * @return true ʼɹ
+ * @return false ʼʧ
+ */
+bool tk_timer_table_init(struct tk_timer_table *table, void *pool, uint32_t pool_size)
+{
+    TK_ASSERT(table);
+    TK_ASSERT(pool);
+    uint32_t capacity;
+    if (table == NULL || pool == NULL)
+        return false;
+    capacity = (uint32_t)(pool_size / TK_TIMER_TABLE_GROUP_SIZE) * 32;
+    if (capacity == 0)
+        return false;
+    _tk_timer_table_setup(table, pool, capacity);
+    return true;
+}
+
+/**
+ * @brief ̬붨ʱ
+ * 
+ * @param table ҪĶʱ
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_table_detach(struct tk_timer_table *table)
+{
+    TK_ASSERT(table);
+    if (table == NULL)
+        return false;
+    table->deadline = NULL;
+    table->enable = NULL;
+    table->group_min = NULL;
+    table->block_min = NULL;
+    table->block_empty = NULL;
+    table->capacity = 0;
+    table->used = 0;
+    table->free_num = 0;
+    table->next_valid = false;
+    return true;
+}
+
+#ifdef TK_TIMER_USING_CREATE
+/**
+ * @brief ̬ʱ
+ * 
+ * @param max_timers ඨʱȡ32ı
+ * @return struct tk_timer_table* ĶʱNULLΪʧ
+ */
+struct tk_timer_table *tk_timer_table_create(uint32_t max_timers)
+{
+    TK_ASSERT(max_timers);
+    struct tk_timer_table *table;
+    void *pool;
+    if (max_timers == 0 || max_timers > UINT32_MAX - 31)
+        return NULL;
+    if ((table = malloc(sizeof(struct tk_timer_table))) == NULL)
+        return NULL;
+    if ((pool = malloc((size_t)((max_timers + 31) / 32) * TK_TIMER_TABLE_GROUP_SIZE)) == NULL)
+    {
+        free(table);
+        return NULL;
+    }
+    _tk_timer_table_setup(table, pool, (max_timers + 31) / 32 * 32);
+    return table;
+}
+
+/**
+ * @brief ̬ɾʱ
+ * 
+ * @param table ҪɾĶʱ
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_timer_table_delete(struct tk_timer_table *table)
+{
+    TK_ASSERT(table);
+    if (table == NULL)
+        return false;
+    free(table->deadline);
+    free(table);
+    return true;
+}
+#endif /* TK_TIMER_USING_CREATE */
+
+/**
+ * @brief ʱһʱӺΪֹͣ״̬
+ * 
+ * @param table ʱ
+ * @param callback ʱصʹÿΪNULL
+ * @param user_data صʱû
+ * @return uint32_t ʱidTK_TIMER_TABLE_INVALIDΪ
+ */
+uint32_t tk_timer_table_add(struct tk_timer_table *table, tk_timer_table_callback callback, void *user_data)
+{
+    TK_ASSERT(table);
+    uint32_t id;
+    if (table == NULL || table->deadline == NULL)
+        return TK_TIMER_TABLE_INVALID;
+    if (table->free_num > 0)
+        id = table->free_ids[--table->free_num];
+    else if (table->used < table->capacity)
+        id = table->used++;
+    else
+        return TK_TIMER_TABLE_INVALID;
+    table->callback[id] = callback;
+    table->user_data[id] = user_data;
+    table->delay_tick[id] = 0;
+    table->state[id] = TK_TIMER_TABLE_USED | TK_TIMER_TABLE_MODE_LOOP | TIMER_STATE_STOP;
+    return id;
+}
+
+/**
+ * @brief Ӷʱɾһʱڳʱصе
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return true ɾɹ
+ * @return false ɾʧ
+ */
+bool tk_timer_table_remove(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    if (table == NULL || _tk_timer_table_valid(table, id) == false)
+        return false;
+    table->enable[id / 32] &= ~(1u << (id % 32));
+    table->state[id] = 0;
+    table->free_ids[table->free_num++] = id;
+    return true;
+}
+
+/**
+ * @brief ʱ
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @param mode ģʽ: TIMER_MODE_SINGLE; ѭTIMER_MODE_LOOP
+ * @param delay_tick ʱʱ(λtick)
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_table_start(struct tk_timer_table *table, uint32_t id, tk_timer_mode mode, uint32_t delay_tick)
+{
+    TK_ASSERT(table);
+    TK_ASSERT(delay_tick);
+    if (table == NULL || _tk_timer_table_valid(table, id) == false)
+        return false;
+    if (mode == TIMER_MODE_LOOP)
+        table->state[id] |= TK_TIMER_TABLE_MODE_LOOP;
+    else
+        table->state[id] &= (uint8_t)~TK_TIMER_TABLE_MODE_LOOP;
+    table->delay_tick[id] = delay_tick;
+    return _tk_timer_table_set_start_param(table, id, tk_timer_get_curr_tick());
+}
+
+/**
+ * @brief ʱֹͣ
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return true ֹͣɹ
+ * @return false ֹͣʧ
+ */
+bool tk_timer_table_stop(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    if (table == NULL || _tk_timer_table_valid(table, id) == false)
+        return false;
+    table->enable[id / 32] &= ~(1u << (id % 32));
+    _tk_timer_table_set_state(table, id, TIMER_STATE_STOP);
+    return true;
+}
+
+/**
+ * @brief ʱʱʱ̲
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_table_continue(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    if (table == NULL || _tk_timer_table_valid(table, id) == false)
+        return false;
+    table->enable[id / 32] |= 1u << (id % 32);
+    _tk_timer_table_set_state(table, id, TIMER_STATE_RUNNING);
+    _tk_timer_table_next_update(table, table->deadline[id]);
+    return true;
+}
+
+/**
+ * @brief ʱ
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return true ɹ
+ * @return false ʧ
+ */
+bool tk_timer_table_restart(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    if (table == NULL || _tk_timer_table_valid(table, id) == false)
+        return false;
+    return _tk_timer_table_set_start_param(table, id, tk_timer_get_curr_tick());
+}
+
+/**
+ * @brief ȡʱģʽ
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return tk_timer_mode ʱģʽTIMER_MODE_SINGLE; ѭTIMER_MODE_LOOP
+ */
+tk_timer_mode tk_timer_table_get_mode(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    TK_ASSERT(id < table->used);
+    return (table->state[id] & TK_TIMER_TABLE_MODE_LOOP) ? TIMER_MODE_LOOP : TIMER_MODE_SINGLE;
+}
+
+/**
+ * @brief ȡʱ״̬
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return tk_timer_state ʱ״̬ 
+ * TIMER_STATE_RUNNINGTIMER_STATE_STOPTIMER_STATE_TIMEOUT
+ */
+tk_timer_state tk_timer_table_get_state(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    TK_ASSERT(id < table->used);
+    return (tk_timer_state)(table->state[id] & TK_TIMER_TABLE_STATE_MASK);
+}
+
+/**
+ * @brief ȡʱû
+ * 
+ * @param table ʱ
+ * @param id ʱid
+ * @return void* ʱûݣidЧʱΪNULL
+ */
+void *tk_timer_table_get_user_data(struct tk_timer_table *table, uint32_t id)
+{
+    TK_ASSERT(table);
+    if (table == NULL || _tk_timer_table_valid(table, id) == false)
+        return NULL;
+    return table->user_data[id];
+}
+
+/**
+ * @brief һ32ʱδ糬ʱʱ̵ֱ(ڲ)
+ * 
+ * @param table ʱ
+ * @param base һʱid
+ * @param now δʼʱtick
+ */
+static void _tk_timer_table_group_handler(struct tk_timer_table *table, uint32_t base, uint32_t now)
+{
+    uint32_t *enable = &table->enable[base / 32];
+    uint32_t *group_min = &table->group_min[base / 32];
+    uint32_t min_ahead;
+    uint32_t expired;
+    if (*enable == 0)
+        return;
+    if ((uint32_t)(now - *group_min) >= (UINT32_MAX / 2))
+    {
+        _tk_timer_table_block_merge(table, base / TK_TIMER_TABLE_BLOCK, *group_min);
+        _tk_timer_table_next_update(table, *group_min);
+        return;
+    }
+    expired = tk_timer_table_scan32(&table->deadline[base], *enable, now, &min_ahead);
+    /* дرСֵصĶʱ֮Ƚ */
+    if (min_ahead != UINT32_MAX)
+    {
+        *group_min = now + min_ahead;
+        _tk_timer_table_block_merge(table, base / TK_TIMER_TABLE_BLOCK, *group_min);
+        _tk_timer_table_next_update(table, *group_min);
+    }
+    while (expired != 0)
+    {
+        uint32_t bit = (uint32_t)__builtin_ctz(expired);
+        uint32_t id = base + bit;
+        expired &= expired - 1;
+        /* ǰĻصֹͣɾöʱ */
+        if ((*enable & (1u << bit)) == 0 ||
+            (uint32_t)(now - table->deadline[id]) >= (UINT32_MAX / 2))
+            continue;
+        _tk_timer_table_fire(table, id, now);
+    }
+}
+
+/**
+ * @brief ʱid˳ѳʱʱĻص
+ * δʼʱȡһtickصпͣӻɾʱ
+ * 
+ * @param table ʱ
+ * @return true 
+ * @return false 쳣
+ */
+bool tk_timer_table_handler(struct tk_timer_table *table)
+{
+    TK_ASSERT(table);
+    uint32_t now;
+    uint32_t skip_ahead;
+    if (table == NULL || table->deadline == NULL)
+        return false;
+    if (tk_timer_table_scan32 == NULL)
+        _tk_timer_table_scan_select();
+    now = tk_timer_get_curr_tick();
+    table->next_valid = false;
+    skip_ahead = UINT32_MAX;
+    /* صӵĶʱʹusedӣÿ顢ÿ¶ȡ */
+    for (uint32_t block = 0; block * TK_TIMER_TABLE_BLOCK < table->used; block++)
+    {
+        uint32_t *empty = &table->block_empty[block / 32];
+        uint32_t ahead = table->block_min[block] - now;
+        uint32_t end = (block + 1) * TK_TIMER_TABLE_BLOCK;
+        if ((*empty & (1u << (block % 32))) != 0)
+            continue;
+        if ((uint32_t)(now - table->block_min[block]) >= (UINT32_MAX / 2))
+        {
+            skip_ahead = ahead < skip_ahead ? ahead : skip_ahead;
+            continue;
+        }
+        /* ȱΪտϲصĶʱͬϲ */
+        *empty |= 1u << (block % 32);
+        for (uint32_t base = block * TK_TIMER_TABLE_BLOCK; base < end && base < table->used; base += 32)
+            _tk_timer_table_group_handler(table, base, now);
+    }
+    if (skip_ahead != UINT32_MAX)
+        _tk_timer_table_next_update(table, now + skip_ahead);
+    return true;
+}
+
+/**
+ * @brief ȡʱ糬ʱʱ
+ * ֹͣĶʱͳƳ˻ȡֵֻڻʵ糬ʱʱ
+ * 
+ * @param table ʱ
+ * @param tick 糬ʱʱ
+ * @return true ȡɹ
+ * @return false еĶʱ
+ */
+bool tk_timer_table_get_next_tick(struct tk_timer_table *table, uint32_t *tick)
+{
+    TK_ASSERT(table);
+    TK_ASSERT(tick);
+    if (table == NULL || tick == NULL || table->next_valid == false)
+        return false;
+    *tick = table->next_tick;
+    return true;
+}
+
+/**
+ * @brief жʱʹõĳʱɨʵ֣Ĭ״δʱcpuidѡʵ
+ * 
+ * @param isa ɨʵ֣TK_TIMER_SCAN_SCALARTK_TIMER_SCAN_SSE2TK_TIMER_SCAN_AVX2
+ * @return true óɹ
+ * @return false CPUֻ֧δTK_TIMER_USING_SIMD
+ */
+bool tk_timer_table_set_scan(tk_timer_scan_isa isa)
+{
+#ifdef TK_TIMER_SIMD_X86
+    __builtin_cpu_init();
+#endif /* TK_TIMER_SIMD_X86 */
+    if (_tk_timer_table_isa_supported(isa) == false)
+        return false;
+    switch (isa)
+    {
+#ifdef TK_TIMER_SIMD_X86
+    case TK_TIMER_SCAN_SSE2:
+        tk_timer_table_scan32 = _tk_timer_table_scan32_sse2;
+        break;
+    case TK_TIMER_SCAN_AVX2:
+        tk_timer_table_scan32 = _tk_timer_table_scan32_avx2;
+        break;
+#endif /* TK_TIMER_SIMD_X86 */
+    default:
+        tk_timer_table_scan32 = _tk_timer_table_scan32_scalar;
+        break;
+    }
+    tk_timer_table_scan_isa = isa;
+    return true;
+}
+
+/**
+ * @brief ȡǰʹõĳʱɨʵ
+ * 
+ * @return tk_timer_scan_isa ɨʵ
+ */
+tk_timer_scan_isa tk_timer_table_get_scan(void)
+{
+    _tk_timer_table_scan_select();
+    return tk_timer_table_scan_isa;
+}
+
+#endif /* TOOLKIT_USING_TIMER && TK_TIMER_USING_TABLE */
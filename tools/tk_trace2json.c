@@ -0,0 +1,145 @@
+/*
+* MIT License
+* 
+* Copyright (c) 2020 Cproape (911830982@qq.com)
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* 
+* Change Logs:
+* Date           Author       Notes
+* 2026-10-19     zhangran     the first version
+*/
+
+/**
+ * ˵
+ *      tk_timer_trace_dumpĶ׷ļתΪChrome trace JSONchrome://tracingPerfettoд
+ *      ÿγʱһص(Ϊʱַ)һlatenessиʱticktickڵŶӳ
+ *      ÷tk_trace2json ļ [ļ]ָļʱ׼
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "toolkit.h"
+
+/**
+ * @brief ׷ʱչΪ64λڼ¼ʱСڰ(ڲ)
+ * 
+ * @param raw ׷ʱ
+ * @param ref_raw οʱ
+ * @param ref οʱչֵ
+ * @return int64_t չʱ
+ */
+static int64_t _trace_unwrap(uint32_t raw, uint32_t ref_raw, int64_t ref)
+{
+    return ref + (int32_t)(raw - ref_raw);
+}
+
+int main(int argc, char *argv[])
+{
+    struct tk_timer_trace_header header;
+    struct tk_timer_trace_record record;
+    FILE *in, *out = stdout;
+    uint32_t ref_raw = 0;
+    int64_t ref = 0;
+    uint32_t max_thread = 0;
+    bool first = true;
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "usage: %s trace.bin [trace.json]\n", argv[0]);
+        return 1;
+    }
+    in = fopen(argv[1], "rb");
+    if (in == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if (fread(&header, sizeof(header), 1, in) != 1 || header.magic != TK_TIMER_TRACE_MAGIC)
+    {
+        fprintf(stderr, "%s: not a toolkit timer trace\n", argv[1]);
+        fclose(in);
+        return 1;
+    }
+    if (header.version != TK_TIMER_TRACE_VERSION || header.record_size != sizeof(record) ||
+        header.units_per_second == 0 || header.tick_per_second == 0)
+    {
+        fprintf(stderr, "%s: unsupported trace version %u\n", argv[1], header.version);
+        fclose(in);
+        return 1;
+    }
+    if (argc == 3 && (out = fopen(argv[2], "w")) == NULL)
+    {
+        perror(argv[2]);
+        fclose(in);
+        return 1;
+    }
+
+    double us_per_unit = 1e6 / header.units_per_second;
+    double us_per_tick = 1e6 / header.tick_per_second;
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"expiries\":%u,\"records\":%u,"
+                 "\"units_per_second\":%u,\"tick_per_second\":%u},\n\"traceEvents\":[",
+            header.total, header.count, header.units_per_second, header.tick_per_second);
+    for (uint32_t i = 0; i < header.count; i++)
+    {
+        if (fread(&record, sizeof(record), 1, in) != 1)
+        {
+            fprintf(stderr, "%s: truncated after %u records\n", argv[1], i);
+            break;
+        }
+        if (first)
+        {
+            ref_raw = record.pass_begin;
+            ref = 0;
+        }
+        int64_t pass_begin = _trace_unwrap(record.pass_begin, ref_raw, ref);
+        int64_t dispatch = _trace_unwrap(record.dispatch, record.pass_begin, pass_begin);
+        ref_raw = record.dispatch;
+        ref = dispatch;
+        uint32_t late_tick = record.tick - record.deadline;
+        if (late_tick > (UINT32_MAX / 2))
+            late_tick = 0;
+        double pass_delay = (double)(dispatch - pass_begin) * us_per_unit;
+        double late = late_tick * us_per_tick + pass_delay;
+        if (record.thread > max_thread)
+            max_thread = record.thread;
+        fprintf(out, "%s\n{\"name\":\"timer 0x%llx\",\"cat\":\"timer\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                     "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"deadline\":%u,\"tick\":%u,\"late_tick\":%u,"
+                     "\"pass_delay_us\":%.3f}}",
+                first ? "" : ",", (unsigned long long)record.timer, record.thread,
+                (double)dispatch * us_per_unit, record.duration * us_per_unit,
+                record.deadline, record.tick, late_tick, pass_delay);
+        fprintf(out, ",\n{\"name\":\"lateness_us\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                     "\"args\":{\"thread %u\":%.3f}}",
+                record.thread, (double)dispatch * us_per_unit, record.thread, late);
+        first = false;
+    }
+    for (uint32_t t = 1; t <= max_thread; t++)
+    {
+        fprintf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"name\":\"timer thread %u\"}}",
+                first ? "" : ",", t, t);
+        first = false;
+    }
+    fprintf(out, "\n]}\n");
+    fclose(in);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}